@@ -0,0 +1,444 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "TDirectory.h"
+#include "TError.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH2Poly.h"
+#include "TH3.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile2Poly.h"
+#include "TProfile3D.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+
+/// How the fillers of a TH1ConcurrentFillManager update the histogram.
+enum class EH1ConcurrentFillMode {
+   kBuffered,  ///< Buffer the fills of each filler and flush them into the histogram under a lock.
+   kAtomic,    ///< Accumulate the bins with atomic operations, added to the histogram by Merge().
+   kPerThread  ///< Fill private copies of the histogram, added to it in a fixed order by Merge().
+};
+
+namespace Internal {
+namespace TH1ConcurrentFill {
+
+// Number of coordinates passed to Fill() for each histogram type.
+std::integral_constant<int, 1> GetNCoords(TH1 *);
+std::integral_constant<int, 2> GetNCoords(TH2 *);
+std::integral_constant<int, 3> GetNCoords(TH3 *);
+std::integral_constant<int, 2> GetNCoords(TProfile *);
+std::integral_constant<int, 3> GetNCoords(TProfile2D *);
+std::integral_constant<int, 4> GetNCoords(TProfile3D *);
+std::integral_constant<int, 3> GetNCoords(TProfile2Poly *);
+
+// Whether the bins can be updated atomically: profiles also accumulate the
+// bin entries and the sum of the values, which cannot be done consistently,
+// and the bins of a TH2Poly are not found from the axes.
+std::true_type IsAtomicCapable(TH1 *);
+std::false_type IsAtomicCapable(TH2Poly *);
+std::false_type IsAtomicCapable(TProfile *);
+std::false_type IsAtomicCapable(TProfile2D *);
+std::false_type IsAtomicCapable(TProfile3D *);
+
+// Fill n buffered entries, through the batched FillN where it exists.
+inline void FillN(TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w) { h.FillN(n, x[0], w); }
+inline void FillN(TH2 &h, Int_t n, const Double_t *const *x, const Double_t *w) { h.FillN(n, x[0], x[1], w); }
+inline void FillN(TH3 &h, Int_t n, const Double_t *const *x, const Double_t *w) { h.FillN(n, x[0], x[1], x[2], w); }
+inline void FillN(TProfile &h, Int_t n, const Double_t *const *x, const Double_t *w) { h.FillN(n, x[0], x[1], w); }
+inline void FillN(TProfile2D &h, Int_t n, const Double_t *const *x, const Double_t *w)
+{
+   for (Int_t i = 0; i < n; ++i)
+      h.Fill(x[0][i], x[1][i], x[2][i], w[i]);
+}
+inline void FillN(TProfile3D &h, Int_t n, const Double_t *const *x, const Double_t *w)
+{
+   for (Int_t i = 0; i < n; ++i)
+      h.Fill(x[0][i], x[1][i], x[2][i], x[3][i], w[i]);
+}
+inline void FillN(TProfile2Poly &h, Int_t n, const Double_t *const *x, const Double_t *w)
+{
+   for (Int_t i = 0; i < n; ++i)
+      h.Fill(x[0][i], x[1][i], x[2][i], w[i]);
+}
+
+inline void AtomicAdd(std::atomic<Double_t> &atomic, Double_t value)
+{
+   Double_t old = atomic.load(std::memory_order_relaxed);
+   while (!atomic.compare_exchange_weak(old, old + value, std::memory_order_relaxed)) {
+   }
+}
+
+} // namespace TH1ConcurrentFill
+} // namespace Internal
+
+template <class HIST, int SIZE>
+class TH1ConcurrentFillManager;
+
+/**
+ \class ROOT::TH1ConcurrentFiller
+ \ingroup Hist
+ Fill interface handed out by a TH1ConcurrentFillManager to one thread (or one
+ task) at a time. Depending on the mode of the manager it buffers the fills,
+ updates the bins of the manager atomically or fills a private copy of the
+ histogram. The pending fills are flushed by Flush() and by the destructor.
+ **/
+
+template <class HIST, int SIZE = 1024>
+class TH1ConcurrentFiller {
+public:
+   static constexpr int kNCoords =
+      decltype(Internal::TH1ConcurrentFill::GetNCoords(static_cast<HIST *>(nullptr)))::value;
+
+private:
+   using Manager_t = TH1ConcurrentFillManager<HIST, SIZE>;
+
+   Manager_t *fManager;                                ///< Manager of the histogram, nullptr if moved from.
+   EH1ConcurrentFillMode fMode;                        ///< Fill mode of the manager.
+   Int_t fSize = 0;                                    ///< Number of buffered fills.
+   std::unique_ptr<std::array<Double_t, SIZE>[]> fX;   ///< Buffered coordinates, one array per coordinate.
+   std::unique_ptr<std::array<Double_t, SIZE>> fW;     ///< Buffered weights.
+   HIST *fPartial = nullptr;                           ///< Private histogram (kPerThread mode).
+   Double_t fStats[TH1::kNstat] = {};                  ///< Statistics of the atomic fills not yet flushed.
+   Double_t fEntries = 0;                              ///< Number of atomic fills not yet flushed.
+
+   void FillAtomic(const Double_t *x, Double_t w);
+
+public:
+   explicit TH1ConcurrentFiller(Manager_t &manager);
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other);
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller();
+
+   /// Fill the histogram with the coordinates (one per dimension of the
+   /// histogram, plus the value for a profile) and an optional weight, as
+   /// HIST::Fill would.
+   template <typename... ARGS>
+   void Fill(ARGS... args)
+   {
+      static_assert(sizeof...(ARGS) == kNCoords || sizeof...(ARGS) == kNCoords + 1,
+                    "Fill() expects one argument per coordinate and an optional weight");
+      const Double_t values[] = {static_cast<Double_t>(args)..., 1.};
+      const Double_t w = values[kNCoords];
+      switch (fMode) {
+      case EH1ConcurrentFillMode::kBuffered:
+         for (int c = 0; c < kNCoords; ++c)
+            fX[c][fSize] = values[c];
+         (*fW)[fSize] = w;
+         if (++fSize == SIZE)
+            Flush();
+         break;
+      case EH1ConcurrentFillMode::kAtomic: FillAtomic(values, w); break;
+      case EH1ConcurrentFillMode::kPerThread: fPartial->Fill(static_cast<Double_t>(args)...); break;
+      }
+   }
+
+   void Flush();
+};
+
+/**
+ \class ROOT::TH1ConcurrentFillManager
+ \ingroup Hist
+ Synchronizes the filling of a TH1, TH2, TH3 or profile from several threads.
+
+ Each thread (or each task, e.g. of a TTreeProcessorMT) gets its own
+ TH1ConcurrentFiller from MakeFiller() and fills through it:
+ ~~~{.cpp}
+ TH1D h("h", "h", 100, 0., 1.);
+ ROOT::TH1ConcurrentFillManager<TH1D> manager(h);
+ processor.Process([&](TTreeReader &reader) {
+    auto filler = manager.MakeFiller();
+    TTreeReaderValue<double> x(reader, "x");
+    while (reader.Next())
+       filler.Fill(*x);
+ });
+ manager.Merge();
+ ~~~
+ The fill modes are
+  - EH1ConcurrentFillMode::kBuffered (default): each filler buffers SIZE fills
+    and hands them to HIST::FillN under a lock. The memory per thread is
+    bounded by the buffer.
+  - EH1ConcurrentFillMode::kAtomic: the bin contents and sums of squares of
+    weights are accumulated with atomic operations in arrays of
+    std::atomic<Double_t> held by the manager, the statistics are accumulated
+    by each filler and handed to the manager at flush time. Merge() adds them
+    to the histogram. This avoids the lock when the fills of the threads are
+    spread over many bins, at the cost of two arrays of doubles of the size of
+    the histogram. It needs axes that cannot be extended and it is not
+    available for profiles nor TH2Poly; otherwise the manager falls back to
+    kBuffered. The sums of squares of weights are always stored in this mode.
+  - EH1ConcurrentFillMode::kPerThread: each filler fills a private copy of the
+    histogram, taken from a pool of copies (at most one per concurrently
+    alive filler). Merge() adds the copies to the histogram in the order they
+    were created. This only makes the order of the merge deterministic: which
+    fills end up in which copy still depends on the thread scheduling, so
+    sums that are not exact in floating point may differ between runs.
+
+ The histogram must not be used otherwise while being filled: call Merge()
+ once all fillers are flushed or destroyed. In the kAtomic and kPerThread
+ modes the histogram only sees the fills after Merge().
+ **/
+
+template <class HIST, int SIZE = 1024>
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller<HIST, SIZE>;
+
+public:
+   using Hist_t = HIST;
+   using Filler_t = TH1ConcurrentFiller<HIST, SIZE>;
+
+private:
+   HIST &fHist;                                  ///< The histogram being filled.
+   EH1ConcurrentFillMode fMode;                  ///< How the fillers update the histogram.
+   std::mutex fMutex;                            ///< Protects the histogram and the members below.
+   Double_t fStats[TH1::kNstat] = {};            ///< Statistics of the flushed fills not yet merged, kAtomic mode.
+   Double_t fEntries = 0;                        ///< Number of flushed fills not yet merged, kAtomic mode.
+   std::vector<std::unique_ptr<HIST>> fPartials; ///< Private histograms, kPerThread mode.
+   std::vector<HIST *> fFreePartials;            ///< Private histograms not used by a filler.
+   std::unique_ptr<std::atomic<Double_t>[]> fContent; ///< Bin contents not yet merged, kAtomic mode.
+   std::unique_ptr<std::atomic<Double_t>[]> fSumw2;   ///< Sums of squares of weights not yet merged, kAtomic mode.
+
+   HIST *AcquirePartial()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (!fFreePartials.empty()) {
+         HIST *partial = fFreePartials.back();
+         fFreePartials.pop_back();
+         return partial;
+      }
+      TDirectory::TContext ctxt(nullptr); // do not register the copies
+      std::unique_ptr<HIST> partial(static_cast<HIST *>(fHist.Clone()));
+      partial->SetDirectory(nullptr);
+      partial->Reset();
+      fPartials.emplace_back(std::move(partial));
+      return fPartials.back().get();
+   }
+
+   void ReleasePartial(HIST *partial)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fFreePartials.push_back(partial);
+   }
+
+   void FillN(Int_t n, const Double_t *const *x, const Double_t *w)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      Internal::TH1ConcurrentFill::FillN(fHist, n, x, w);
+   }
+
+   void AddStats(const Double_t *stats, Double_t entries)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         fStats[i] += stats[i];
+      fEntries += entries;
+   }
+
+   bool CanFillAtomically()
+   {
+      if (!decltype(Internal::TH1ConcurrentFill::IsAtomicCapable(static_cast<HIST *>(nullptr)))::value)
+         return false;
+      return !(fHist.GetXaxis()->CanExtend() || fHist.GetYaxis()->CanExtend() || fHist.GetZaxis()->CanExtend());
+   }
+
+   // Add the atomic fills to the histogram and reset them; called with fMutex held.
+   void MergeAtomic()
+   {
+      if (fEntries == 0)
+         return;
+      Double_t stats[TH1::kNstat] = {};
+      fHist.GetStats(stats);
+      Double_t *sumw2 = fHist.GetSumw2()->GetArray();
+      for (Int_t bin = 0; bin < fHist.GetNcells(); ++bin) {
+         fHist.AddBinContent(bin, fContent[bin].exchange(0., std::memory_order_relaxed));
+         sumw2[bin] += fSumw2[bin].exchange(0., std::memory_order_relaxed);
+      }
+      for (int i = 0; i < TH1::kNstat; ++i)
+         stats[i] += fStats[i];
+      fHist.PutStats(stats);
+      fHist.SetEntries(fHist.GetEntries() + fEntries);
+      std::fill(fStats, fStats + TH1::kNstat, 0.);
+      fEntries = 0;
+   }
+
+public:
+   TH1ConcurrentFillManager(HIST &hist, EH1ConcurrentFillMode mode = EH1ConcurrentFillMode::kBuffered)
+      : fHist(hist), fMode(mode)
+   {
+      if (fMode == EH1ConcurrentFillMode::kAtomic) {
+         // Flush the internal buffer of the histogram, it would not see the atomic fills.
+         fHist.BufferEmpty(1);
+         if (CanFillAtomically()) {
+            if (!fHist.GetSumw2N())
+               fHist.Sumw2();
+            const Int_t ncells = fHist.GetNcells();
+            fContent.reset(new std::atomic<Double_t>[ncells]);
+            fSumw2.reset(new std::atomic<Double_t>[ncells]);
+            for (Int_t bin = 0; bin < ncells; ++bin) {
+               fContent[bin].store(0., std::memory_order_relaxed);
+               fSumw2[bin].store(0., std::memory_order_relaxed);
+            }
+         } else {
+            ::Warning("TH1ConcurrentFillManager", "Histogram %s cannot be filled atomically, buffering the fills instead",
+                      fHist.GetName());
+            fMode = EH1ConcurrentFillMode::kBuffered;
+         }
+      }
+   }
+
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+
+   /// Return a filler for the calling thread or task.
+   Filler_t MakeFiller() { return Filler_t(*this); }
+
+   /// Add the atomic fills of the kAtomic mode, or the private histograms of
+   /// the kPerThread mode in a fixed order, to the histogram and reset them.
+   /// No filler may be filling at the same time.
+   void Merge()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fMode == EH1ConcurrentFillMode::kAtomic) {
+         MergeAtomic();
+         return;
+      }
+      for (auto &partial : fPartials) {
+         if (partial->GetEntries() == 0)
+            continue;
+         fHist.Add(partial.get());
+         partial->Reset();
+      }
+   }
+
+   EH1ConcurrentFillMode GetMode() const { return fMode; }
+   HIST &GetHist() { return fHist; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a filler for the histogram of the manager.
+
+template <class HIST, int SIZE>
+TH1ConcurrentFiller<HIST, SIZE>::TH1ConcurrentFiller(Manager_t &manager) : fManager(&manager), fMode(manager.fMode)
+{
+   if (fMode == EH1ConcurrentFillMode::kBuffered) {
+      fX.reset(new std::array<Double_t, SIZE>[kNCoords]);
+      fW.reset(new std::array<Double_t, SIZE>);
+   } else if (fMode == EH1ConcurrentFillMode::kPerThread) {
+      fPartial = manager.AcquirePartial();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the pending fills of another filler.
+
+template <class HIST, int SIZE>
+TH1ConcurrentFiller<HIST, SIZE>::TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+   : fManager(other.fManager), fMode(other.fMode), fSize(other.fSize), fX(std::move(other.fX)),
+     fW(std::move(other.fW)), fPartial(other.fPartial), fEntries(other.fEntries)
+{
+   std::copy(other.fStats, other.fStats + TH1::kNstat, fStats);
+   other.fManager = nullptr;
+   other.fPartial = nullptr;
+   other.fSize = 0;
+   other.fEntries = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the pending fills.
+
+template <class HIST, int SIZE>
+TH1ConcurrentFiller<HIST, SIZE>::~TH1ConcurrentFiller()
+{
+   if (!fManager)
+      return;
+   Flush();
+   if (fPartial)
+      fManager->ReleasePartial(fPartial);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the buffered fills (kBuffered) to the histogram, or the statistics of
+/// the atomic fills (kAtomic) to the manager. Nothing to do for kPerThread: the
+/// private histogram is added to the histogram by TH1ConcurrentFillManager::Merge().
+
+template <class HIST, int SIZE>
+void TH1ConcurrentFiller<HIST, SIZE>::Flush()
+{
+   if (fMode == EH1ConcurrentFillMode::kBuffered && fSize > 0) {
+      const Double_t *x[kNCoords];
+      for (int c = 0; c < kNCoords; ++c)
+         x[c] = fX[c].data();
+      fManager->FillN(fSize, x, fW->data());
+      fSize = 0;
+   } else if (fMode == EH1ConcurrentFillMode::kAtomic && fEntries > 0) {
+      fManager->AddStats(fStats, fEntries);
+      std::fill(fStats, fStats + TH1::kNstat, 0.);
+      fEntries = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the bin content and the sum of squares of weights held by the manager
+/// atomically, and accumulate the statistics locally.
+
+template <class HIST, int SIZE>
+void TH1ConcurrentFiller<HIST, SIZE>::FillAtomic(const Double_t *x, Double_t w)
+{
+   using namespace Internal::TH1ConcurrentFill;
+   TH1 &hist = fManager->fHist;
+   const Int_t binx = hist.GetXaxis()->FindFixBin(x[0]);
+   const Int_t biny = kNCoords > 1 ? hist.GetYaxis()->FindFixBin(x[1]) : 0;
+   const Int_t binz = kNCoords > 2 ? hist.GetZaxis()->FindFixBin(x[2]) : 0;
+   const Int_t bin = hist.GetBin(binx, biny, binz);
+   AtomicAdd(fManager->fContent[bin], w);
+   AtomicAdd(fManager->fSumw2[bin], w * w);
+
+   fEntries += 1;
+   if (!hist.GetStatOverflowsBehaviour()) {
+      if (binx == 0 || binx > hist.GetXaxis()->GetNbins())
+         return;
+      if (kNCoords > 1 && (biny == 0 || biny > hist.GetYaxis()->GetNbins()))
+         return;
+      if (kNCoords > 2 && (binz == 0 || binz > hist.GetZaxis()->GetNbins()))
+         return;
+   }
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x[0];
+   fStats[3] += w * x[0] * x[0];
+   if (kNCoords > 1) {
+      fStats[4] += w * x[1];
+      fStats[5] += w * x[1] * x[1];
+      fStats[6] += w * x[0] * x[1];
+   }
+   if (kNCoords > 2) {
+      fStats[7] += w * x[2];
+      fStats[8] += w * x[2] * x[2];
+      fStats[9] += w * x[0] * x[2];
+      fStats[10] += w * x[1] * x[2];
+   }
+}
+
+} // namespace ROOT
+
+#endif
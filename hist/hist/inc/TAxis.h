@@ -25,6 +25,8 @@
 #include "TAttAxis.h"
 #include "TArrayD.h"
 
+#include <vector>
+
 class THashList;
 
 class TAxis : public TNamed, public TAttAxis {
@@ -42,6 +44,10 @@ private:
    TObject     *fParent;         //!Object owning this axis
    THashList   *fLabels;         //List of labels
    TList       *fModLabs;        //List of modified labels
+   std::vector<Int_t> fBinIndex; //!Lookup table of the variable bins: first candidate bin of each bucket
+   Double_t     fIndexOrigin = 0; //!Lower edge of the first bucket of the lookup table (of log(x) if fIndexLog)
+   Double_t     fIndexScale = 0; //!Number of buckets of the lookup table per unit of x (of log(x) if fIndexLog)
+   Bool_t       fIndexLog = kFALSE; //!The buckets of the lookup table are uniform in log(x)
 
    // TAxis extra status bits (stored in fBits2)
    enum {
@@ -51,6 +57,12 @@ private:
    };
 
    Bool_t       HasBinWithoutLabel() const;
+   void         BuildBinIndex();
+   Int_t        FindVariableBin(Double_t x) const;
+
+   // The sparse streaming of the histograms writes a copy of the histogram
+   // sharing the labels of its axes (see TH1::SparseStreamerWrite).
+   friend class TH1;
 
 public:
    // TAxis status bits
@@ -104,6 +116,7 @@ public:
    virtual Int_t      FindBin(const char *label);
    virtual Int_t      FindFixBin(Double_t x) const;
    virtual Int_t      FindFixBin(const char *label) const;
+   void               FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride=1) const;
    virtual Double_t   GetBinCenter(Int_t bin) const;
    virtual Double_t   GetBinCenterLog(Int_t bin) const;
    const char        *GetBinLabel(Int_t bin) const;
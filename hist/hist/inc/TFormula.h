@@ -102,6 +102,9 @@ private:
    std::string       fGradGenerationInput; //! input query to clad to generate a gradient
    CallFuncSignature fFuncPtr = nullptr; //!  function pointer, owned by the JIT.
    CallFuncSignature fGradFuncPtr = nullptr; //!  function pointer, owned by the JIT.
+   std::unique_ptr<TMethodCall> fBatchMethod; //! pointer to the methodcall of the batch evaluation
+   CallFuncSignature fBatchFuncPtr = nullptr; //!  function pointer of the batch evaluation, owned by the JIT.
+   Bool_t            fBatchFailed = kFALSE;   //!  the batch evaluation function could not be compiled
    void *   fLambdaPtr = nullptr;            //!  pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
@@ -127,6 +130,7 @@ private:
    bool HasGradientGenerationFailed() const {
       return !fGradMethod && !fGradGenerationInput.empty();
    }
+   Bool_t PrepareBatchFunction();
 
 protected:
 
@@ -192,6 +196,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *params = nullptr) const;
 
    /// Generate gradient computation routine with respect to the parameters.
    /// \returns true if a gradient was generated and GradientPar can be called.
@@ -233,7 +238,9 @@ public:
    Bool_t         IsValid() const { return fReadyToExecute && fClingInitialized; }
    Bool_t IsVectorized() const { return fVectorized; }
    Bool_t         IsLinear() const { return TestBit(kLinear); }
+   static Bool_t  LoadCompiledCache(const char *directory);
    void           Print(Option_t *option = "") const;
+   static Bool_t  SaveCompiledCache(const char *directory);
    void           SetName(const char* name);
    void           SetParameter(const char* name, Double_t value);
    void           SetParameter(Int_t param, Double_t value);
@@ -113,6 +113,7 @@ protected:
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  ///<!flag to use under/overflows in statistics
     static Bool_t fgDefaultSumw2;   ///<!flag to call TH1::Sumw2 automatically at histogram creation time
+    static Bool_t fgDefaultSparseStreaming; ///<!flag to use the sparse streaming for all histograms
 
 public:
    static Int_t FitOptionsMake(Option_t *option, Foption_t &Foption);
@@ -132,7 +133,11 @@ protected:
    TH1(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins);
    virtual Int_t    BufferFill(Double_t x, Double_t w);
    virtual Bool_t   FindNewAxisLimits(const TAxis* axis, const Double_t point, Double_t& newMin, Double_t &newMax);
+   virtual void     CopyHeader(TObject &hnew) const;
    virtual void     SavePrimitiveHelp(std::ostream &out, const char *hname, Option_t *option = "");
+           Bool_t   SparseStreamerCheck(TBuffer &b, const TArray &cells) const;
+           void     SparseStreamerWrite(TBuffer &b, TClass *cl, const TArray &cells) const;
+           void     SparseStreamerRead(TBuffer &b, TClass *cl, TArray &cells, UInt_t start, UInt_t count);
    static Bool_t    RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis);
    static Bool_t    SameLimitsAndNBins(const TAxis& axis1, const TAxis& axis2);
    Bool_t   IsEmpty() const;
@@ -145,7 +150,6 @@ protected:
                                Option_t * opt, Bool_t doerr = kFALSE) const;
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
-   Bool_t    GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; }
 
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLimits(const TAxis* a1, const TAxis* a2);
@@ -167,8 +171,13 @@ public:
       kIsNotW      = BIT(19),  ///< Histogram is forced to be not weighted even when the histogram is filled with weighted
                                /// different than 1.
       kAutoBinPTwo = BIT(20),  ///< Use Power(2)-based algorithm for autobinning
-      kIsHighlight = BIT(21)   ///< bit set if histo is highlight
+      kIsHighlight = BIT(21),  ///< bit set if histo is highlight
+      kSparseStreaming = BIT(22) ///< Stream only the non-empty cells (see TH1::SetSparseStreaming)
    };
+   // Class version written by the sparse streaming, which no StreamerInfo
+   // describes: the ROOT versions without the sparse streaming skip such a
+   // histogram with an error instead of reading it as empty.
+   enum { kSparseStreamerVersion = 0x3FF0 };
    // size of statistics data (size of  array used in GetStats()/ PutStats )
    // s[0]  = sumw       s[1]  = sumw2
    // s[2]  = sumwx      s[3]  = sumwx2
@@ -270,6 +279,7 @@ public:
    virtual Double_t GetBinWidth(Int_t bin) const;
    virtual Double_t GetBinWithContent(Double_t c, Int_t &binx, Int_t firstx=0, Int_t lastx=0,Double_t maxdiff=0) const;
    virtual void     GetCenter(Double_t *center) const;
+   static  Bool_t   GetDefaultSparseStreaming();
    static  Bool_t   GetDefaultSumw2();
    TDirectory      *GetDirectory() const {return fDirectory;}
    virtual Double_t GetEntries() const;
@@ -313,6 +323,7 @@ public:
 
    virtual Double_t GetSkewness(Int_t axis=1) const;
            EStatOverflows GetStatOverflows() const {return fStatOverflows; }; ///< Get the behaviour adopted by the object about the statoverflows. See EStatOverflows for more information.
+           Bool_t   GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; } ///< Whether the under/overflows are used in the statistics.
            TAxis*   GetXaxis()  { return &fXaxis; }
            TAxis*   GetYaxis()  { return &fYaxis; }
            TAxis*   GetZaxis()  { return &fZaxis; }
@@ -376,6 +387,7 @@ public:
    virtual void     SetContour(Int_t nlevels, const Double_t *levels=0);
    virtual void     SetContourLevel(Int_t level, Double_t value);
    static  void     SetDefaultBufferSize(Int_t buffersize=1000);
+   static  void     SetDefaultSparseStreaming(Bool_t sparse=kTRUE);
    static  void     SetDefaultSumw2(Bool_t sumw2=kTRUE);
    virtual void     SetDirectory(TDirectory *dir);
    virtual void     SetEntries(Double_t n) {fEntries = n;};
@@ -405,6 +417,7 @@ public:
    virtual void     SetTitleOffset(Float_t offset=1, Option_t *axis="X");
    virtual void     SetTitleSize(Float_t size=0.02, Option_t *axis="X");
            void     SetStatOverflows(EStatOverflows statOverflows) {fStatOverflows = statOverflows;}; ///< See GetStatOverflows for more information.
+           void     SetSparseStreaming(Bool_t sparse=kTRUE) { SetBit(kSparseStreaming, sparse); } ///< See TH1::SetDefaultSparseStreaming.
    virtual void     SetTitle(const char *title);  // *MENU*
    virtual void     SetXTitle(const char *title) {fXaxis.SetTitle(title);}
    virtual void     SetYTitle(const char *title) {fYaxis.SetTitle(title);}
@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -38,8 +37,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   ROOT::Internal::THnSparseBinIndex fBins; //! filled bins, by hash of their compact coordinate
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -60,6 +58,9 @@ class THnSparse: public THnBase {
    void FillExMap();
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Long64_t FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const;
+   Long64_t AllocateBin(ULong64_t hash, const Char_t* coordbuf);
+   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
 
    /// Increment the bin content of "bin" by "w",
    /// return the bin index.
@@ -90,6 +91,7 @@ class THnSparse: public THnBase {
    ROOT::Internal::THnBaseBinIter* CreateIter(Bool_t respectAxisRange) const;
 
    Long64_t GetNbins() const { return fFilledBins; }
+   void FillN(Int_t n, const Double_t* x, const Double_t* w = 0);
    void SetFilledBins(Long64_t nbins) { fFilledBins = nbins; }
 
    Long64_t GetBin(const Int_t* idx) const { return const_cast<THnSparse*>(this)->GetBin(idx, kFALSE); }
@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -65,5 +67,64 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDef(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+
+namespace ROOT {
+namespace Internal {
+
+/** \class THnSparseBinIndex
+Open-addressing hash table used by THnSparse to find the linear index of a
+filled bin from the hash of its compact bin coordinate. The slots are probed
+linearly and store the hash next to the linear index, such that most
+mismatches are rejected without looking at the bin's coordinates. Several bins
+can have the same hash; the caller decides which one matches.
+*/
+
+class THnSparseBinIndex {
+private:
+   struct Slot_t {
+      ULong64_t fHash;  // hash of the compact bin coordinate
+      Long64_t  fIndex; // linear bin index; -1 for an empty slot
+   };
+
+   std::vector<Slot_t> fSlots; // slots; their number is a power of two
+   Long64_t fSize;             // number of used slots
+   Int_t    fShift;            // 64 - log2(number of slots)
+
+   /// Return the first slot to probe for hash. Neighbouring bins have similar
+   /// hashes; the multiplication spreads them over the table.
+   size_t GetFirstSlot(ULong64_t hash) const { return (hash * 0x9E3779B97F4A7C15ULL) >> fShift; }
+   void Rehash(Long64_t nslots);
+
+public:
+   THnSparseBinIndex(): fSize(0), fShift(64) {}
+
+   void Add(ULong64_t hash, Long64_t index);
+   void Clear();
+   void Reserve(Long64_t nbins);
+
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size(); }
+   Long64_t GetMemorySize() const { return fSlots.size() * sizeof(Slot_t); }
+
+   /// Return the linear index of the bin with the given hash for which
+   /// matches(index) returns true, or -1 if there is none.
+   template <class MATCHES>
+   Long64_t Find(ULong64_t hash, MATCHES matches) const {
+      if (fSlots.empty())
+         return -1;
+      const size_t mask = fSlots.size() - 1;
+      for (size_t s = GetFirstSlot(hash); ; s = (s + 1) & mask) {
+         const Slot_t &slot = fSlots[s];
+         if (slot.fIndex < 0)
+            return -1;
+         if (slot.fHash == hash && matches(slot.fIndex))
+            return slot.fIndex;
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
 #endif // ROOT_THnSparse_Internal
 
@@ -25,7 +25,9 @@
 #include "TClass.h"
 #include "TMath.h"
 #include <time.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 ClassImp(TAxis);
 
@@ -217,6 +219,10 @@ void TAxis::Copy(TObject &obj) const
    axis.fLast   = fLast;
    axis.fBits2  = fBits2;
    fXbins.Copy(axis.fXbins);
+   axis.fBinIndex     = fBinIndex;
+   axis.fIndexOrigin  = fIndexOrigin;
+   axis.fIndexScale   = fIndexScale;
+   axis.fIndexLog     = fIndexLog;
    axis.fTimeFormat   = fTimeFormat;
    axis.fTimeDisplay  = fTimeDisplay;
    axis.fParent       = fParent;
@@ -270,6 +276,128 @@ void TAxis::ExecuteEvent(Int_t event, Int_t px, Int_t py)
    gPad->ExecuteEventAxis(event,px,py,this);
 }
 
+namespace {
+
+// Variable bin axes with fewer bins are searched without lookup table.
+const Int_t kBinIndexMinBins = 16;
+// Largest number of buckets of the lookup table.
+const Int_t kBinIndexMaxBuckets = 1 << 20;
+
+// Bucket of the lookup table containing u (x or log(x)).
+inline Int_t GetBinIndexBucket(Double_t u, Double_t origin, Double_t scale, Int_t nbuckets)
+{
+   const Int_t k = Int_t((u - origin) * scale);
+   return k < 0 ? 0 : (k < nbuckets ? k : nbuckets - 1);
+}
+
+// Fill index with the number of inner edges in the buckets before each bucket
+// and return the largest number of inner edges in a bucket.
+Int_t FillBinIndex(Int_t nbins, const Double_t *edges, Bool_t useLog, Double_t origin, Double_t scale,
+                   Int_t nbuckets, std::vector<Int_t> &index)
+{
+   index.assign(nbuckets + 1, 0);
+   for (Int_t i = 1; i < nbins; ++i) {
+      const Double_t u = useLog ? std::log(edges[i]) : edges[i];
+      ++index[GetBinIndexBucket(u, origin, scale, nbuckets) + 1];
+   }
+   Int_t largest = 0;
+   for (Int_t k = 0; k < nbuckets; ++k) {
+      largest = std::max(largest, index[k + 1]);
+      index[k + 1] += index[k];
+   }
+   return largest;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the lookup table used to find the bins of an axis with variable bins.
+///
+/// The range of the axis is divided into about twice as many buckets of equal
+/// width as there are bins, and the table stores, for each bucket, the first
+/// bin overlapping it. A lookup computes the bucket of the abscissa and only
+/// compares it to the edges of the few bins overlapping that bucket, instead of
+/// doing a binary search over all the edges.
+/// When the bins are much more evenly spread in log(x) than in x (e.g. for
+/// logarithmic binning), the buckets are taken of equal width in log(x).
+///
+/// The table is transient: it is rebuilt whenever the bins are set, copied or read.
+
+void TAxis::BuildBinIndex()
+{
+   fBinIndex.clear();
+   fIndexOrigin = 0;
+   fIndexScale = 0;
+   fIndexLog = kFALSE;
+   const Int_t nbins = fNbins;
+   if (nbins < kBinIndexMinBins || fXbins.fN != nbins + 1)
+      return;
+   const Double_t *edges = fXbins.fArray;
+   // The lookup relies on the edges being sorted (this also rejects NaN).
+   for (Int_t i = 1; i <= nbins; ++i) {
+      if (!(edges[i] >= edges[i - 1]))
+         return;
+   }
+   if (!(edges[0] < edges[nbins]))
+      return;
+
+   const Int_t nbuckets = std::min(2 * nbins, kBinIndexMaxBuckets);
+   Double_t origin = edges[0];
+   Double_t scale = nbuckets / (edges[nbins] - edges[0]);
+   if (!std::isfinite(scale))
+      return;
+   std::vector<Int_t> index;
+   const Int_t largest = FillBinIndex(nbins, edges, kFALSE, origin, scale, nbuckets, index);
+
+   // Computing the logarithm costs more than a few comparisons, use the
+   // logarithmic buckets only if they are much smaller than the linear ones.
+   if (largest > 4 && edges[0] > 0) {
+      const Double_t logOrigin = std::log(edges[0]);
+      const Double_t logScale = nbuckets / (std::log(edges[nbins]) - logOrigin);
+      if (std::isfinite(logScale) && logScale > 0) {
+         std::vector<Int_t> logIndex;
+         const Int_t logLargest = FillBinIndex(nbins, edges, kTRUE, logOrigin, logScale, nbuckets, logIndex);
+         if (4 * logLargest < largest) {
+            origin = logOrigin;
+            scale = logScale;
+            index.swap(logIndex);
+            fIndexLog = kTRUE;
+         }
+      }
+   }
+
+   fBinIndex.swap(index);
+   fIndexOrigin = origin;
+   fIndexScale = scale;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin of abscissa x, within the range of an axis with variable bins.
+///
+/// Uses the lookup table built by TAxis::BuildBinIndex, if any, and a binary
+/// search over all the bin edges otherwise.
+
+Int_t TAxis::FindVariableBin(Double_t x) const
+{
+   const Double_t *edges = fXbins.fArray;
+   // The range of the axis may have been changed with SetLimits.
+   if (fBinIndex.empty() || !(x >= edges[0] && x < edges[fXbins.fN - 1]))
+      return 1 + TMath::BinarySearch(fXbins.fN, edges, x);
+
+   const Int_t nbuckets = fBinIndex.size() - 1;
+   const Int_t k = GetBinIndexBucket(fIndexLog ? std::log(x) : x, fIndexOrigin, fIndexScale, nbuckets);
+   // The edges of the bucket are rounded as the abscissa is, so the bin lo is
+   // such that edges[lo] <= x and edges[hi + 1] > x.
+   const Int_t lo = fBinIndex[k];
+   const Int_t hi = fBinIndex[k + 1];
+   // As TMath::BinarySearch, an abscissa equal to several edges (bins of zero
+   // width) is in the bin starting at the first of them. Equal edges are in
+   // the same bucket, and edges[lo] is below that bucket unless lo is 0.
+   const Double_t *first = std::lower_bound(edges + lo, edges + hi + 1, x);
+   const Int_t i = first - edges;
+   return (*first == x) ? i + 1 : i;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Find bin number corresponding to abscissa x. NOTE: this method does not work with alphanumeric bins !!!
 ///
@@ -299,8 +427,7 @@ Int_t TAxis::FindBin(Double_t x)
       if (!fXbins.fN) {        //*-* fix bins
          bin = 1 + int (fNbins*(x-fXmin)/(fXmax-fXmin) );
       } else {                  //*-* variable bin sizes
-         //for (bin =1; x >= fXbins.fArray[bin]; bin++);
-         bin = 1 + TMath::BinarySearch(fXbins.fN,fXbins.fArray,x);
+         bin = FindVariableBin(x);
       }
    }
    return bin;
@@ -413,13 +540,69 @@ Int_t TAxis::FindFixBin(Double_t x) const
       if (!fXbins.fN) {        //*-* fix bins
          bin = 1 + int (fNbins*(x-fXmin)/(fXmax-fXmin) );
       } else {                  //*-* variable bin sizes
-//         for (bin =1; x >= fXbins.fArray[bin]; bin++);
-         bin = 1 + TMath::BinarySearch(fXbins.fN,fXbins.fArray,x);
+         bin = FindVariableBin(x);
       }
    }
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers corresponding to the n abscissas x[0], x[stride], ...
+/// x[(n-1)*stride] and store them in bins[0], ..., bins[n-1].
+///
+/// The result is identical to calling TAxis::FindFixBin for each abscissa, but
+/// the loops are written without data dependent branches: for fix bins the
+/// compiler can vectorize the bin computation, for variable bins each lookup
+/// uses the bin lookup table of the axis (see TAxis::BuildBinIndex) or, for
+/// axes with few bins, is a binary search of fixed length over the bin edges.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   if (!fXbins.fN) {        //*-* fix bins
+      const Double_t width = xmax - xmin;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const Bool_t below = xi < xmin;
+         const Bool_t inside = !below && xi < xmax; // false for NaN, as in FindFixBin
+         // Only convert in-range values, the others could overflow an Int_t.
+         const Double_t xc = inside ? xi : xmin;
+         const Int_t bin = 1 + int(nbins * (xc - xmin) / width);
+         bins[i] = inside ? bin : (below ? 0 : nbins + 1);
+      }
+   } else if (!fBinIndex.empty()) {
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const Bool_t below = xi < xmin;
+         const Bool_t inside = !below && xi < xmax;
+         bins[i] = inside ? FindVariableBin(xi) : (below ? 0 : nbins + 1);
+      }
+   } else {                  //*-* variable bin sizes
+      const Double_t *edges = fXbins.fArray;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const Bool_t below = xi < xmin;
+         const Bool_t inside = !below && xi < xmax;
+         const Double_t xc = inside ? xi : xmin;
+         // Find the last edge smaller than xc (or edges[0] if none is), edges[0] <= xc < edges[nbins].
+         const Double_t *base = edges;
+         Int_t len = nbins + 1;
+         while (len > 1) {
+            const Int_t half = len / 2;
+            base = (base[half] < xc) ? base + half : base;
+            len -= half;
+         }
+         // As TMath::BinarySearch in FindFixBin, an abscissa equal to several
+         // edges (bins of zero width) is in the bin starting at the first of them.
+         const Double_t *first = base + (*base < xc);
+         const Int_t bin = 1 + Int_t(first - edges) - (*first == xc ? 0 : 1);
+         bins[i] = inside ? bin : (below ? 0 : nbins + 1);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
@@ -721,6 +904,7 @@ void TAxis::Set(Int_t nbins, Double_t xlow, Double_t xup)
    fXmax    = xup;
    if (!fParent) SetDefaults();
    if (fXbins.fN > 0) fXbins.Set(0);
+   BuildBinIndex();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -739,6 +923,7 @@ void TAxis::Set(Int_t nbins, const Float_t *xbins)
    fXmin      = fXbins.fArray[0];
    fXmax      = fXbins.fArray[fNbins];
    if (!fParent) SetDefaults();
+   BuildBinIndex();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -757,6 +942,7 @@ void TAxis::Set(Int_t nbins, const Double_t *xbins)
    fXmin      = fXbins.fArray[0];
    fXmax      = fXbins.fArray[fNbins];
    if (!fParent) SetDefaults();
+   BuildBinIndex();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1065,6 +1251,7 @@ void TAxis::Streamer(TBuffer &R__b)
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
       if (R__v > 5) {
          R__b.ReadClassBuffer(TAxis::Class(), this, R__v, R__s, R__c);
+         BuildBinIndex();
          return;
       }
       //====process old versions before automatic schema evolution
@@ -1101,6 +1288,7 @@ void TAxis::Streamer(TBuffer &R__b)
          SetTimeFormat();
       }
       R__b.CheckByteCount(R__s, R__c, TAxis::IsA());
+      BuildBinIndex();
       //====end of old versions
 
    } else {
@@ -51,6 +51,8 @@
 
 #include "AnalyticalIntegrals.h"
 
+#include <algorithm>
+
 std::atomic<Bool_t> TF1::fgAbsValue(kFALSE);
 Bool_t TF1::fgRejectPoint = kFALSE;
 std::atomic<Bool_t> TF1::fgAddToGlobList(kTRUE);
@@ -1425,6 +1427,41 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at n points with the given parameters.
+///
+/// The points are given variable by variable: x[j*n + i] is the coordinate j
+/// of the point i (for a 1-D function, x is simply the array of the n values).
+/// The n results are written in result. If params is 0 the internal values of
+/// the parameters are used.
+///
+/// Functions defined by a formula are evaluated with TFormula::EvalBatch, i.e.
+/// with a single call to a compiled loop over the points; the other types are
+/// evaluated point by point with EvalPar.
+
+void TF1::EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+
+   if (fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalBatch(n, x, result, params);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            result[i] /= fNormIntegral;
+      }
+      return;
+   }
+
+   std::vector<Double_t> point(fNdim > 0 ? fNdim : 1);
+   if (fType == EFType::kInterpreted) InitArgs(point.data(), params);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         point[j] = x[j * n + i];
+      result[i] = EvalPar(point.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2350,9 +2387,30 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// Method is the same as in Derivative() function
 ///
 /// If a parameter is fixed, the gradient on this parameter = 0
+///
+/// For a function defined by a formula the gradient is not computed numerically
+/// but by the function generated by automatic differentiation of the formula
+/// (see TFormula::GenerateGradientPar), which costs about as much as one evaluation
+/// of the function instead of 4 per parameter. eps is then ignored.
+/// The numerical differentiation is used when the gradient cannot be generated
+/// (e.g. ROOT built without clad), for vectorized and for normalized functions.
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
+   if (fType == EFType::kFormula && !fNormalized && fFormula->IsValid() && !fFormula->IsVectorized() &&
+       fFormula->GenerateGradientPar()) {
+      // the generated gradient adds its result to the output array
+      std::fill(grad, grad + fNpar, 0.);
+      fFormula->GradientPar(x, grad);
+      // as for the numerical derivatives, the gradient is null along the fixed parameters
+      Double_t al, bl;
+      for (Int_t ipar = 0; ipar < fNpar; ++ipar) {
+         GetParLimits(ipar, al, bl);
+         if (al * bl != 0 && al >= bl)
+            grad[ipar] = 0;
+      }
+      return;
+   }
    GradientParTempl<Double_t>(x, grad, eps);
 }
 
@@ -2930,7 +2988,6 @@ void TF1::Paint(Option_t *choptin)
 TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
 {
    Int_t i;
-   Double_t xv[1];
 
    TH1 *histogram = 0;
 
@@ -2999,10 +3056,14 @@ TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv, parameters);
+   std::vector<Double_t> xvalues(fNpx);
+   std::vector<Double_t> yvalues(fNpx);
+   for (i = 1; i <= fNpx; i++) {
+      xvalues[i - 1] = histogram->GetBinCenter(i);
+   }
+   EvalBatch(fNpx, xvalues.data(), yvalues.data(), parameters);
    for (i = 1; i <= fNpx; i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i, EvalPar(xv, parameters));
+      histogram->SetBinContent(i, yvalues[i - 1]);
    }
 
    // Copy Function attributes to histogram attributes.
@@ -3077,12 +3138,11 @@ void TF1::Save(Double_t xmin, Double_t xmax, Double_t, Double_t, Double_t, Doubl
       xmin = fXmin + 0.5 * dx;
       xmax = fXmax - 0.5 * dx;
    }
-   Double_t xv[1];
-   InitArgs(xv, parameters);
+   std::vector<Double_t> xv(fNpx + 1);
    for (Int_t i = 0; i <= fNpx; i++) {
-      xv[0]    = xmin + dx * i;
-      fSave[i] = EvalPar(xv, parameters);
+      xv[i] = xmin + dx * i;
    }
+   EvalBatch(fNpx + 1, xv.data(), fSave.data(), parameters);
    fSave[fNpx + 1] = xmin;
    fSave[fNpx + 2] = xmax;
 }
@@ -168,6 +168,27 @@ Double_t TF12::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the projection at n points, see TF1::EvalBatch.
+
+void TF12::EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+   if (!fF2) {
+      for (Int_t i = 0; i < n; i++) result[i] = 0;
+      return;
+   }
+   std::vector<Double_t> xx(2 * n);
+   Double_t *xvar = (fCase == 0) ? xx.data() : xx.data() + n;
+   Double_t *xfix = (fCase == 0) ? xx.data() + n : xx.data();
+   for (Int_t i = 0; i < n; i++) {
+      xvar[i] = x[i];
+      xfix[i] = fXY;
+   }
+   fF2->EvalBatch(n, xx.data(), result, params);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
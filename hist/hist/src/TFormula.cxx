@@ -25,11 +25,17 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include "TSystem.h"
 #include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <unordered_map>
 #include <functional>
+#include <fstream>
+#include <set>
 
 using namespace std;
 
@@ -198,6 +204,30 @@ ClassImp(TFormula);
     function. That means the expression `x@2` will be expanded to
     ```[n]*x + [n+1]*2``` where n is the first previously unused parameter number.
 
+    ### Caching of the compiled expressions
+
+    The functions compiled by Cling for the expressions are kept in a cache for
+    the whole process, indexed by the normalised expression (after the
+    substitution of the variables, parameters and predefined functions, and
+    with the irrelevant white spaces and parentheses removed and the floating
+    point numbers written in their shortest form): formulas with equivalent
+    expressions, such as `2.50*(x)` and `2.5*x`, share the same compiled
+    function.
+
+    The compiled functions can also be saved on disk, to be reused in later
+    processes without going through Cling for each expression:
+
+    ```
+    TFormula::LoadCompiledCache("formulacache"); // at the start of the job
+    ...                                          // create the formulas
+    TFormula::SaveCompiledCache("formulacache"); // at the end of the job
+    ```
+
+    SaveCompiledCache compiles (with ACLiC) all the expressions of the cache
+    and of the current process in a library. They must therefore only use
+    functions from `cmath`, `TMath` or the MathCore special, probability and
+    density functions.
+
     \class TFormulaFunction
     Helper class for TFormula
 
@@ -215,6 +245,150 @@ static const TString gNamePrefix = "TFormula__";
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
 
+// definitions of the functions declared to Cling in this process, to be saved by TFormula::SaveCompiledCache
+static std::set<std::string> gClingDefinitions;
+
+// definitions of the functions available in the library loaded by TFormula::LoadCompiledCache
+static std::set<std::string> gCachedDefinitions;
+
+// base name of the files of the on-disk cache
+static const char *gCacheBaseName = "TFormulaCache";
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shortest spelling of the floating point literal which gives back
+/// the same value, always with a decimal point or an exponent (so that it
+/// stays a floating point literal): 2.50, 2.5 and 25e-1 all give 2.5.
+
+static std::string NormalizeFloatingLiteral(const std::string &literal)
+{
+   const double value = std::strtod(literal.c_str(), nullptr);
+   if (!std::isfinite(value))
+      return literal;
+   char buffer[32];
+   for (int precision = 1; precision <= 17; ++precision) {
+      snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+      if (std::strtod(buffer, nullptr) == value)
+         break;
+   }
+   std::string result = buffer;
+   if (result.find_first_of(".e") == std::string::npos)
+      result += '.';
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the text of expression from position begin to end is a
+/// number or an indexed variable (such as x[0] or p[1]), which do not need
+/// parentheses around them.
+
+static bool IsSimpleOperand(const std::string &expression, size_t begin, size_t end)
+{
+   if (begin == end)
+      return false;
+   if (isdigit(expression[begin]) || expression[begin] == '.') {
+      const std::string number = expression.substr(begin, end - begin);
+      char *last = nullptr;
+      std::strtod(number.c_str(), &last);
+      return last == number.c_str() + number.size();
+   }
+   size_t i = begin;
+   while (i < end && (isalnum(expression[i]) || expression[i] == '_'))
+      ++i;
+   if (i == begin || i + 2 >= end || expression[i] != '[' || expression[end - 1] != ']')
+      return false;
+   return expression.find_first_not_of("0123456789", i + 1) == end - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normalise an expression given to Cling, so that equivalent spellings of it
+/// share the same compiled function:
+///  - the white spaces which do not separate two names or numbers are
+///    removed, and the other ones are replaced by a single space;
+///  - the floating point literals are written in their shortest form
+///    (see NormalizeFloatingLiteral); integer literals, hexadecimal ones and
+///    the ones with a suffix are kept as they are, since they have another type;
+///  - the parentheses around a number or an indexed variable are removed,
+///    unless they are the ones of a function call or of a cast.
+
+static std::string NormalizeExpression(const char *expression)
+{
+   std::string spaced;
+   char previous = 0;
+   bool pendingSpace = false;
+   for (const char *c = expression; *c; ++c) {
+      if (isspace(*c)) {
+         pendingSpace = true;
+         continue;
+      }
+      if (pendingSpace && (isalnum(previous) || previous == '_') && (isalnum(*c) || *c == '_'))
+         spaced += ' ';
+      pendingSpace = false;
+      spaced += *c;
+      previous = *c;
+   }
+
+   // Floating point literals: the numbers which are not part of a name
+   std::string result;
+   const size_t n = spaced.size();
+   for (size_t i = 0; i < n;) {
+      const char c = spaced[i];
+      const char before = result.empty() ? 0 : result.back();
+      const bool startsNumber = (isdigit(c) || (c == '.' && i + 1 < n && isdigit(spaced[i + 1]))) &&
+                                !(isalnum(before) || before == '_' || before == '.');
+      if (!startsNumber) {
+         result += c;
+         ++i;
+         continue;
+      }
+      size_t end = i;
+      bool isFloating = false;
+      while (end < n && (isdigit(spaced[end]) || spaced[end] == '.')) {
+         isFloating |= (spaced[end] == '.');
+         ++end;
+      }
+      if (end < n && (spaced[end] == 'e' || spaced[end] == 'E')) {
+         size_t exponent = end + 1;
+         if (exponent < n && (spaced[exponent] == '+' || spaced[exponent] == '-'))
+            ++exponent;
+         if (exponent < n && isdigit(spaced[exponent])) {
+            while (exponent < n && isdigit(spaced[exponent]))
+               ++exponent;
+            end = exponent;
+            isFloating = true;
+         }
+      }
+      // a suffix (or the x of a hexadecimal number) changes the type
+      const bool hasSuffix = end < n && (isalnum(spaced[end]) || spaced[end] == '_');
+      const std::string literal = spaced.substr(i, end - i);
+      result += (isFloating && !hasSuffix) ? NormalizeFloatingLiteral(literal) : literal;
+      i = end;
+   }
+
+   // Parentheses around a simple operand, repeatedly for nested ones
+   bool changed = true;
+   while (changed) {
+      changed = false;
+      for (size_t open = result.find('('); open != std::string::npos; open = result.find('(', open + 1)) {
+         const size_t close = result.find_first_of("()", open + 1);
+         if (close == std::string::npos || result[close] != ')')
+            continue;
+         const char before = open > 0 ? result[open - 1] : 0;
+         const char after = close + 1 < result.size() ? result[close + 1] : 0;
+         // a function call, or a cast to a type
+         if (isalnum(before) || before == '_' || before == ']' || before == ')' || before == '>')
+            continue;
+         if (isalnum(after) || after == '_' || after == '(' || after == '[' || after == '.')
+            continue;
+         if (!IsSimpleOperand(result, open + 1, close))
+            continue;
+         result.erase(close, 1);
+         result.erase(open, 1);
+         changed = true;
+      }
+   }
+   return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
 {
@@ -702,6 +876,13 @@ void TFormula::Copy(TObject &obj) const
    fnew.fGradGenerationInput = fGradGenerationInput;
    fnew.fGradFuncPtr = fGradFuncPtr;
 
+   if (fBatchMethod)
+      fnew.fBatchMethod.reset(new TMethodCall(*fBatchMethod));
+   else
+      fnew.fBatchMethod.reset();
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
+   fnew.fBatchFailed = fBatchFailed;
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -719,6 +900,9 @@ void TFormula::Clear(Option_t * )
 
    if(fMethod) fMethod->Delete();
    fMethod = nullptr;
+   fBatchMethod.reset();
+   fBatchFuncPtr = nullptr;
+   fBatchFailed = kFALSE;
 
    fClingVariables.clear();
    fClingParameters.clear();
@@ -826,6 +1010,18 @@ void TFormula::InputFormulaIntoCling()
       ROOT::GetROOT();
       R__ASSERT(gCling); 
 
+      // The function may be compiled in the library of the on-disk cache
+      std::string definition(fClingInput.Data());
+      Bool_t isCached = kFALSE;
+      {
+         R__LOCKGUARD(gROOTMutex);
+         isCached = gCachedDefinitions.count(definition) > 0;
+      }
+      if (isCached) {
+         fClingInitialized = PrepareEvalMethod();
+         if (fClingInitialized) return;
+      }
+
       // Trigger autoloading / autoparsing (ROOT-9840):
       TString triggerAutoparsing = "namespace ROOT_TFormula_triggerAutoParse {\n"; triggerAutoparsing += fClingInput + "\n}";
       gCling->ProcessLine(triggerAutoparsing);
@@ -838,7 +1034,107 @@ void TFormula::InputFormulaIntoCling()
       gCling->Declare(fClingInput);
       fClingInitialized = PrepareEvalMethod();
       if (!fClingInitialized) Error("InputFormulaIntoCling","Error compiling formula expression in Cling");
+      else {
+         R__LOCKGUARD(gROOTMutex);
+         gClingDefinitions.insert(definition);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the library of the on-disk cache of compiled formulas from directory
+/// (see TFormula::SaveCompiledCache). The formulas created afterwards whose
+/// expression is in the cache use the compiled function of the library
+/// instead of compiling it with Cling.
+/// Returns false if there is no usable cache in the directory.
+
+Bool_t TFormula::LoadCompiledCache(const char *directory)
+{
+   TString index = TString::Format("%s/%s.txt", directory, gCacheBaseName);
+   TString library = TString::Format("%s/%s_C", directory, gCacheBaseName);
+   std::ifstream in(index.Data());
+   if (!in)
+      return kFALSE;
+
+   ROOT::GetROOT();
+   if (gSystem->Load(library) < 0) {
+      ::Error("TFormula::LoadCompiledCache", "Cannot load the library %s", library.Data());
+      return kFALSE;
+   }
+
+   // Declare the prototypes of the functions, compiled in the library
+   std::vector<std::string> definitions;
+   std::string prototypes = "#include \"Math/Types.h\"\n";
+   std::string definition;
+   while (std::getline(in, definition)) {
+      auto body = definition.find('{');
+      if (body == std::string::npos)
+         continue;
+      definitions.push_back(definition);
+      prototypes += definition.substr(0, body) + ";\n";
+   }
+   if (!gInterpreter->Declare(prototypes.c_str())) {
+      ::Error("TFormula::LoadCompiledCache", "Cannot declare the functions of the cache in %s", directory);
+      return kFALSE;
+   }
+
+   R__LOCKGUARD(gROOTMutex);
+   gCachedDefinitions.insert(definitions.begin(), definitions.end());
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Save in directory an on-disk cache of compiled formulas, which can be
+/// loaded in another process with TFormula::LoadCompiledCache.
+///
+/// The cache contains the functions of the cache previously loaded and all
+/// the functions compiled by Cling for formulas in this process.  They are
+/// written in a macro compiled with ACLiC (which must therefore be usable) in
+/// a library; an index of the function definitions is written next to it.
+/// Returns false if there is nothing to save or the compilation failed.
+
+Bool_t TFormula::SaveCompiledCache(const char *directory)
+{
+   std::set<std::string> definitions;
+   {
+      R__LOCKGUARD(gROOTMutex);
+      definitions = gCachedDefinitions;
+      definitions.insert(gClingDefinitions.begin(), gClingDefinitions.end());
+   }
+   if (definitions.empty())
+      return kFALSE;
+
+   gSystem->mkdir(directory, kTRUE);
+   TString source = TString::Format("%s/%s.C", directory, gCacheBaseName);
+   {
+      std::ofstream out(source.Data());
+      if (!out) {
+         ::Error("TFormula::SaveCompiledCache", "Cannot write the file %s", source.Data());
+         return kFALSE;
+      }
+      out << "// Functions of TFormula expressions, generated by TFormula::SaveCompiledCache\n"
+          << "#include <cmath>\n"
+          << "#include \"TMath.h\"\n"
+          << "#include \"Math/PdfFuncMathCore.h\"\n"
+          << "#include \"Math/ProbFuncMathCore.h\"\n"
+          << "#include \"Math/SpecFuncMathCore.h\"\n"
+          << "#include \"Math/Types.h\"\n"
+          << "using namespace std;\n\n";
+      for (auto &definition : definitions)
+         out << definition << "\n";
+   }
+
+   // Compile only: the functions are already declared in this process.
+   if (!gSystem->CompileMacro(source, "kOcs")) {
+      ::Error("TFormula::SaveCompiledCache", "Cannot compile the formula cache %s", source.Data());
+      return kFALSE;
    }
+
+   TString index = TString::Format("%s/%s.txt", directory, gCacheBaseName);
+   std::ofstream out(index.Data());
+   for (auto &definition : definitions)
+      out << definition << "\n";
+   return out.good();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2256,7 +2552,7 @@ void TFormula::ProcessFormula(TString &formula)
       if (inputIntoCling) {
          // save copy of inputFormula in a std::strig for the unordered map
          // and also formula is same as FClingInput typically and it will be modified
-         std::string inputFormula(formula.Data());
+         std::string inputFormula = NormalizeExpression(formula.Data());
 
          // The name we really use for the unordered map will have a flag that
          // says whether the formula is vectorized
@@ -2293,6 +2589,10 @@ void TFormula::ProcessFormula(TString &formula)
          // set the cling name using hash of the static formulae map
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu", gNamePrefix.Data(), hasher(inputFormulaVecFlag));
+         // the batch evaluation function needs to be regenerated for the new expression
+         fBatchMethod.reset();
+         fBatchFuncPtr = nullptr;
+         fBatchFailed = kFALSE;
 
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
@@ -3130,6 +3430,7 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
 }
 
 bool TFormula::fIsCladRuntimeIncluded = false;
+static bool gIsCladRuntimeAvailable = false;
 
 static bool functionExists(const string &Name) {
    return gInterpreter->GetFunction(/*cl*/0, Name.c_str());
@@ -3140,14 +3441,17 @@ bool TFormula::GenerateGradientPar()
 {
    // We already have generated the gradient.
    if (fGradMethod)
-      return true;
+      return fGradFuncPtr != nullptr;
 
    if (!HasGradientGenerationFailed()) {
       // FIXME: Move this elsewhere
       if (!TFormula::fIsCladRuntimeIncluded) {
          TFormula::fIsCladRuntimeIncluded = true;
-         gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
+         gIsCladRuntimeAvailable = gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
       }
+      // Without clad (ROOT built with -Dclad=OFF) do not retry for every formula.
+      if (!gIsCladRuntimeAvailable)
+         return false;
 
       // Check if the gradient request was made as part of another TFormula.
       // This can happen when we create multiple TFormula objects with the same
@@ -3173,7 +3477,7 @@ bool TFormula::GenerateGradientPar()
                                   GradFuncName.c_str(),
                                   fVectorized, /*IsGradient*/ true);
       fGradFuncPtr = prepareFuncPtr(fGradMethod.get());
-      return true;
+      return fGradFuncPtr != nullptr;
    }
    return false;
 }
@@ -3236,6 +3540,114 @@ void TFormula::GradientPar(const Double_t *x, Double_t *result)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compile (once) the function evaluating the formula over an array of points,
+/// `void <clingName>_batch<ndim>(Int_t n, Double_t *x, Double_t *p, Double_t *result)`.
+/// It is a loop calling the function of the formula, declared in the same way so
+/// that Cling inlines the formula and can vectorize the loop.
+/// Returns false if there is no such function (lambda expressions, vectorized
+/// formulas) or its compilation failed.
+
+Bool_t TFormula::PrepareBatchFunction()
+{
+   if (fBatchFuncPtr)
+      return kTRUE;
+   if (fBatchFailed || !fReadyToExecute || fVectorized || TestBit(TFormula::kLambda))
+      return kFALSE;
+
+   R__LOCKGUARD(gROOTMutex);
+   if (fBatchFuncPtr)
+      return kTRUE;
+   if (!fClingInitialized && fLazyInitialization)
+      ReInitializeEvalMethod();
+   if (!fClingInitialized || fClingName.IsNull() || fBatchFailed)
+      return kFALSE;
+
+   // The name of the batch function depends on the dimension since it
+   // determines the layout of the points.
+   TString batchName = TString::Format("%s_batch%d", fClingName.Data(), fNdim);
+   if (!functionExists(batchName.Data())) {
+      TString point;
+      TString args;
+      if (fNdim > 0) {
+         point = "      Double_t xi[] = {x[i]";
+         for (Int_t j = 1; j < fNdim; ++j)
+            point += TString::Format(", x[%d * n + i]", j);
+         point += "};\n";
+         args = (fNpar > 0) ? "xi, p" : "xi";
+      } else if (fNpar > 0) {
+         args = "x, p";
+      }
+      TString code = TString::Format("#pragma cling optimize(2)\n"
+                                     "void %s(Int_t n, Double_t *x, Double_t *p, Double_t *result) {\n"
+                                     "   for (Int_t i = 0; i < n; ++i) {\n"
+                                     "%s"
+                                     "      result[i] = %s(%s);\n"
+                                     "   }\n"
+                                     "}",
+                                     batchName.Data(), point.Data(), fClingName.Data(), args.Data());
+      if (!gInterpreter->Declare(code)) {
+         Error("PrepareBatchFunction", "Could not compile the batch evaluation of the formula %s", GetExpFormula().Data());
+         fBatchFailed = kTRUE;
+         return kFALSE;
+      }
+   }
+
+   std::unique_ptr<TMethodCall> method(new TMethodCall());
+   method->InitWithPrototype(batchName, "Int_t,Double_t*,Double_t*,Double_t*");
+   if (!method->IsValid()) {
+      Error("PrepareBatchFunction", "Can't find the batch evaluation function %s", batchName.Data());
+      fBatchFailed = kTRUE;
+      return kFALSE;
+   }
+   CallFuncSignature funcPtr = prepareFuncPtr(method.get());
+   if (!funcPtr) {
+      fBatchFailed = kTRUE;
+      return kFALSE;
+   }
+   fBatchMethod = std::move(method);
+   fBatchFuncPtr = funcPtr;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points.
+///
+/// The points are given variable by variable: x[j*n + i] is the value of the
+/// variable j for the point i (for a formula of one variable, x is simply the
+/// array of the n values). The n results are written in result. If params is
+/// null the parameters of the formula are used.
+///
+/// The first call compiles a loop over the points around the formula body (see
+/// PrepareBatchFunction), which is then evaluated with a single call instead of
+/// one indirect call per point. Lambda expressions and vectorized formulas are
+/// evaluated point by point with EvalPar.
+
+void TFormula::EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0)
+      return;
+
+   if (const_cast<TFormula *>(this)->PrepareBatchFunction()) {
+      double *vars = const_cast<double *>(x);
+      double *pars = (params) ? const_cast<double *>(params) : const_cast<double *>(fClingParameters.data());
+      void *args[4];
+      args[0] = &n;
+      args[1] = &vars;
+      args[2] = &pars;
+      args[3] = &result;
+      (*fBatchFuncPtr)(0, 4, args, /*ret*/ nullptr);
+      return;
+   }
+
+   std::vector<Double_t> point(fNdim > 0 ? fNdim : 1);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         point[j] = x[j * n + i];
+      result[i] = EvalPar(fNdim > 0 ? point.data() : x, params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 #ifdef R__HAS_VECCORE
 // ROOT::Double_v TFormula::Eval(ROOT::Double_v x, ROOT::Double_v y, ROOT::Double_v z, ROOT::Double_v t) const
@@ -15,6 +15,7 @@
 #include <ctype.h>
 #include <sstream>
 #include <cmath>
+#include <vector>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -42,6 +43,7 @@
 #include "TVirtualHistPainter.h"
 #include "TVirtualFFT.h"
 #include "TSystem.h"
+#include "TDirectory.h"
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -506,6 +508,10 @@ When using the options 2 or 3 above, the labels are automatically
 ~~~ {.cpp}
         file->Write();
 ~~~
+ Large 2-D and 3-D histograms which are mostly empty (for example in
+ monitoring applications) can be written with only their non-empty cells,
+ see TH1::SetSparseStreaming and TH1::SetDefaultSparseStreaming. They are
+ converted back to the dense form when read.
 
 #### Miscellaneous operations
 
@@ -526,6 +532,7 @@ TF1 *gF1=0;  //left for back compatibility (use TVirtualFitter::GetUserFunc inst
 Int_t  TH1::fgBufferSize   = 1000;
 Bool_t TH1::fgAddDirectory = kTRUE;
 Bool_t TH1::fgDefaultSumw2 = kFALSE;
+Bool_t TH1::fgDefaultSparseStreaming = kFALSE;
 Bool_t TH1::fgStatOverflows= kFALSE;
 
 extern void H1InitGaus();
@@ -2587,6 +2594,22 @@ TH1 *TH1::GetCumulative(Bool_t forward, const char* suffix) const
 /// independently of the current directory stored in the original histogram
 
 void TH1::Copy(TObject &obj) const
+{
+   CopyHeader(obj);
+
+   TArray* a = dynamic_cast<TArray*>(&obj);
+   if (a) a->Set(fNcells);
+   for (Int_t i = 0; i < fNcells; i++) ((TH1&)obj).UpdateBinContent(i, RetrieveBinContent(i));
+   fSumw2.Copy(((TH1&)obj).fSumw2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to obj, like Copy() but without the cell
+/// contents and the sum of squares of weights: the cell array of obj is left
+/// as it is. Classes adding data members (e.g. statistics) override this
+/// and call the base class CopyHeader().
+
+void TH1::CopyHeader(TObject &obj) const
 {
    if (((TH1&)obj).fDirectory) {
       // We are likely to change the hash value of this object
@@ -2617,16 +2640,8 @@ void TH1::Copy(TObject &obj) const
       ((TH1&)obj).fBuffer    = buf;
    }
 
-
-   TArray* a = dynamic_cast<TArray*>(&obj);
-   if (a) a->Set(fNcells);
-   for (Int_t i = 0; i < fNcells; i++) ((TH1&)obj).UpdateBinContent(i, RetrieveBinContent(i));
-
    ((TH1&)obj).fEntries   = fEntries;
 
-   // which will call BufferEmpty(0) and set fBuffer[0] to a  Maybe one should call
-   // assignment operator on the TArrayD
-
    ((TH1&)obj).fTsumw     = fTsumw;
    ((TH1&)obj).fTsumw2    = fTsumw2;
    ((TH1&)obj).fTsumwx    = fTsumwx;
@@ -2644,7 +2659,6 @@ void TH1::Copy(TObject &obj) const
    ((TH1&)obj).fYaxis.SetParent(&obj);
    ((TH1&)obj).fZaxis.SetParent(&obj);
    fContour.Copy(((TH1&)obj).fContour);
-   fSumw2.Copy(((TH1&)obj).fSumw2);
    //   fFunctions->Copy(((TH1&)obj).fFunctions);
    // when copying an histogram if the AddDirectoryStatus() is true it
    // will be added to gDirectory independently of the fDirectory stored.
@@ -3385,6 +3399,10 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method to fill histogram content from a vector
 /// called directly by TH1::BufferEmpty
+///
+/// When the axis cannot be extended, the bins are looked up in batches with
+/// TAxis::FindFixBins and the contents, the sum of squares of weights and the
+/// statistics are then accumulated in a single pass over each batch.
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3393,22 +3411,58 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   if (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) {
+      ntimes *= stride;
+      for (i=0;i<ntimes;i+=stride) {
+         bin =fXaxis.FindBin(x[i]);
+         if (bin <0) continue;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww;
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+      }
+      return;
+   }
+
+   // The sum of squares of weights is needed as soon as one weight is not 1.
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i=0;i<ntimes;i++) {
+         if (w[i*stride] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   Double_t *sumw2 = fSumw2.fN ? fSumw2.fArray : nullptr;
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+
+   const Int_t kBatchSize = 256;
+   Int_t bins[kBatchSize];
+   for (Int_t first=0;first<ntimes;first+=kBatchSize) {
+      const Int_t n = TMath::Min(kBatchSize, ntimes-first);
+      const Double_t *xb = x + first*stride;
+      const Double_t *wb = w ? w + first*stride : nullptr;
+      fXaxis.FindFixBins(n, xb, bins, stride);
+      for (i=0;i<n;i++) {
+         bin = bins[i];
+         if (wb) ww = wb[i*stride];
+         if (sumw2) sumw2[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+         const Double_t xi = xb[i*stride];
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
       }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
    }
 }
 
@@ -3843,6 +3897,10 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///          It uses the IMPROVE command of TMinuit (see TMinuit::mnimpr).
 ///          This algorithm attempts to improve the found local minimum by searching for a
 ///          better one.
+///        - "G"  Use the gradient of the function with respect to the parameters.
+///          For functions defined by a formula the gradient is generated analytically
+///          by automatic differentiation (see TFormula::GenerateGradientPar), otherwise
+///          it is computed numerically.
 ///        - "R"  Use the Range specified in the function range
 ///        - "N"  Do not store the graphics function, do not draw
 ///        - "0"  Do not plot the result of the fit. By default the fitted function
@@ -4268,6 +4326,15 @@ Int_t TH1::GetDefaultBufferSize()
    return fgBufferSize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if all histograms are written with the sparse streaming.
+/// see TH1::SetDefaultSparseStreaming.
+
+Bool_t TH1::GetDefaultSparseStreaming()
+{
+   return fgDefaultSparseStreaming;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return kTRUE if TH1::Sumw2 must be called when creating new histograms.
 /// see TH1::SetDefaultSumw2.
@@ -6292,6 +6359,26 @@ void TH1::SetDefaultBufferSize(Int_t buffersize)
    fgBufferSize = buffersize > 0 ? buffersize : 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// When this static function is called with `sparse=kTRUE`, all the
+/// histograms supporting it (TH2F, TH2D, TH3F, TH3D and the classes deriving
+/// from them) are written with the sparse streaming, as if
+/// TH1::SetSparseStreaming had been called for each of them.
+///
+/// With the sparse streaming, a histogram with at most a quarter of its cells
+/// (including under/overflows) non-empty is written with only the indices,
+/// contents and sums of squares of weights of these cells.  The indices are
+/// delta-encoded (distance to the previous non-empty cell), which makes them
+/// compress well.  The histogram gets back its dense arrays when read. ROOT
+/// versions without the sparse streaming cannot read such a histogram: they
+/// skip it with an error.  The option only applies to binary buffers (files,
+/// TMessage), not to the JSON or XML ones.
+
+void TH1::SetDefaultSparseStreaming(Bool_t sparse)
+{
+   fgDefaultSparseStreaming = sparse;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When this static function is called with `sumw2=kTRUE`, all new
 /// histograms will automatically activate the storage
@@ -6600,6 +6687,157 @@ void TH1::Streamer(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the histogram, whose dense cell contents are the array
+/// `cells` of the concrete histogram class, should be written to `b` with the
+/// sparse streaming (see TH1::SetDefaultSparseStreaming).
+
+Bool_t TH1::SparseStreamerCheck(TBuffer &b, const TArray &cells) const
+{
+   if (!TestBit(kSparseStreaming) && !fgDefaultSparseStreaming)
+      return kFALSE;
+   if (!b.InheritsFrom("TBufferFile"))
+      return kFALSE;
+   const Int_t ncells = cells.fN;
+   const Bool_t haveSumw2 = fSumw2.fN > 0;
+   if (ncells == 0 || (haveSumw2 && fSumw2.fN != ncells))
+      return kFALSE;
+
+   Int_t nonEmpty = 0;
+   for (Int_t bin = 0; bin < ncells; ++bin) {
+      if (cells.GetAt(bin) != 0 || (haveSumw2 && fSumw2.fArray[bin] != 0))
+         ++nonEmpty;
+   }
+   return nonEmpty <= ncells / 4;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the histogram with the sparse streaming, as an object of class `cl`
+/// (the concrete histogram class whose Streamer is calling), whose dense cell
+/// contents are the array `cells`.
+///
+/// The record has the class version kSparseStreamerVersion, and contains a
+/// copy of the histogram without its dense arrays, written as usual, followed
+/// by the number of cells, the delta-encoded indices of the non-empty cells,
+/// their contents and their sums of squares of weights. The histogram itself
+/// is not modified; the copy is made with CopyHeader(), so the dense arrays
+/// are never copied.
+///
+/// The copy shares the objects of the histogram written through pointers (the
+/// list of functions and the labels of the axes): the buffer remembers the
+/// addresses of the objects written to it, so these objects must outlive the
+/// buffer, or another object allocated at the same address would be written
+/// as a reference to them.
+
+void TH1::SparseStreamerWrite(TBuffer &b, TClass *cl, const TArray &cells) const
+{
+   const Int_t ncells = cells.fN;
+   const Bool_t haveSumw2 = fSumw2.fN > 0;
+   std::vector<Int_t> deltas;
+   std::vector<Double_t> contents;
+   std::vector<Double_t> sumw2;
+   Int_t previous = -1;
+   for (Int_t bin = 0; bin < ncells; ++bin) {
+      const Double_t content = cells.GetAt(bin);
+      if (content == 0 && !(haveSumw2 && fSumw2.fArray[bin] != 0))
+         continue;
+      deltas.push_back(bin - previous);
+      contents.push_back(content);
+      if (haveSumw2)
+         sumw2.push_back(fSumw2.fArray[bin]);
+      previous = bin;
+   }
+
+   TH1 *header = (TH1*)((char*)cl->New() + cl->GetBaseClassOffset(TH1::Class()));
+   {
+      TDirectory::TContext ctxt(nullptr); // do not register the copy
+      CopyHeader(*header);
+   }
+   // The default constructor may have allocated a few cells.
+   dynamic_cast<TArray&>(*header).Set(0);
+   header->fSumw2.Set(0);
+   TList *copyFunctions = header->fFunctions;
+   header->fFunctions = fFunctions;
+   TAxis *copyAxes[] = {&header->fXaxis, &header->fYaxis, &header->fZaxis};
+   const TAxis *axes[] = {&fXaxis, &fYaxis, &fZaxis};
+   THashList *copyLabels[3];
+   TList *copyModLabs[3];
+   for (Int_t i = 0; i < 3; ++i) {
+      copyLabels[i] = copyAxes[i]->fLabels;
+      copyModLabs[i] = copyAxes[i]->fModLabs;
+      copyAxes[i]->fLabels = axes[i]->fLabels;
+      copyAxes[i]->fModLabs = axes[i]->fModLabs;
+   }
+
+   const UInt_t cntpos = b.Length();
+   b << UInt_t(0); // space for the byte count
+   b << Version_t(kSparseStreamerVersion);
+   b.WriteClassBuffer(cl, (char*)header - cl->GetBaseClassOffset(TH1::Class()));
+   b << ncells;
+   b << haveSumw2;
+   const Int_t nonEmpty = deltas.size();
+   b << nonEmpty;
+   b.WriteFastArray(deltas.data(), nonEmpty);
+   b.WriteFastArray(contents.data(), nonEmpty);
+   if (haveSumw2)
+      b.WriteFastArray(sumw2.data(), nonEmpty);
+   b.SetByteCount(cntpos, kTRUE);
+
+   header->fFunctions = copyFunctions;
+   for (Int_t i = 0; i < 3; ++i) {
+      copyAxes[i]->fLabels = copyLabels[i];
+      copyAxes[i]->fModLabs = copyModLabs[i];
+   }
+   delete header;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a histogram written by SparseStreamerWrite as an object of class `cl`,
+/// once its version (kSparseStreamerVersion) and byte count (`start` and
+/// `count`) have been read, and rebuild its dense cell contents `cells` and
+/// fSumw2.
+
+void TH1::SparseStreamerRead(TBuffer &b, TClass *cl, TArray &cells, UInt_t start, UInt_t count)
+{
+   b.ReadClassBuffer(cl, (char*)this - cl->GetBaseClassOffset(TH1::Class()));
+   Int_t ncells = 0;
+   Bool_t haveSumw2 = kFALSE;
+   Int_t nonEmpty = 0;
+   b >> ncells;
+   b >> haveSumw2;
+   b >> nonEmpty;
+   if (ncells != fNcells || nonEmpty < 0 || nonEmpty > ncells) {
+      Error("SparseStreamerRead", "inconsistent sparse content for histogram %s", GetName());
+      b.CheckByteCount(start, count, cl);
+      return;
+   }
+   std::vector<Int_t> deltas(nonEmpty);
+   std::vector<Double_t> contents(nonEmpty);
+   std::vector<Double_t> sumw2(haveSumw2 ? nonEmpty : 0);
+   b.ReadFastArray(deltas.data(), nonEmpty);
+   b.ReadFastArray(contents.data(), nonEmpty);
+   if (haveSumw2)
+      b.ReadFastArray(sumw2.data(), nonEmpty);
+   b.CheckByteCount(start, count, cl);
+
+   cells.Set(0);
+   cells.Set(ncells);
+   fSumw2.Set(0);
+   if (haveSumw2)
+      fSumw2.Set(ncells);
+   Int_t bin = -1;
+   for (Int_t i = 0; i < nonEmpty; ++i) {
+      bin += deltas[i];
+      if (bin < 0 || bin >= ncells) {
+         Error("SparseStreamerRead", "invalid cell index %d for histogram %s", bin, GetName());
+         break;
+      }
+      cells.SetAt(contents[i], bin);
+      if (haveSumw2)
+         fSumw2.fArray[bin] = sumw2[i];
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print some global quantities for this histogram.
 /// \param[in] option
@@ -8,9 +8,18 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include "TMath.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -741,7 +750,143 @@ Bool_t TH1Merger::BufferMerge()
    return kFALSE; 
 }
 
-Bool_t TH1Merger::SameAxesMerge() { 
+namespace {
+
+/// Access to the bin contents of the histogram classes storing them in a plain
+/// array of T, whose AddBinContent is a simple addition (i.e. no saturation as
+/// in TH1C, TH1S or TH1I).
+template <typename T>
+struct TPlainStorage;
+
+template <>
+struct TPlainStorage<Double_t> {
+   static Bool_t Accept(const TH1 *h)
+   {
+      TClass *cl = h->IsA();
+      return cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class();
+   }
+   static Double_t *GetContent(TH1 *h) { return dynamic_cast<TArrayD *>(h)->GetArray(); }
+};
+
+template <>
+struct TPlainStorage<Float_t> {
+   static Bool_t Accept(const TH1 *h)
+   {
+      TClass *cl = h->IsA();
+      return cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class();
+   }
+   static Float_t *GetContent(TH1 *h) { return dynamic_cast<TArrayF *>(h)->GetArray(); }
+};
+
+/// Element-wise addition of two arrays, kept trivial so that it is vectorized.
+template <typename T, typename U>
+void AddArray(T *dest, const U *src, Int_t n)
+{
+   for (Int_t i = 0; i < n; ++i)
+      dest[i] += src[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the contents and squared errors of the histograms in [begin, end) to
+/// the arrays content and sumw2 (which is null if no errors are stored).
+
+template <typename T>
+void AddPlainRange(T *content, Double_t *sumw2, Int_t ncells, const std::vector<TH1 *> &hists, size_t begin,
+                   size_t end)
+{
+   for (size_t i = begin; i < end; ++i) {
+      TH1 *hist = hists[i];
+      const T *hcontent = TPlainStorage<T>::GetContent(hist);
+      AddArray(content, hcontent, ncells);
+      if (!sumw2)
+         continue;
+      if (hist->GetSumw2N())
+         AddArray(sumw2, hist->GetSumw2()->GetArray(), ncells);
+      else
+         AddArray(sumw2, hcontent, ncells); // as GetBinErrorSqUnchecked() of the general merge
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin contents and errors of hists to h0, with element-wise additions
+/// of their arrays, if all of them store their contents in a plain array of T.
+/// Return kFALSE (without touching h0) otherwise.
+///
+/// With implicit multi-threading, many inputs are split in ranges summed in
+/// parallel, one of them into h0 and the others into temporary arrays, and the
+/// partial sums are then added pairwise as a binary tree.  The order of the
+/// additions only depends on the number of inputs.
+
+template <typename T>
+Bool_t PlainSameAxesMerge(TH1 *h0, const std::vector<TH1 *> &hists)
+{
+   const Int_t ncells = h0->GetNcells();
+   if (!TPlainStorage<T>::Accept(h0))
+      return kFALSE;
+   for (auto hist : hists) {
+      if (!TPlainStorage<T>::Accept(hist) || hist->GetNcells() != ncells)
+         return kFALSE;
+   }
+
+   T *content = TPlainStorage<T>::GetContent(h0);
+   Double_t *sumw2 = h0->GetSumw2N() ? h0->GetSumw2()->GetArray() : nullptr;
+
+#ifdef R__USE_IMT
+   const size_t kMinInputsPerTask = 4;
+   const Long64_t kMinCells = 256 * 1024;
+   const size_t kMaxTasks = 16;
+   if (ROOT::IsImplicitMTEnabled() && hists.size() >= 2 * kMinInputsPerTask &&
+       (Long64_t)hists.size() * ncells >= kMinCells) {
+      const size_t ntasks = std::min(kMaxTasks, hists.size() / kMinInputsPerTask);
+      std::vector<std::vector<T>> partialContents(ntasks);
+      std::vector<std::vector<Double_t>> partialSumw2(ntasks);
+      std::vector<T *> contents(ntasks, content);
+      std::vector<Double_t *> sumw2s(ntasks, sumw2);
+
+      auto sumRange = [&](UInt_t task) {
+         if (task > 0) {
+            partialContents[task].resize(ncells);
+            contents[task] = partialContents[task].data();
+            if (sumw2) {
+               partialSumw2[task].resize(ncells);
+               sumw2s[task] = partialSumw2[task].data();
+            }
+         }
+         AddPlainRange(contents[task], sumw2s[task], ncells, hists, hists.size() * task / ntasks,
+                       hists.size() * (task + 1) / ntasks);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(sumRange, ROOT::TSeq<UInt_t>(ntasks));
+
+      // Pairwise reduction: at each level, task i receives task i + stride.
+      for (UInt_t stride = 1; stride < ntasks; stride *= 2) {
+         auto addPair = [&](UInt_t task) {
+            if (task + stride >= ntasks)
+               return;
+            AddArray(contents[task], contents[task + stride], ncells);
+            if (sumw2)
+               AddArray(sumw2s[task], sumw2s[task + stride], ncells);
+         };
+         pool.Foreach(addPair, ROOT::TSeq<UInt_t>(0, ntasks, 2 * stride));
+      }
+      return kTRUE;
+   }
+#endif
+
+   AddPlainRange(content, sumw2, ncells, hists, 0, hists.size());
+   return kTRUE;
+}
+
+} // namespace
+
+/**
+   Merge histograms having all the same axes, bin by bin.
+   The statistics are summed first; the bin contents and errors are then added
+   with element-wise array additions when all histograms are TH1D/TH2D/TH3D or
+   TH1F/TH2F/TH3F (in parallel for many inputs when implicit multi-threading is
+   enabled), or through AddBinContent otherwise.
+ */
+Bool_t TH1Merger::SameAxesMerge() {
 
 
    Double_t stats[TH1::kNstat], totstats[TH1::kNstat];
@@ -750,7 +895,10 @@ Bool_t TH1Merger::SameAxesMerge() {
    }
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
-   
+
+   std::vector<TH1 *> hists;
+   hists.reserve(fInputList.GetSize());
+
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -768,17 +916,22 @@ Bool_t TH1Merger::SameAxesMerge() {
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
+      hists.push_back(hist);
+   }
+
+   if (!PlainSameAxesMerge<Double_t>(fH0, hists) && !PlainSameAxesMerge<Float_t>(fH0, hists)) {
+      for (auto hist : hists) {
          // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
+         for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
 
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            fH0->AddBinContent(ibin,cu);
+            if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
 
+         }
       }
    }
    //copy merged stats
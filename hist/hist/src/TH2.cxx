@@ -279,6 +279,15 @@ Int_t TH2::BufferFill(Double_t x, Double_t y, Double_t w)
 void TH2::Copy(TObject &obj) const
 {
    TH1::Copy(obj);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to obj, without the cell contents (see
+/// TH1::CopyHeader).
+
+void TH2::CopyHeader(TObject &obj) const
+{
+   TH1::CopyHeader(obj);
    ((TH2&)obj).fScalefactor = fScalefactor;
    ((TH2&)obj).fTsumwy      = fTsumwy;
    ((TH2&)obj).fTsumwy2     = fTsumwy2;
@@ -552,34 +561,85 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
-   for (i=ifirst;i<ntimes;i+=stride) {
-      fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
-      if (binx <0 || biny <0) continue;
-      bin  = biny*(fXaxis.GetNbins()+2) + binx;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin,ww);
-      if (binx == 0 || binx > fXaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   if ((fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) || (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric())) {
+      for (i=ifirst;i<ntimes;i+=stride) {
+         fEntries++;
+         binx = fXaxis.FindBin(x[i]);
+         biny = fYaxis.FindBin(y[i]);
+         if (binx <0 || biny <0) continue;
+         bin  = biny*(fXaxis.GetNbins()+2) + binx;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww; //(ww > 0 ? ww : -ww);
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+         fTsumwy  += z*y[i];
+         fTsumwy2 += z*y[i]*y[i];
+         fTsumwxy += z*x[i]*y[i];
       }
-      if (biny == 0 || biny > fYaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+      return;
+   }
+
+   // The axes cannot be extended: look up the bins in batches (see TAxis::FindFixBins)
+   // and accumulate the contents and the statistics in one pass over each batch.
+   const Int_t n = (ntimes - ifirst + stride - 1) / stride;
+   x += ifirst;
+   y += ifirst;
+   if (w) w += ifirst;
+   fEntries += n;
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i=0;i<n;i++) {
+         if (w[i*stride] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   Double_t *sumw2 = fSumw2.fN ? fSumw2.fArray : nullptr;
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+
+   const Int_t kBatchSize = 256;
+   Int_t binsx[kBatchSize], binsy[kBatchSize];
+   for (Int_t first=0;first<n;first+=kBatchSize) {
+      const Int_t nb = TMath::Min(kBatchSize, n-first);
+      const Double_t *xb = x + first*stride;
+      const Double_t *yb = y + first*stride;
+      const Double_t *wb = w ? w + first*stride : nullptr;
+      fXaxis.FindFixBins(nb, xb, binsx, stride);
+      fYaxis.FindFixBins(nb, yb, binsy, stride);
+      for (i=0;i<nb;i++) {
+         binx = binsx[i];
+         biny = binsy[i];
+         bin  = biny*(nbinsx+2) + binx;
+         if (wb) ww = wb[i*stride];
+         if (sumw2) sumw2[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy)) continue;
+         const Double_t xi = xb[i*stride];
+         const Double_t yi = yb[i*stride];
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
+         fTsumwy  += ww*yi;
+         fTsumwy2 += ww*yi*yi;
+         fTsumwxy += ww*xi*yi;
       }
-      Double_t z= ww; //(ww > 0 ? ww : -ww);
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
-      fTsumwy  += z*y[i];
-      fTsumwy2 += z*y[i]*y[i];
-      fTsumwxy += z*x[i]*y[i];
    }
 }
 
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
@@ -3535,6 +3595,10 @@ void TH2F::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
       UInt_t R__s, R__c;
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v == kSparseStreamerVersion) {
+         SparseStreamerRead(R__b, TH2F::Class(), *this, R__s, R__c);
+         return;
+      }
       if (R__v > 2) {
          R__b.ReadClassBuffer(TH2F::Class(), this, R__v, R__s, R__c);
          return;
@@ -3557,7 +3621,10 @@ void TH2F::Streamer(TBuffer &R__b)
       //====end of old versions
 
    } else {
-      R__b.WriteClassBuffer(TH2F::Class(),this);
+      if (SparseStreamerCheck(R__b, *this))
+         SparseStreamerWrite(R__b, TH2F::Class(), *this);
+      else
+         R__b.WriteClassBuffer(TH2F::Class(),this);
    }
 }
 
@@ -3800,6 +3867,10 @@ void TH2D::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
       UInt_t R__s, R__c;
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v == kSparseStreamerVersion) {
+         SparseStreamerRead(R__b, TH2D::Class(), *this, R__s, R__c);
+         return;
+      }
       if (R__v > 2) {
          R__b.ReadClassBuffer(TH2D::Class(), this, R__v, R__s, R__c);
          return;
@@ -3822,7 +3893,10 @@ void TH2D::Streamer(TBuffer &R__b)
       //====end of old versions
 
    } else {
-      R__b.WriteClassBuffer(TH2D::Class(),this);
+      if (SparseStreamerCheck(R__b, *this))
+         SparseStreamerWrite(R__b, TH2D::Class(), *this);
+      else
+         R__b.WriteClassBuffer(TH2D::Class(),this);
    }
 }
 
@@ -162,6 +162,15 @@ TH3::~TH3()
 void TH3::Copy(TObject &obj) const
 {
    TH1::Copy(obj);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this histogram structure to obj, without the cell contents (see
+/// TH1::CopyHeader).
+
+void TH3::CopyHeader(TObject &obj) const
+{
+   TH1::CopyHeader(obj);
    ((TH3&)obj).fTsumwy      = fTsumwy;
    ((TH3&)obj).fTsumwy2     = fTsumwy2;
    ((TH3&)obj).fTsumwxy     = fTsumwxy;
@@ -382,6 +391,108 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+/// - ntimes:  number of entries in arrays x, y, z and w (if w is not null)
+/// - x:       array of x values to be histogrammed
+/// - y:       array of y values to be histogrammed
+/// - z:       array of z values to be histogrammed
+/// - w:       array of weights
+/// - stride:  step size through arrays x, y, z and w
+///
+/// When the axes cannot be extended, the bins are looked up in batches with
+/// TAxis::FindFixBins and the contents, the sum of squares of weights and the
+/// statistics are then accumulated in a single pass over each batch.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   if ((fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) || (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric()) ||
+       (fZaxis.CanExtend() && !fZaxis.IsAlphanumeric())) {
+      for (i=ifirst;i<ntimes;i+=stride) {
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      return;
+   }
+
+   const Int_t n = (ntimes - ifirst + stride - 1) / stride;
+   x += ifirst;
+   y += ifirst;
+   z += ifirst;
+   if (w) w += ifirst;
+   fEntries += n;
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i=0;i<n;i++) {
+         if (w[i*stride] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   Double_t *sumw2 = fSumw2.fN ? fSumw2.fArray : nullptr;
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+
+   const Int_t kBatchSize = 256;
+   Int_t binsx[kBatchSize], binsy[kBatchSize], binsz[kBatchSize];
+   Double_t ww = 1;
+   for (Int_t first=0;first<n;first+=kBatchSize) {
+      const Int_t nb = TMath::Min(kBatchSize, n-first);
+      const Double_t *xb = x + first*stride;
+      const Double_t *yb = y + first*stride;
+      const Double_t *zb = z + first*stride;
+      const Double_t *wb = w ? w + first*stride : nullptr;
+      fXaxis.FindFixBins(nb, xb, binsx, stride);
+      fYaxis.FindFixBins(nb, yb, binsy, stride);
+      fZaxis.FindFixBins(nb, zb, binsz, stride);
+      for (i=0;i<nb;i++) {
+         const Int_t binx = binsx[i];
+         const Int_t biny = binsy[i];
+         const Int_t binz = binsz[i];
+         const Int_t bin  = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (wb) ww = wb[i*stride];
+         if (sumw2) sumw2[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy || binz == 0 || binz > nbinsz))
+            continue;
+         const Double_t xi = xb[i*stride];
+         const Double_t yi = yb[i*stride];
+         const Double_t zi = zb[i*stride];
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
+         fTsumwy  += ww*yi;
+         fTsumwy2 += ww*yi*yi;
+         fTsumwxy += ww*xi*yi;
+         fTsumwz  += ww*zi;
+         fTsumwz2 += ww*zi*zi;
+         fTsumwxz += ww*xi*zi;
+         fTsumwyz += ww*yi*zi;
+      }
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -4012,6 +4123,10 @@ void TH3F::Streamer(TBuffer &R__b)
       UInt_t R__s, R__c;
       if (R__b.GetParent() && R__b.GetVersionOwner() < 22300) return;
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v == kSparseStreamerVersion) {
+         SparseStreamerRead(R__b, TH3F::Class(), *this, R__s, R__c);
+         return;
+      }
       if (R__v > 2) {
          R__b.ReadClassBuffer(TH3F::Class(), this, R__v, R__s, R__c);
          return;
@@ -4031,7 +4146,10 @@ void TH3F::Streamer(TBuffer &R__b)
       //====end of old versions
 
    } else {
-      R__b.WriteClassBuffer(TH3F::Class(),this);
+      if (SparseStreamerCheck(R__b, *this))
+         SparseStreamerWrite(R__b, TH3F::Class(), *this);
+      else
+         R__b.WriteClassBuffer(TH3F::Class(),this);
    }
 }
 
@@ -4223,6 +4341,10 @@ void TH3D::Streamer(TBuffer &R__b)
       UInt_t R__s, R__c;
       if (R__b.GetParent() && R__b.GetVersionOwner() < 22300) return;
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v == kSparseStreamerVersion) {
+         SparseStreamerRead(R__b, TH3D::Class(), *this, R__s, R__c);
+         return;
+      }
       if (R__v > 2) {
          R__b.ReadClassBuffer(TH3D::Class(), this, R__v, R__s, R__c);
          return;
@@ -4242,7 +4364,10 @@ void TH3D::Streamer(TBuffer &R__b)
       //====end of old versions
 
    } else {
-      R__b.WriteClassBuffer(TH3D::Class(),this);
+      if (SparseStreamerCheck(R__b, *this))
+         SparseStreamerWrite(R__b, TH3D::Class(), *this);
+      else
+         R__b.WriteClassBuffer(TH3D::Class(),this);
    }
 }
 
@@ -24,6 +24,7 @@
 #include "THnSparse.h"
 #include "TMath.h"
 #include "TRandom.h"
+#include "TROOT.h"
 #include "TVirtualPad.h"
 
 #include "HFitInterface.h"
@@ -32,6 +33,13 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/WrappedMultiTF1.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 
 /** \class THnBase
     \ingroup Hist
@@ -441,6 +449,52 @@ Bool_t THnBase::IsInRange(Int_t *coord) const
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries at once: the coordinates of entry i are
+/// x[i * GetNdimensions()], ..., x[(i + 1) * GetNdimensions() - 1], its weight
+/// w[i] (or 1 if w is NULL).
+
+void THnBase::FillN(Int_t n, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   for (Int_t i = 0; i < n; ++i)
+      Fill(x + (Long64_t)i * fNdimensions, w ? w[i] : 1.);
+}
+
+#ifdef R__USE_IMT
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Project the bins [first, last) of h that are inside the axis ranges onto
+/// the axes dim of hist, adding their contents to content and their squared
+/// errors (if wantErrors) to err2, both indexed by the bins of hist.
+/// binOffset is subtracted from the bin coordinates on the projected axes.
+/// Return whether bins have been skipped because they are outside the ranges.
+
+Bool_t ProjectBinRange(const THnBase& h, Long64_t first, Long64_t last, const TH1& hist, Int_t ndim,
+                       const Int_t* dim, const Int_t* binOffset, Bool_t wantErrors,
+                       std::vector<Double_t>& content, std::vector<Double_t>& err2)
+{
+   const Bool_t haveErrors = h.GetCalculateErrors();
+   std::vector<Int_t> coord(h.GetNdimensions());
+   Int_t bins[3] = {0, 0, 0};
+   Bool_t haveSkippedBin = kFALSE;
+   for (Long64_t myLinBin = first; myLinBin < last; ++myLinBin) {
+      const Double_t v = h.GetBinContent(myLinBin, coord.data());
+      if (!h.IsInRange(coord.data())) {
+         haveSkippedBin = kTRUE;
+         continue;
+      }
+      for (Int_t d = 0; d < ndim; ++d)
+         bins[d] = coord[dim[d]] - binOffset[d];
+      const Int_t targetLinBin = ndim == 1 ? bins[0] : hist.GetBin(bins[0], bins[1], bins[2]);
+      content[targetLinBin] += v;
+      if (wantErrors)
+         err2[targetLinBin] += haveErrors ? h.GetBinError2(myLinBin) : v;
+   }
+   return haveSkippedBin;
+}
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Project all bins into a ndim-dimensional THn / THnSparse (whatever
 /// *this is) or if (ndim < 4 and !wantNDim) a TH1/2/3 histogram,
@@ -521,12 +575,61 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Bool_t haveErrors = GetCalculateErrors();
    Bool_t wantErrors = haveErrors || (option && (strchr(option, 'E') || strchr(option, 'e')));
 
+   Bool_t haveSkippedBin = kFALSE;
+   Bool_t projected = kFALSE;
+#ifdef R__USE_IMT
+   // Project ranges of bins in parallel, each into its own content and error
+   // arrays; they are summed in a fixed order, to not depend on scheduling.
+   const Long64_t kMinBinsPerTask = 64 * 1024;
+   const Int_t kMaxTasks = 16;
+   const Long64_t nbins = GetNbins();
+   if (!wantNDim && ROOT::IsImplicitMTEnabled() && nbins >= 2 * kMinBinsPerTask) {
+      const Int_t ntasks = (Int_t) std::min<Long64_t>(kMaxTasks, nbins / kMinBinsPerTask);
+      const Int_t ncells = hist->GetNcells();
+      Int_t binOffset[3] = {0, 0, 0};
+      for (Int_t d = 0; d < ndim; ++d) {
+         if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
+            binOffset[d] = GetAxis(dim[d])->GetFirst();
+            // Don't subtract even more if underflow is alreday included:
+            if (binOffset[d] > 0) --binOffset[d];
+         }
+      }
+      // Set up what is lazily initialized by GetBinContent(), before reading concurrently.
+      GetBinContent(0, std::vector<Int_t>(fNdimensions).data());
+
+      std::vector<std::vector<Double_t>> contents(ntasks);
+      std::vector<std::vector<Double_t>> errors2(ntasks);
+      std::vector<Char_t> skipped(ntasks);
+      auto projectRange = [&](Int_t task) {
+         contents[task].resize(ncells);
+         if (wantErrors)
+            errors2[task].resize(ncells);
+         skipped[task] = ProjectBinRange(*this, nbins * task / ntasks, nbins * (task + 1) / ntasks, *hist, ndim, dim,
+                                         binOffset, wantErrors, contents[task], errors2[task]);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(projectRange, ROOT::TSeq<Int_t>(ntasks));
+
+      if (wantErrors && !hist->GetSumw2N())
+         hist->Sumw2();
+      for (Int_t task = 0; task < ntasks; ++task) {
+         haveSkippedBin |= skipped[task];
+         for (Int_t bin = 0; bin < ncells; ++bin) {
+            if (wantErrors)
+               hist->GetSumw2()->fArray[bin] += errors2[task][bin];
+            hist->AddBinContent(bin, contents[task][bin]);
+         }
+      }
+      projected = kTRUE;
+   }
+#endif
+
    Int_t* bins  = new Int_t[ndim];
    Long64_t myLinBin = 0;
 
    THnIter iter(this, kTRUE /*use axis range*/);
 
-   while ((myLinBin = iter.Next()) >= 0) {
+   while (!projected && (myLinBin = iter.Next()) >= 0) {
       Double_t v = GetBinContent(myLinBin);
 
       for (Int_t d = 0; d < ndim; ++d) {
@@ -575,7 +678,7 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    if (wantNDim) {
       hn->SetEntries(fEntries);
    } else {
-      if (!iter.HaveSkippedBin()) {
+      if (!iter.HaveSkippedBin() && !haveSkippedBin) {
          hist->SetEntries(fEntries);
       } else {
          // re-compute the entries
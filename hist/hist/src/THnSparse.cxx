@@ -16,6 +16,14 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
 
 namespace {
 //______________________________________________________________________________
@@ -271,9 +279,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromCoords(const Int_t* coord) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for fBins.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the fBins's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -319,9 +327,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for fBins.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the fBins's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -490,6 +498,74 @@ void THnSparseArrayChunk::Sumw2()
 }
 
 
+
+//______________________________________________________________________________
+//______________________________________________________________________________
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the entries to a table of nslots slots (a power of two).
+
+void ROOT::Internal::THnSparseBinIndex::Rehash(Long64_t nslots)
+{
+   std::vector<Slot_t> oldSlots(nslots, Slot_t{0, -1});
+   fSlots.swap(oldSlots);
+   fShift = 64;
+   while (nslots > 1) {
+      nslots /= 2;
+      --fShift;
+   }
+   const size_t mask = fSlots.size() - 1;
+   for (const Slot_t& slot: oldSlots) {
+      if (slot.fIndex < 0)
+         continue;
+      size_t s = GetFirstSlot(slot.fHash);
+      while (fSlots[s].fIndex >= 0)
+         s = (s + 1) & mask;
+      fSlots[s] = slot;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin with linear index "index" and hash "hash". The table is kept
+/// at most half full.
+
+void ROOT::Internal::THnSparseBinIndex::Add(ULong64_t hash, Long64_t index)
+{
+   if (2 * (fSize + 1) > GetCapacity())
+      Rehash(std::max<Long64_t>(16, 2 * GetCapacity()));
+   const size_t mask = fSlots.size() - 1;
+   size_t s = GetFirstSlot(hash);
+   while (fSlots[s].fIndex >= 0)
+      s = (s + 1) & mask;
+   fSlots[s].fHash = hash;
+   fSlots[s].fIndex = index;
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all entries and free the table.
+
+void ROOT::Internal::THnSparseBinIndex::Clear()
+{
+   std::vector<Slot_t>().swap(fSlots);
+   fSize = 0;
+   fShift = 64;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for nbins bins without rehashing.
+
+void ROOT::Internal::THnSparseBinIndex::Reserve(Long64_t nbins)
+{
+   Long64_t nslots = 16;
+   while (nslots < 2 * nbins)
+      nslots *= 2;
+   if (nslots > GetCapacity())
+      Rehash(nslots);
+}
+
+
 /** \class THnSparse
     \ingroup Hist
 
@@ -571,14 +647,19 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open-addressing hash
+table fBins (see ROOT::Internal::THnSparseBinIndex), which stores the hash
+next to each linear index. For entries with the same hash, the coordinates of
+the bin are compared to the coordinates passed to GetBin(). If they do not
+match, these two coordinates have the same hash - which is extremely unlikely
+but (for the case where the compact bin coordinates are larger than 8 bytes)
+possible; the lookup then continues with the next entry with that hash.
+
+## Bulk Operations
+FillN() fills many entries at once, looking up the axis bins of a block of
+entries one axis at a time. When implicit multi-threading is enabled (see
+ROOT::EnableImplicitMT()), projections to TH1, TH2 and TH3 and Add() / Merge()
+of THnSparse with the same binning process the chunks of bins in parallel.
 */
 
 
@@ -659,28 +740,14 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBins.Add(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -691,9 +758,7 @@ void THnSparse::Reserve(Long64_t nbins) {
    if (!fBins.GetSize() && fBinContent.GetSize()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -793,20 +858,31 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    ULong64_t hash = cc->GetHash();
    if (fBinContent.GetSize() && !fBins.GetSize())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
+   Long64_t linidx = FindBinIndex(hash, cc->GetBuffer());
+   if (linidx >= 0 || !allocate)
+      return linidx;
 
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+   return AllocateBin(hash, cc->GetBuffer());
+}
 
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the filled bin with compact coordinate coordbuf, whose
+/// hash is "hash", or -1 if that bin is not filled.
+/// Does not modify the histogram; fBins must be set up (see FillExMap()).
 
+Long64_t THnSparse::FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const
+{
+   return fBins.Find(hash, [this, coordbuf](Long64_t linidx) {
+      return GetChunk(linidx / fChunkSize)->Matches(linidx % fChunkSize, coordbuf);
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a new bin with compact coordinate coordbuf, whose hash is "hash",
+/// and return its index. The bin must not exist yet.
+
+Long64_t THnSparse::AllocateBin(ULong64_t hash, const Char_t* coordbuf)
+{
    ++fFilledBins;
 
    // allocate bin in chunk
@@ -816,23 +892,130 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, coordbuf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBins.Add(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries at once: the coordinates of entry i are
+/// x[i * GetNdimensions()], ..., x[(i + 1) * GetNdimensions() - 1], its weight
+/// w[i] (or 1 if w is NULL).
+///
+/// The axis bins are determined for blocks of entries, one axis at a time
+/// (see TAxis::FindFixBins()), which is considerably faster than calling
+/// Fill() for each entry.
+
+void THnSparse::FillN(Int_t n, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   for (Int_t d = 0; d < fNdimensions; ++d) {
+      if (GetAxis(d)->CanExtend()) {
+         // FindBin() might extend the axis.
+         THnBase::FillN(n, x, w);
+         return;
+      }
+   }
+
+   if (fBinContent.GetSize() && !fBins.GetSize())
+      FillExMap();
+
+   const Int_t kBlockSize = 256;
+   std::vector<Int_t> axisBins(fNdimensions * kBlockSize);
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   Int_t* coord = cc->GetCoord();
+   for (Int_t first = 0; first < n; first += kBlockSize) {
+      const Int_t nblock = std::min(kBlockSize, n - first);
+      const Double_t* xblock = x + (Long64_t)first * fNdimensions;
+      for (Int_t d = 0; d < fNdimensions; ++d)
+         GetAxis(d)->FindFixBins(nblock, xblock + d, &axisBins[d * kBlockSize], fNdimensions);
+
+      for (Int_t i = 0; i < nblock; ++i) {
+         for (Int_t d = 0; d < fNdimensions; ++d)
+            coord[d] = axisBins[d * kBlockSize + i];
+         cc->UpdateCoord();
+         const Double_t wi = w ? w[first + i] : 1.;
+         UpdateXStat(xblock + i * fNdimensions, wi);
+         FillBin(GetBinIndexForCurrentBin(kTRUE), wi);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add() implementation; see THnBase::AddInternal().
+///
+/// If h is a THnSparse with the same binning, the compact bin coordinates of
+/// h are looked up directly, without converting them to bin coordinates and
+/// back. The lookups do not modify this histogram: with implicit
+/// multi-threading enabled they are done in parallel, one task per chunk of h.
+/// The missing bins are then allocated and the contents added in the order
+/// of the bins of h.
+
+void THnSparse::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (rebinned || !hs || fNdimensions != h->GetNdimensions()) {
+      THnBase::AddInternal(h, c, rebinned);
+      return;
+   }
+   for (Int_t d = 0; d < fNdimensions; ++d) {
+      if (GetAxis(d)->GetNbins() != h->GetAxis(d)->GetNbins()) {
+         THnBase::AddInternal(h, c, rebinned);
+         return;
+      }
+   }
+
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+   Bool_t haveErrors = GetCalculateErrors();
+
+   const Long64_t nbins = hs->GetNbins();
+   Reserve(GetNbins() + nbins);
+   const THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t coordSize = cc->GetBufferSize();
+   const Int_t hChunkSize = hs->GetChunkSize();
+
+   std::vector<Long64_t> targetBins(nbins);
+   auto findChunkBins = [&](Int_t ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Long64_t offset = (Long64_t)ichunk * hChunkSize;
+      const Int_t nchunkbins = chunk->GetEntries();
+      for (Int_t i = 0; i < nchunkbins; ++i) {
+         const Char_t* buf = chunk->fCoordinates + i * coordSize;
+         targetBins[offset + i] = FindBinIndex(cc->GetHashFromBuffer(buf), buf);
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && hs->GetNChunks() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(findChunkBins, ROOT::TSeq<Int_t>(hs->GetNChunks()));
+   } else
+#endif
+   {
+      for (Int_t ichunk = 0; ichunk < hs->GetNChunks(); ++ichunk)
+         findChunkBins(ichunk);
+   }
+
+   for (Long64_t i = 0; i < nbins; ++i) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(i / hChunkSize);
+      const Int_t ichunkbin = i % hChunkSize;
+      Long64_t mybinidx = targetBins[i];
+      if (mybinidx < 0) {
+         const Char_t* buf = chunk->fCoordinates + ichunkbin * coordSize;
+         mybinidx = AllocateBin(cc->GetHashFromBuffer(buf), buf);
+      }
+      if (haveErrors)
+         AddBinError2(mybinidx, hs->GetBinError2(i) * c * c);
+      // only _after_ error calculation, or sqrt(v) is taken into account!
+      AddBinContent(mybinidx, c * chunk->fContent->GetAt(ichunkbin));
+   }
+
+   SetEntries(GetEntries() + c * h->GetEntries());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -881,7 +1064,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += fBins.GetMemorySize();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +1146,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -21,6 +21,9 @@
 #include <TFitResult.h>
 #include <TH1.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -277,6 +280,54 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheckAccuracyDemo)
 
 // FIXME: Add more: crystalball, cheb3, bigaus?
 
+TEST(TFormulaGradientPar, TF1GradientPar)
+{
+   TF1 f("f2", "[0]*exp(-[1]*x)+[2]*x*x");
+   double p[] = {2, 0.5, 0.1};
+   f.SetParameters(p);
+   double x[] = {1.5};
+
+   TFormula::GradientStorage result_clad(3);
+   f.GetFormula()->GradientPar(x, result_clad);
+   // TF1::GradientPar uses the generated gradient and does not accumulate
+   // into the output array.
+   double result[] = {-1, -1, -1};
+   f.GradientPar(x, result);
+   EXPECT_DOUBLE_EQ(result_clad[0], result[0]);
+   EXPECT_DOUBLE_EQ(result_clad[1], result[1]);
+   EXPECT_DOUBLE_EQ(result_clad[2], result[2]);
+   EXPECT_DOUBLE_EQ(std::exp(-0.75), result[0]);
+   EXPECT_DOUBLE_EQ(x[0] * x[0], result[2]);
+
+   // The gradient along a fixed parameter is null.
+   f.FixParameter(1, 0.5);
+   f.GradientPar(x, result);
+   EXPECT_DOUBLE_EQ(result_clad[0], result[0]);
+   EXPECT_EQ(0, result[1]);
+   EXPECT_DOUBLE_EQ(result_clad[2], result[2]);
+}
+
+TEST(TFormulaGradientPar, FitWithGradient)
+{
+   TH1D h("hgrad", "hgrad", 50, -5, 5);
+   TF1 gen("gen", "gaus", -5, 5);
+   gen.SetParameters(1, 0.3, 1.2);
+   h.FillRandom("gen", 10000);
+
+   TF1 f("fgrad", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f.SetParameters(h.GetMaximum(), 0, 1);
+   auto resNumerical = h.Fit(&f, "Q N S");
+   std::vector<double> parNumerical(f.GetParameters(), f.GetParameters() + 3);
+
+   f.SetParameters(h.GetMaximum(), 0, 1);
+   auto resGradient = h.Fit(&f, "Q N S G");
+   ASSERT_EQ(0, resNumerical->Status());
+   ASSERT_EQ(0, resGradient->Status());
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(parNumerical[i], f.GetParameter(i), 1e-3 * std::abs(parNumerical[i]) + 1e-4);
+   EXPECT_NEAR(resNumerical->Chi2(), resGradient->Chi2(), 1e-3 * resNumerical->Chi2());
+}
+
 // FIXME: Disable because of a known failure in -Druntime_cxxmodules=On.
 // This is identical to getFuncBody test failure in roottest.
 TEST(DISABLED_TFormulaGradientPar, GetGradFormula)
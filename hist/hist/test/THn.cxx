@@ -1,8 +1,14 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -108,3 +114,119 @@ TEST(THn, Projection) {
 
 
 }
+
+
+// Random points, NDIM coordinates per point, some outside the axes.
+static std::vector<Double_t> MakeSparsePoints(Int_t npoints, Int_t ndim, UInt_t seed)
+{
+   TRandom3 rnd(seed);
+   std::vector<Double_t> x(npoints * ndim);
+   for (auto &xi : x)
+      xi = rnd.Uniform(-0.1, 1.1);
+   return x;
+}
+
+static std::unique_ptr<THnSparseD> MakeSparse(const char *name, Int_t ndim, Int_t nbins)
+{
+   std::vector<Int_t> bins(ndim, nbins);
+   std::vector<Double_t> xmin(ndim, 0.);
+   std::vector<Double_t> xmax(ndim, 1.);
+   std::unique_ptr<THnSparseD> h(new THnSparseD(name, name, ndim, bins.data(), xmin.data(), xmax.data(), 1024));
+   h->Sumw2();
+   return h;
+}
+
+// Check that a and b have the same bins with the same contents and errors.
+static void ExpectSameBins(const THnSparse &a, const THnSparse &b)
+{
+   ASSERT_EQ(a.GetNbins(), b.GetNbins());
+   std::vector<Int_t> coord(a.GetNdimensions());
+   for (Long64_t i = 0; i < a.GetNbins(); ++i) {
+      const Double_t v = a.GetBinContent(i, coord.data());
+      const Long64_t j = b.GetBin(coord.data());
+      ASSERT_GE(j, 0);
+      EXPECT_DOUBLE_EQ(v, b.GetBinContent(j));
+      EXPECT_DOUBLE_EQ(a.GetBinError2(i), b.GetBinError2(j));
+   }
+}
+
+// FillN gives the same bins as Fill, also with a compact coordinate larger
+// than 8 bytes.
+TEST(THnSparse, FillN) {
+   for (Int_t ndim : {3, 12}) {
+      const Int_t npoints = 5000;
+      auto x = MakeSparsePoints(npoints, ndim, 1);
+      std::vector<Double_t> w(npoints);
+      for (Int_t i = 0; i < npoints; ++i)
+         w[i] = 0.5 + i % 3;
+
+      auto hFill = MakeSparse("hFill", ndim, 40);
+      auto hFillN = MakeSparse("hFillN", ndim, 40);
+      for (Int_t i = 0; i < npoints; ++i)
+         hFill->Fill(&x[i * ndim], w[i]);
+      hFillN->FillN(npoints / 2, x.data(), w.data());
+      hFillN->FillN(npoints - npoints / 2, &x[npoints / 2 * ndim], &w[npoints / 2]);
+
+      ExpectSameBins(*hFill, *hFillN);
+      EXPECT_DOUBLE_EQ(hFill->GetEntries(), hFillN->GetEntries());
+      EXPECT_DOUBLE_EQ(hFill->GetSumw(), hFillN->GetSumw());
+      EXPECT_DOUBLE_EQ(hFill->GetSumw2(), hFillN->GetSumw2());
+      for (Int_t d = 0; d < ndim; ++d)
+         EXPECT_DOUBLE_EQ(hFill->GetSumwx(d), hFillN->GetSumwx(d));
+   }
+}
+
+// Adding a THnSparse with the same binning gives the same bins as filling
+// the entries of both; with one bin per axis many entries share a bin.
+TEST(THnSparse, Add) {
+   const Int_t ndim = 10;
+   const Int_t npoints = 4000;
+   auto x = MakeSparsePoints(2 * npoints, ndim, 2);
+
+   auto hAll = MakeSparse("hAll", ndim, 1);
+   auto hA = MakeSparse("hA", ndim, 1);
+   auto hB = MakeSparse("hB", ndim, 1);
+   hAll->FillN(2 * npoints, x.data());
+   hA->FillN(npoints, x.data());
+   hB->FillN(npoints, &x[npoints * ndim]);
+
+   hA->Add(hB.get());
+   ExpectSameBins(*hAll, *hA);
+   EXPECT_DOUBLE_EQ(2 * npoints, hA->GetEntries());
+
+   // Adding to itself doubles the contents.
+   hB->Add(hB.get(), 1.);
+   EXPECT_DOUBLE_EQ(2 * npoints, hB->GetEntries());
+}
+
+#ifdef R__USE_IMT
+// The parallel projection gives the same result as the sequential one.
+TEST(THnSparse, ParallelProjection) {
+   const Int_t ndim = 8;
+   const Int_t npoints = 300000;
+   auto x = MakeSparsePoints(npoints, ndim, 3);
+   auto h = MakeSparse("h", ndim, 20);
+   h->FillN(npoints, x.data());
+   h->GetAxis(3)->SetRange(2, 15);
+   ASSERT_GT(h->GetNbins(), 2 * 64 * 1024);
+
+   std::unique_ptr<TH1D> seq1(h->Projection(1));
+   std::unique_ptr<TH2D> seq2(h->Projection(2, 1, "E"));
+
+   ROOT::EnableImplicitMT(4);
+   std::unique_ptr<TH1D> par1(h->Projection(1));
+   std::unique_ptr<TH2D> par2(h->Projection(2, 1, "E"));
+   ROOT::DisableImplicitMT();
+
+   for (Int_t bin = 0; bin < seq1->GetNcells(); ++bin) {
+      EXPECT_NEAR(seq1->GetBinContent(bin), par1->GetBinContent(bin), 1e-9 * seq1->GetBinContent(bin));
+      EXPECT_NEAR(seq1->GetBinError(bin), par1->GetBinError(bin), 1e-9 * seq1->GetBinError(bin));
+   }
+   for (Int_t bin = 0; bin < seq2->GetNcells(); ++bin) {
+      EXPECT_NEAR(seq2->GetBinContent(bin), par2->GetBinContent(bin), 1e-9 * seq2->GetBinContent(bin));
+      EXPECT_NEAR(seq2->GetBinError(bin), par2->GetBinError(bin), 1e-9 * seq2->GetBinError(bin));
+   }
+   EXPECT_DOUBLE_EQ(seq1->GetEntries(), par1->GetEntries());
+   EXPECT_DOUBLE_EQ(seq2->GetEntries(), par2->GetEntries());
+}
+#endif
@@ -1,9 +1,96 @@
 #include "gtest/gtest.h"
 
 #include "TFormula.h"
+#include "TF1.h"
+
+#include <cmath>
+#include <vector>
 
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// The batch evaluation gives the same results as the point by point one.
+TEST(TFormula, EvalBatch)
+{
+   const int n = 37;
+   std::vector<double> x(3 * n);
+   for (int i = 0; i < 3 * n; ++i)
+      x[i] = 0.1 * i - 2.;
+   std::vector<double> result(n);
+
+   TFormula f1("batch1", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*x");
+   f1.SetParameters(2., 0.3, 0.7, 0.1);
+   f1.EvalBatch(n, x.data(), result.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f1.Eval(x[i]), result[i]);
+
+   const double params[] = {1., -1., 2., 0.};
+   f1.EvalBatch(n, x.data(), result.data(), params);
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f1.EvalPar(&x[i], params), result[i]);
+
+   TFormula f3("batch3", "x*y + sin(z)");
+   f3.EvalBatch(n, x.data(), result.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f3.Eval(x[i], x[n + i], x[2 * n + i]), result[i]);
+
+   TFormula f0("batch0", "[0]+[1]");
+   f0.SetParameters(1.5, 2.);
+   f0.EvalBatch(n, nullptr, result.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(3.5, result[i]);
+}
+
+// TF1::EvalBatch, also for functions which are not formulas.
+static double BatchLine(double *x, double *p)
+{
+   return p[0] + p[1] * x[0];
+}
+
+TEST(TF1, EvalBatch)
+{
+   const int n = 20;
+   std::vector<double> x(n);
+   for (int i = 0; i < n; ++i)
+      x[i] = 0.25 * i;
+   std::vector<double> result(n);
+
+   TF1 formula("batchFormula", "[0]+[1]*x*x", 0., 5.);
+   formula.SetParameters(1., 2.);
+   formula.EvalBatch(n, x.data(), result.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(formula.Eval(x[i]), result[i]);
+
+   TF1 freeFunc("batchFreeFunc", BatchLine, 0., 5., 2);
+   freeFunc.SetParameters(-1., 3.);
+   freeFunc.EvalBatch(n, x.data(), result.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(-1. + 3. * x[i], result[i]);
+}
+
+// Equivalent spellings of an expression share the same compiled function.
+TEST(TFormula, NormalizedExpression)
+{
+   TFormula spelled("spelled", "x*2.50 + [0] * sin( (x) )  -  ([1])");
+   TFormula compact("compact", "x*2.5+[0]*sin(x)-[1]");
+   EXPECT_EQ(compact.GetExpFormula("CLING"), spelled.GetExpFormula("CLING"));
+
+   spelled.SetParameters(2., 1.);
+   compact.SetParameters(2., 1.);
+   EXPECT_DOUBLE_EQ(compact.Eval(0.5), spelled.Eval(0.5));
+   EXPECT_DOUBLE_EQ(0.5 * 2.5 + 2. * std::sin(0.5) - 1., spelled.Eval(0.5));
+
+   // Integer literals are kept: 1/2 is not 1./2.
+   TFormula integer("integer", "1/2*x");
+   TFormula floating("floating", "1./2.*x");
+   EXPECT_NE(integer.GetExpFormula("CLING"), floating.GetExpFormula("CLING"));
+   EXPECT_DOUBLE_EQ(0., integer.Eval(3.));
+   EXPECT_DOUBLE_EQ(1.5, floating.Eval(3.));
+
+   // Parentheses are only removed around a single operand.
+   TFormula grouped("grouped", "3*(x-1)");
+   EXPECT_DOUBLE_EQ(6., grouped.Eval(3.));
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include "TFormula.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// The on-disk cache holds every formula compiled in the process, so this test
+// has its own executable: the other TFormula tests use functions which cannot
+// be compiled outside of Cling.
+
+// The functions saved in an on-disk cache are read back by a later load, and
+// the cache saved again contains the same functions.
+TEST(TFormula, CompiledCacheRoundTrip)
+{
+   TFormula f("cached", "[0]*x*x + 0.125");
+   f.SetParameter(0, 3.);
+   ASSERT_DOUBLE_EQ(3. * 4. + 0.125, f.Eval(2.));
+
+   const TString directory = TString::Format("%s/TFormulaCacheTest_%d", gSystem->TempDirectory(), gSystem->GetPid());
+   const TString copyDirectory = directory + "_copy";
+   ASSERT_TRUE(TFormula::SaveCompiledCache(directory));
+
+   auto readIndex = [](const TString &dir) {
+      std::vector<std::string> lines;
+      std::ifstream in(TString::Format("%s/TFormulaCache.txt", dir.Data()).Data());
+      std::string line;
+      while (std::getline(in, line))
+         lines.push_back(line);
+      return lines;
+   };
+   const auto index = readIndex(directory);
+   const std::string body = std::string("return ") + f.GetExpFormula("CLING").Data();
+   EXPECT_EQ(1, std::count_if(index.begin(), index.end(),
+                              [&](const std::string &line) { return line.find(body) != std::string::npos; }));
+
+   ASSERT_TRUE(TFormula::LoadCompiledCache(directory));
+   TFormula again("cachedAgain", "[0] * x * x + 0.1250");
+   again.SetParameter(0, 3.);
+   EXPECT_DOUBLE_EQ(f.Eval(2.), again.Eval(2.));
+
+   ASSERT_TRUE(TFormula::SaveCompiledCache(copyDirectory));
+   EXPECT_EQ(index, readIndex(copyDirectory));
+
+   gSystem->Exec(TString::Format("rm -rf %s %s", directory.Data(), copyDirectory.Data()));
+}
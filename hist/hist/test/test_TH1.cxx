@@ -2,6 +2,19 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH2F.h"
+#include "TH2I.h"
+#include "TH3D.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +43,230 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// Values covering the underflow, overflow, bin edges and NaN.
+static std::vector<double> MakeFillValues()
+{
+   std::vector<double> values{-1e300, -2., 0., 0.5, 1., 2.5, 10., 1e300, std::numeric_limits<double>::quiet_NaN()};
+   for (int i = 0; i < 1000; ++i)
+      values.push_back(-1. + 0.0123 * i);
+   return values;
+}
+
+static void ExpectSameHistograms(const TH1 &expected, const TH1 &actual)
+{
+   ASSERT_EQ(expected.GetNcells(), actual.GetNcells());
+   for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(expected.GetBinContent(bin), actual.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(expected.GetBinError(bin), actual.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), actual.GetEntries());
+   double statsExpected[13], statsActual[13];
+   expected.GetStats(statsExpected);
+   actual.GetStats(statsActual);
+   for (int i = 0; i < 13; ++i)
+      EXPECT_DOUBLE_EQ(statsExpected[i], statsActual[i]) << "stat " << i;
+}
+
+// The batched bin lookup of FillN must give the same result as Fill.
+TEST(TH1, FillNFixedAndVariableBins)
+{
+   const auto x = MakeFillValues();
+   std::vector<double> w(x.size());
+   for (std::size_t i = 0; i < w.size(); ++i)
+      w[i] = 0.5 + (i % 3);
+   const double edges[] = {-1., -0.5, 0., 0.1, 0.5, 1., 2., 5.};
+
+   TH1D fixFill("fixFill", "", 13, -1., 5.);
+   TH1D fixFillN("fixFillN", "", 13, -1., 5.);
+   TH1D varFill("varFill", "", 7, edges);
+   TH1D varFillN("varFillN", "", 7, edges);
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      fixFill.Fill(x[i], w[i]);
+      varFill.Fill(x[i], w[i]);
+   }
+   fixFillN.FillN(x.size(), x.data(), w.data());
+   varFillN.FillN(x.size(), x.data(), w.data());
+   ExpectSameHistograms(fixFill, fixFillN);
+   ExpectSameHistograms(varFill, varFillN);
+
+   // Unweighted, with a stride.
+   TH1D strideFill("strideFill", "", 7, edges);
+   TH1D strideFillN("strideFillN", "", 7, edges);
+   for (std::size_t i = 0; i < x.size(); i += 3)
+      strideFill.Fill(x[i]);
+   strideFillN.FillN((x.size() + 2) / 3, x.data(), nullptr, 3);
+   ExpectSameHistograms(strideFill, strideFillN);
+   EXPECT_EQ(0, strideFillN.GetSumw2N());
+
+   // Bins of zero width: an abscissa equal to repeated edges goes to the bin
+   // starting at the first of them, as with Fill.
+   const double zeroWidthEdges[] = {0., 1., 1., 2., 3.};
+   const std::vector<double> xz{0., 0.5, 1., 1.5, 2., 2.5, 3.};
+   TH1D zeroFill("zeroFill", "", 4, zeroWidthEdges);
+   TH1D zeroFillN("zeroFillN", "", 4, zeroWidthEdges);
+   for (auto xi : xz)
+      zeroFill.Fill(xi);
+   zeroFillN.FillN(xz.size(), xz.data(), nullptr);
+   ExpectSameHistograms(zeroFill, zeroFillN);
+   EXPECT_EQ(1, zeroFillN.GetBinContent(2));
+   EXPECT_EQ(1, zeroFillN.GetBinContent(3));
+}
+
+// The lookup table of variable bin axes must give the same bins as a binary
+// search over the edges, for linear and logarithmic bins and for bins of zero
+// width.
+TEST(TH1, VariableBinLookup)
+{
+   std::vector<double> logEdges(1001), linEdges(101);
+   for (std::size_t i = 0; i < logEdges.size(); ++i)
+      logEdges[i] = std::pow(10., -2. + 8. * i / (logEdges.size() - 1));
+   for (std::size_t i = 0; i < linEdges.size(); ++i)
+      linEdges[i] = -3. + 0.05 * i + 0.005 * (i % 7); // slightly irregular
+   linEdges[50] = linEdges[49];                        // empty bin
+   linEdges[80] = linEdges[81] = linEdges[79];         // two empty bins in a row
+
+   for (const auto *edgesPtr : {&logEdges, &linEdges}) {
+      const auto &edges = *edgesPtr;
+      TAxis axis(edges.size() - 1, edges.data());
+      TAxis copy(axis);
+      std::vector<double> x;
+      for (std::size_t i = 0; i + 1 < edges.size(); ++i) {
+         x.push_back(edges[i]);
+         x.push_back(0.5 * (edges[i] + edges[i + 1]));
+         x.push_back(std::nextafter(edges[i + 1], edges[i]));
+      }
+      x.push_back(edges.front() - 1.);
+      x.push_back(edges.back());
+      x.push_back(std::numeric_limits<double>::quiet_NaN());
+
+      std::vector<int> bins(x.size());
+      axis.FindFixBins(x.size(), x.data(), bins.data());
+      for (std::size_t i = 0; i < x.size(); ++i) {
+         int expected = 1 + TMath::BinarySearch(edges.size(), edges.data(), x[i]);
+         if (!(x[i] < edges.back()))
+            expected = edges.size(); // overflow and NaN
+         EXPECT_EQ(expected, axis.FindFixBin(x[i])) << "x = " << x[i];
+         EXPECT_EQ(expected, copy.FindFixBin(x[i])) << "x = " << x[i];
+         EXPECT_EQ(expected, bins[i]) << "x = " << x[i];
+      }
+   }
+
+   // Changing the bins updates the lookup.
+   TAxis axis(logEdges.size() - 1, logEdges.data());
+   axis.Set(linEdges.size() - 1, linEdges.data());
+   EXPECT_EQ(50, axis.FindFixBin(linEdges[50]));
+   EXPECT_EQ(80, axis.FindFixBin(linEdges[81]));
+   axis.Set(10, 0., 1.);
+   EXPECT_EQ(3, axis.FindFixBin(0.25));
+}
+
+TEST(TH1, FillN2D3D)
+{
+   const auto x = MakeFillValues();
+   std::vector<double> y(x.rbegin(), x.rend());
+   std::vector<double> z(x.size());
+   std::vector<double> w(x.size());
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      z[i] = std::sin(0.1 * i);
+      w[i] = 0.5 + (i % 3);
+   }
+   const double edges[] = {-1., -0.5, 0., 0.1, 0.5, 1., 2., 5.};
+
+   TH2D h2Fill("h2Fill", "", 13, -1., 5., 7, edges);
+   TH2D h2FillN("h2FillN", "", 13, -1., 5., 7, edges);
+   TH3D h3Fill("h3Fill", "", 13, -1., 5., 5, -1., 1., 4, 0., 1.);
+   TH3D h3FillN("h3FillN", "", 13, -1., 5., 5, -1., 1., 4, 0., 1.);
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      h2Fill.Fill(x[i], y[i], w[i]);
+      h3Fill.Fill(x[i], z[i], y[i], w[i]);
+   }
+   h2FillN.FillN(x.size(), x.data(), y.data(), w.data());
+   h3FillN.FillN(x.size(), x.data(), z.data(), y.data(), w.data());
+   ExpectSameHistograms(h2Fill, h2FillN);
+   ExpectSameHistograms(h3Fill, h3FillN);
+}
+
+// Merge ninputs histograms filled with integer-valued sums of weights (so the
+// order of the additions does not matter) and compare with filling directly.
+template <typename HIST>
+static void CheckSameAxesMerge(int nx, int ny, int ninputs, bool weighted)
+{
+   HIST expected("expected", "", nx, -1., 1., ny, -1., 1.);
+   HIST merged("merged", "", nx, -1., 1., ny, -1., 1.);
+   if (weighted)
+      expected.Sumw2();
+   TList inputs;
+   inputs.SetOwner();
+   for (int i = 0; i < ninputs; ++i) {
+      auto h = new HIST(TString::Format("h%d", i), "", nx, -1., 1., ny, -1., 1.);
+      h->SetDirectory(nullptr);
+      if (i % 7 != 3) { // leave some of them empty
+         for (int j = 0; j < 500; ++j) {
+            const double x = std::sin(0.37 * i + 1.1 * j);
+            const double y = std::cos(0.71 * i + 0.3 * j);
+            const double w = weighted ? 0.5 + (j % 3) : 1.;
+            h->Fill(x, y, w);
+            expected.Fill(x, y, w);
+         }
+      }
+      inputs.Add(h);
+   }
+   EXPECT_EQ(expected.GetEntries(), merged.Merge(&inputs));
+
+   ASSERT_EQ(expected.GetNcells(), merged.GetNcells());
+   for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(expected.GetBinContent(bin), merged.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(expected.GetBinError(bin), merged.GetBinError(bin)) << "bin " << bin;
+   }
+   double statsExpected[13], statsMerged[13];
+   expected.GetStats(statsExpected);
+   merged.GetStats(statsMerged);
+   for (int i = 0; i < 7; ++i)
+      EXPECT_NEAR(statsExpected[i], statsMerged[i], 1e-9 * std::abs(statsExpected[i])) << "stat " << i;
+}
+
+// Histograms with the same axes are merged with element-wise array additions
+// for TH2D and TH2F, and bin by bin for the other types.
+TEST(TH1, MergeSameAxes)
+{
+   CheckSameAxesMerge<TH2D>(20, 10, 30, true);
+   CheckSameAxesMerge<TH2D>(20, 10, 30, false);
+   CheckSameAxesMerge<TH2F>(20, 10, 30, true);
+   CheckSameAxesMerge<TH2I>(20, 10, 30, false);
+}
+
+#ifdef R__USE_IMT
+// Many inputs are summed in parallel and reduced as a binary tree.
+TEST(TH1, MergeSameAxesParallel)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckSameAxesMerge<TH2D>(100, 100, 70, true);
+   CheckSameAxesMerge<TH2D>(100, 100, 70, false);
+   CheckSameAxesMerge<TH2F>(100, 100, 70, true);
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+// An input without sum of squared weights contributes its bin contents to the
+// squared errors, also where they are negative, as in the bin by bin merge.
+TEST(TH1, MergeSameAxesNegativeContent)
+{
+   TH1D merged("merged", "", 10, 0., 1.);
+   merged.Sumw2();
+   TList inputs;
+   inputs.SetOwner();
+   auto weighted = new TH1D("weighted", "", 10, 0., 1.);
+   weighted->SetDirectory(nullptr);
+   weighted->Sumw2();
+   weighted->Fill(0.55, 2.);
+   inputs.Add(weighted);
+   auto unweighted = new TH1D("unweighted", "", 10, 0., 1.);
+   unweighted->SetDirectory(nullptr);
+   unweighted->SetBinContent(6, -1.);
+   inputs.Add(unweighted);
+   merged.Merge(&inputs);
+
+   EXPECT_DOUBLE_EQ(1., merged.GetBinContent(6));
+   EXPECT_DOUBLE_EQ(3., merged.GetSumw2()->At(6));
+}
@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/TH1ConcurrentFill.hxx"
+#include "TH1D.h"
+#include "TH1F.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TProfile.h"
+
+#include <thread>
+#include <vector>
+
+static const int kNThreads = 4;
+static const int kNFillsPerThread = 5000;
+
+// Fill the histogram from kNThreads threads, each with its own filler; the
+// fills are exact in floating point so that the result is independent of the
+// order in which the fillers flush.
+template <class HIST, class FILL>
+void FillConcurrently(HIST &h, ROOT::EH1ConcurrentFillMode mode, FILL fill)
+{
+   ROOT::TH1ConcurrentFillManager<HIST, 128> manager(h, mode);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < kNThreads; ++t) {
+      threads.emplace_back([&manager, &fill, t]() {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < kNFillsPerThread; ++i)
+            fill(filler, t * kNFillsPerThread + i);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   manager.Merge();
+}
+
+// Fill the histogram directly, for the reference.
+template <class HIST>
+struct SerialFiller {
+   HIST &fHist;
+   template <typename... ARGS>
+   void Fill(ARGS... args)
+   {
+      fHist.Fill(args...);
+   }
+};
+
+template <class HIST, class FILL>
+void CheckAllModes(const HIST &model, FILL fill)
+{
+   std::unique_ptr<HIST> reference(static_cast<HIST *>(model.Clone("reference")));
+   SerialFiller<HIST> serial{*reference};
+   for (int i = 0; i < kNThreads * kNFillsPerThread; ++i)
+      fill(serial, i);
+
+   for (auto mode : {ROOT::EH1ConcurrentFillMode::kBuffered, ROOT::EH1ConcurrentFillMode::kAtomic,
+                     ROOT::EH1ConcurrentFillMode::kPerThread}) {
+      std::unique_ptr<HIST> h(static_cast<HIST *>(model.Clone("concurrent")));
+      FillConcurrently(*h, mode, fill);
+      ASSERT_EQ(reference->GetNcells(), h->GetNcells());
+      for (int bin = 0; bin < h->GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(reference->GetBinContent(bin), h->GetBinContent(bin)) << "mode " << int(mode);
+         EXPECT_DOUBLE_EQ(reference->GetBinError(bin), h->GetBinError(bin)) << "mode " << int(mode);
+      }
+      EXPECT_DOUBLE_EQ(reference->GetEntries(), h->GetEntries()) << "mode " << int(mode);
+      EXPECT_DOUBLE_EQ(reference->GetMean(), h->GetMean()) << "mode " << int(mode);
+      EXPECT_DOUBLE_EQ(reference->GetStdDev(), h->GetStdDev()) << "mode " << int(mode);
+   }
+}
+
+struct Fill1DWeighted {
+   template <class FILLER>
+   void operator()(FILLER &filler, int i) const { filler.Fill((i * 7) % 110 - 5., 1. + i % 2); }
+};
+
+struct Fill1D {
+   template <class FILLER>
+   void operator()(FILLER &filler, int i) const { filler.Fill((i * 7) % 110 - 5.); }
+};
+
+struct Fill2D {
+   template <class FILLER>
+   void operator()(FILLER &filler, int i) const { filler.Fill(i % 100 + 0.5, i % 11 + 0.5, 0.5 * (i % 4)); }
+};
+
+struct Fill3D {
+   template <class FILLER>
+   void operator()(FILLER &filler, int i) const { filler.Fill(i % 100 + 0.5, i % 11 + 0.5, i % 3 + 0.5); }
+};
+
+TEST(TH1ConcurrentFill, TH1)
+{
+   TH1D hd("hd", "hd", 20, 0., 100.);
+   CheckAllModes(hd, Fill1DWeighted());
+   TH1F hf("hf", "hf", 20, 0., 100.);
+   CheckAllModes(hf, Fill1D());
+}
+
+TEST(TH1ConcurrentFill, TH2TH3)
+{
+   TH2D h2("h2", "h2", 10, 0., 100., 5, 0., 10.);
+   CheckAllModes(h2, Fill2D());
+   TH3D h3("h3", "h3", 10, 0., 100., 5, 0., 10., 3, 0., 3.);
+   CheckAllModes(h3, Fill3D());
+}
+
+TEST(TH1ConcurrentFill, TProfile)
+{
+   TProfile p("p", "p", 10, 0., 100.);
+   {
+      ROOT::TH1ConcurrentFillManager<TProfile> manager(p, ROOT::EH1ConcurrentFillMode::kAtomic);
+      EXPECT_EQ(ROOT::EH1ConcurrentFillMode::kBuffered, manager.GetMode());
+   }
+   // The profile is filled with (x, y) pairs.
+   CheckAllModes(p, Fill2D());
+}
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+
+#include "TBufferFile.h"
+#include "TH2D.h"
+#include "TH2F.h"
+#include "TH3D.h"
+#include "TList.h"
+#include "TNamed.h"
+
+#include <memory>
+
+// Write the histogram into a TBufferFile, read it back and return the copy;
+// the size of the streamed histogram is returned in length.
+template <typename HIST>
+static std::unique_ptr<HIST> RoundTrip(HIST &h, Int_t &length)
+{
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteObject(&h);
+   length = buf.Length();
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   std::unique_ptr<HIST> copy(static_cast<HIST *>(buf.ReadObject(HIST::Class())));
+   if (copy)
+      copy->SetDirectory(nullptr);
+   return copy;
+}
+
+static void ExpectSameCells(const TH1 &expected, const TH1 &actual)
+{
+   ASSERT_EQ(expected.GetNcells(), actual.GetNcells());
+   EXPECT_EQ(expected.GetSumw2N(), actual.GetSumw2N());
+   for (Int_t bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_EQ(expected.GetBinContent(bin), actual.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(expected.GetBinError(bin), actual.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_EQ(expected.GetEntries(), actual.GetEntries());
+}
+
+// A mostly empty histogram is written with only its non-empty cells and read
+// back identical to the original.
+TEST(TH1SparseStreaming, MostlyEmpty)
+{
+   TH2D h("h", "", 200, 0., 1., 100, 0., 1.);
+   h.SetDirectory(nullptr);
+   h.Sumw2();
+   for (int i = 0; i < 300; ++i)
+      h.Fill(0.003 * i, 0.5, 0.5 + i % 3);
+   h.Fill(2., 2.); // overflow
+
+   Int_t denseLength = 0;
+   auto dense = RoundTrip(h, denseLength);
+   ASSERT_TRUE(dense);
+   ExpectSameCells(h, *dense);
+
+   h.SetSparseStreaming();
+   Int_t sparseLength = 0;
+   auto sparse = RoundTrip(h, sparseLength);
+   ASSERT_TRUE(sparse);
+   ExpectSameCells(h, *sparse);
+   EXPECT_LT(sparseLength * 10, denseLength);
+   EXPECT_TRUE(sparse->TestBit(TH1::kSparseStreaming));
+
+   // The histogram is left untouched by the writing.
+   EXPECT_EQ(h.GetNcells(), h.GetSize());
+   EXPECT_EQ(h.GetNcells(), h.GetSumw2N());
+   EXPECT_EQ(0.5, h.GetBinContent(h.FindBin(0., 0.5)));
+}
+
+// Histograms without errors, empty ones and 3-D ones.
+TEST(TH1SparseStreaming, Variants)
+{
+   TH1::SetDefaultSparseStreaming();
+
+   TH2F unweighted("unweighted", "", 50, 0., 1., 50, 0., 1.);
+   unweighted.SetDirectory(nullptr);
+   unweighted.Fill(0.1, 0.2);
+   unweighted.Fill(0.1, 0.2);
+   unweighted.Fill(-1., 0.5);
+   Int_t length = 0;
+   auto unweightedCopy = RoundTrip(unweighted, length);
+   ASSERT_TRUE(unweightedCopy);
+   ExpectSameCells(unweighted, *unweightedCopy);
+   EXPECT_EQ(0, unweightedCopy->GetSumw2N());
+
+   TH3D empty("empty", "", 20, 0., 1., 20, 0., 1., 20, 0., 1.);
+   empty.SetDirectory(nullptr);
+   empty.Sumw2();
+   auto emptyCopy = RoundTrip(empty, length);
+   ASSERT_TRUE(emptyCopy);
+   ExpectSameCells(empty, *emptyCopy);
+
+   // Too many non-empty cells: the dense form is written.
+   TH2D full("full", "", 10, 0., 1., 10, 0., 1.);
+   full.SetDirectory(nullptr);
+   for (int bin = 0; bin < full.GetNcells(); ++bin)
+      full.SetBinContent(bin, bin + 1);
+   auto fullCopy = RoundTrip(full, length);
+   ASSERT_TRUE(fullCopy);
+   ExpectSameCells(full, *fullCopy);
+
+   TH1::SetDefaultSparseStreaming(kFALSE);
+}
+
+// The sparse record has a class version that older releases do not know, so
+// that they skip the histogram instead of reading an empty one.
+TEST(TH1SparseStreaming, RecordVersion)
+{
+   TH2D h("h", "", 100, 0., 1., 100, 0., 1.);
+   h.SetDirectory(nullptr);
+   h.Fill(0.5, 0.5);
+
+   TBufferFile buf(TBuffer::kWrite);
+   h.Streamer(buf);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   UInt_t start = 0, count = 0;
+   EXPECT_EQ(TH2D::Class()->GetClassVersion(), buf.ReadVersion(&start, &count));
+
+   h.SetSparseStreaming();
+   TBufferFile sparseBuf(TBuffer::kWrite);
+   h.Streamer(sparseBuf);
+   sparseBuf.SetReadMode();
+   sparseBuf.SetBufferOffset(0);
+   EXPECT_EQ(TH1::kSparseStreamerVersion, sparseBuf.ReadVersion(&start, &count));
+}
+
+// The labels of the axes and the functions are written with the histogram.
+TEST(TH1SparseStreaming, LabelsAndFunctions)
+{
+   TH2D h("h", "", 100, 0., 1., 10, 0., 10.);
+   h.SetDirectory(nullptr);
+   h.SetSparseStreaming();
+   h.Fill(0.5, 0.5);
+   h.GetYaxis()->SetBinLabel(1, "first");
+   h.GetYaxis()->ChangeLabel(2, -1, -1, -1, -1, -1, "second");
+   h.GetListOfFunctions()->Add(new TNamed("note", "a note"));
+
+   Int_t length = 0;
+   auto copy = RoundTrip(h, length);
+   ASSERT_TRUE(copy);
+   ExpectSameCells(h, *copy);
+   EXPECT_STREQ("first", copy->GetYaxis()->GetBinLabel(1));
+   ASSERT_TRUE(copy->GetYaxis()->GetModifiedLabels());
+   EXPECT_EQ(1, copy->GetYaxis()->GetModifiedLabels()->GetSize());
+   ASSERT_EQ(1, copy->GetListOfFunctions()->GetSize());
+   EXPECT_STREQ("a note", copy->GetListOfFunctions()->First()->GetTitle());
+
+   // The histogram keeps its own labels and functions.
+   EXPECT_STREQ("first", h.GetYaxis()->GetBinLabel(1));
+   EXPECT_EQ(1, h.GetListOfFunctions()->GetSize());
+}
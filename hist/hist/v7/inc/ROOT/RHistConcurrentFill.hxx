@@ -17,6 +17,7 @@
 #define ROOT7_RHistConcurrentFill
 
 #include "ROOT/RSpan.hxx"
+#include "ROOT/RAxis.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
 
 #include <mutex>
@@ -73,6 +74,12 @@ public:
  buffer calls to Fill() until the buffer is full, and then swap the buffer
  with that of the RHistConcurrentFillManager. The manager than fills the
  histogram.
+
+ The buffers are flushed into the histogram under a lock, unless the
+ histogram's statistics can be filled concurrently (all its STAT template
+ arguments are "Concurrent" ones, such as RHistStatContentConcurrent and
+ RHistStatUncertaintyConcurrent) and none of its axes can grow: then the
+ fillers flush their buffers concurrently, without locking.
  **/
 
 template <class HIST, int SIZE = 1024>
@@ -87,15 +94,33 @@ public:
 private:
    HIST &fHist;
    std::mutex fFillMutex; // should become a spin lock
+   bool fLockFree = false; ///< Whether FillN() can be called without taking fFillMutex.
+
+   /// Whether any axis of the histogram can grow; growing is not thread-safe.
+   bool CanAnyAxisGrow() const
+   {
+      for (int iAxis = 0; iAxis < HIST::GetNDim(); ++iAxis) {
+         const RAxisEquidistant *equi = fHist.GetImpl()->GetAxis(iAxis).GetAsEquidistant();
+         if (equi && equi->GetNOverflowBins() == 0)
+            return true;
+      }
+      return false;
+   }
 
 public:
-   RHistConcurrentFillManager(HIST &hist): fHist(hist) {}
+   RHistConcurrentFillManager(HIST &hist)
+      : fHist(hist), fLockFree(HIST::ImplBase_t::Stat_t::CanFillConcurrently() && !CanAnyAxisGrow())
+   {}
 
    RHistConcurrentFiller<HIST, SIZE> MakeFiller() { return RHistConcurrentFiller<HIST, SIZE>{*this}; }
 
    /// Thread-specific HIST::FillN().
    void FillN(const std::span<CoordArray_t> xN, const std::span<Weight_t> weightN)
    {
+      if (fLockFree) {
+         fHist.FillN(xN, weightN);
+         return;
+      }
       std::lock_guard<std::mutex> lockGuard(fFillMutex);
       fHist.FillN(xN, weightN);
    }
@@ -103,9 +128,16 @@ public:
    /// Thread-specific HIST::FillN().
    void FillN(const std::span<CoordArray_t> xN)
    {
+      if (fLockFree) {
+         fHist.FillN(xN);
+         return;
+      }
       std::lock_guard<std::mutex> lockGuard(fFillMutex);
       fHist.FillN(xN);
    }
+
+   /// Whether the fillers flush into the histogram concurrently, without locking.
+   bool IsLockFree() const { return fLockFree; }
 };
 
 } // namespace Experimental
@@ -16,7 +16,10 @@
 #ifndef ROOT7_RHistData_h
 #define ROOT7_RHistData_h
 
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <type_traits>
 #include <vector>
 #include "ROOT/RSpan.hxx"
 #include "ROOT/RHistUtils.hxx"
@@ -345,6 +348,369 @@ public:
    void Fill(const CoordArray_t &x, int binidx, Weight_t weight = 1.) { DoFill(x, binidx, weight); }
 };
 
+namespace Internal {
+
+/// Atomically add `value` to `target`.
+template <class T>
+void AtomicAdd(std::atomic<T> &target, T value) noexcept
+{
+   T oldval = target.load(std::memory_order_relaxed);
+   while (!target.compare_exchange_weak(oldval, oldval + value, std::memory_order_relaxed)) {
+      // oldval is changed to what target holds at the call to compare_exchange_weak
+   }
+}
+
+/**
+ \class RAtomicArray
+ A fixed-size array of atomic values, copyable (non-atomically) unlike
+ std::vector<std::atomic<T>>. Used as bin storage of statistics that can be
+ filled concurrently.
+ */
+template <class T>
+class RAtomicArray {
+private:
+   /// The values.
+   std::vector<std::atomic<T>> fValues;
+
+public:
+   RAtomicArray() = default;
+   RAtomicArray(size_t size): fValues(size) {}
+   RAtomicArray(const RAtomicArray &other): fValues(other.size()) { *this = other; }
+   RAtomicArray &operator=(const RAtomicArray &other)
+   {
+      if (fValues.size() != other.size())
+         std::vector<std::atomic<T>>(other.size()).swap(fValues);
+      for (size_t i = 0, n = other.size(); i < n; ++i)
+         fValues[i].store(other[i], std::memory_order_relaxed);
+      return *this;
+   }
+
+   /// Get the number of values.
+   size_t size() const noexcept { return fValues.size(); }
+
+   /// Get the value at idx.
+   T operator[](int idx) const noexcept { return fValues[idx].load(std::memory_order_relaxed); }
+
+   /// Access the atomic value at idx.
+   std::atomic<T> &At(int idx) noexcept { return fValues[idx]; }
+
+   /// Atomically add `value` to the value at idx.
+   void Add(int idx, T value) noexcept { AtomicAdd(fValues[idx], value); }
+};
+
+/// A small number identifying the calling thread, assigned on first use.
+inline unsigned GetThreadSlot() noexcept
+{
+   static std::atomic<unsigned> sNextSlot{0};
+   static thread_local unsigned sSlot = sNextSlot++;
+   return sSlot;
+}
+
+/**
+ \class RPerThreadSum
+ A sum that several threads can add to concurrently. Each thread adds to its
+ own slot (modulo the number of slots), each slot sitting on its own cache
+ line, so that concurrent additions from different threads rarely contend.
+ */
+template <class T>
+class RPerThreadSum {
+private:
+   static constexpr int kNSlots = 16;
+   static constexpr int kCacheLineSize = 64;
+
+   struct RSlot {
+      std::atomic<T> fValue{T()};
+      char fPadding[kCacheLineSize - sizeof(std::atomic<T>)]; ///< Keep slots on separate cache lines.
+   };
+
+   /// The per-thread partial sums.
+   std::array<RSlot, kNSlots> fSlots;
+
+public:
+   RPerThreadSum() = default;
+   RPerThreadSum(const RPerThreadSum &other) { *this = other; }
+   RPerThreadSum &operator=(const RPerThreadSum &other)
+   {
+      for (int i = 0; i < kNSlots; ++i)
+         fSlots[i].fValue.store(other.fSlots[i].fValue.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return *this;
+   }
+
+   /// Add `value` to the calling thread's slot.
+   void Add(T value) noexcept { AtomicAdd(fSlots[GetThreadSlot() % kNSlots].fValue, value); }
+
+   /// Get the sum over all slots.
+   T Get() const noexcept
+   {
+      T sum = T();
+      for (auto &slot: fSlots)
+         sum += slot.fValue.load(std::memory_order_relaxed);
+      return sum;
+   }
+};
+
+/// Whether `STAT::Fill()` can be called concurrently from several threads,
+/// which STAT announces by declaring `static constexpr bool kConcurrentFill = true`.
+template <class STAT, class = void>
+struct RHistStatCanFillConcurrently: std::false_type {
+};
+
+template <class STAT>
+struct RHistStatCanFillConcurrently<STAT, typename std::enable_if<STAT::kConcurrentFill>::type>: std::true_type {
+};
+
+} // namespace Internal
+
+/**
+ \class RHistStatContentConcurrent
+ Like RHistStatContent, but Fill() can be called concurrently from several
+ threads: the bins are atomic and the number of entries is accumulated per
+ thread. Reading the histogram while it is being filled gives a consistent
+ value per bin, but not across bins.
+ */
+template <int DIMENSIONS, class PRECISION>
+class RHistStatContentConcurrent {
+public:
+   /// The type of a (possibly multi-dimensional) coordinate.
+   using CoordArray_t = Hist::CoordArray_t<DIMENSIONS>;
+   /// The type of the weight and the bin content.
+   using Weight_t = PRECISION;
+   /// Type of the bin content array.
+   using Content_t = Internal::RAtomicArray<PRECISION>;
+
+   /// Fill() can be called concurrently.
+   static constexpr bool kConcurrentFill = true;
+
+   /**
+    \class RConstBinStat
+    Const view on a RHistStatContentConcurrent for a given bin.
+   */
+   class RConstBinStat {
+   public:
+      RConstBinStat(const RHistStatContentConcurrent &stat, int index): fContent(stat.GetBinContent(index)) {}
+      PRECISION GetContent() const { return fContent; }
+
+   private:
+      PRECISION fContent; ///< The content of this bin.
+   };
+
+   /**
+    \class RBinStat
+    Modifying view on a RHistStatContentConcurrent for a given bin.
+   */
+   class RBinStat {
+   public:
+      RBinStat(RHistStatContentConcurrent &stat, int index): fContent(stat.GetContentArray().At(index)) {}
+      std::atomic<PRECISION> &GetContent() const { return fContent; }
+
+   private:
+      std::atomic<PRECISION> &fContent; ///< The content of this bin.
+   };
+
+   using ConstBinStat_t = RConstBinStat;
+   using BinStat_t = RBinStat;
+
+private:
+   /// Number of calls to Fill().
+   Internal::RPerThreadSum<int64_t> fEntries;
+
+   /// Bin content.
+   Content_t fBinContent;
+
+public:
+   RHistStatContentConcurrent() = default;
+   RHistStatContentConcurrent(size_t in_size): fBinContent(in_size) {}
+
+   /// Atomically add weight to the bin content at binidx.
+   void Fill(const CoordArray_t & /*x*/, int binidx, Weight_t weight = 1.)
+   {
+      fBinContent.Add(binidx, weight);
+      fEntries.Add(1);
+   }
+
+   /// Get the number of entries filled into the histogram - i.e. the number of
+   /// calls to Fill().
+   int64_t GetEntries() const { return fEntries.Get(); }
+
+   /// Get the number of bins.
+   size_t size() const noexcept { return fBinContent.size(); }
+
+   /// Get the bin content for the given bin.
+   Weight_t operator[](int idx) const { return fBinContent[idx]; }
+
+   /// Get the bin content for the given bin.
+   Weight_t GetBinContent(int idx) const { return fBinContent[idx]; }
+
+   /// Retrieve the content array.
+   const Content_t &GetContentArray() const { return fBinContent; }
+   /// Retrieve the content array (non-const).
+   Content_t &GetContentArray() { return fBinContent; }
+};
+
+/**
+ \class RHistStatUncertaintyConcurrent
+ Like RHistStatUncertainty, but Fill() can be called concurrently from several
+ threads: the sums of squared weights of the bins are atomic.
+ */
+template <int DIMENSIONS, class PRECISION>
+class RHistStatUncertaintyConcurrent {
+public:
+   /// The type of a (possibly multi-dimensional) coordinate.
+   using CoordArray_t = Hist::CoordArray_t<DIMENSIONS>;
+   /// The type of the weight and the bin content.
+   using Weight_t = PRECISION;
+   /// Type of the bin content array.
+   using Content_t = Internal::RAtomicArray<PRECISION>;
+
+   /// Fill() can be called concurrently.
+   static constexpr bool kConcurrentFill = true;
+
+   /**
+    \class RConstBinStat
+    Const view on a RHistStatUncertaintyConcurrent for a given bin.
+   */
+   class RConstBinStat {
+   public:
+      RConstBinStat(const RHistStatUncertaintyConcurrent &stat, int index): fSumW2(stat.GetSumOfSquaredWeights(index)) {}
+      PRECISION GetSumW2() const { return fSumW2; }
+
+      double GetUncertaintyImpl() const { return std::sqrt(std::abs(fSumW2)); }
+
+   private:
+      PRECISION fSumW2; ///< The bin's sum of square of weights.
+   };
+
+   /**
+    \class RBinStat
+    Modifying view on a RHistStatUncertaintyConcurrent for a given bin.
+   */
+   class RBinStat {
+   public:
+      RBinStat(RHistStatUncertaintyConcurrent &stat, int index): fSumW2(stat.GetSumOfSquaredWeights().At(index)) {}
+      std::atomic<PRECISION> &GetSumW2() const { return fSumW2; }
+      // Can never modify this. Set GetSumW2() instead.
+      double GetUncertaintyImpl() const { return std::sqrt(std::abs(fSumW2.load(std::memory_order_relaxed))); }
+
+   private:
+      std::atomic<PRECISION> &fSumW2; ///< The bin's sum of square of weights.
+   };
+
+   using ConstBinStat_t = RConstBinStat;
+   using BinStat_t = RBinStat;
+
+private:
+   /// Sum of squared weights for each bin.
+   Content_t fSumWeightsSquared;
+
+public:
+   RHistStatUncertaintyConcurrent() = default;
+   RHistStatUncertaintyConcurrent(size_t size): fSumWeightsSquared(size) {}
+
+   /// Atomically add weight to the bin at binidx; the coordinate was x.
+   void Fill(const CoordArray_t & /*x*/, int binidx, Weight_t weight = 1.)
+   {
+      fSumWeightsSquared.Add(binidx, weight * weight);
+   }
+
+   /// Calculate a bin's (Poisson) uncertainty of the bin content as the
+   /// square-root of the bin's sum of squared weights.
+   double GetBinUncertaintyImpl(int binidx) const { return std::sqrt(fSumWeightsSquared[binidx]); }
+
+   /// Get a bin's sum of squared weights.
+   Weight_t GetSumOfSquaredWeights(int binidx) const { return fSumWeightsSquared[binidx]; }
+
+   /// Get the structure holding the sum of squares of weights.
+   const Content_t &GetSumOfSquaredWeights() const { return fSumWeightsSquared; }
+   /// Get the structure holding the sum of squares of weights (non-const).
+   Content_t &GetSumOfSquaredWeights() { return fSumWeightsSquared; }
+};
+
+/**
+ \class RHistStatTotalSumOfWeightsConcurrent
+ Like RHistStatTotalSumOfWeights, but Fill() can be called concurrently from
+ several threads; the sum is accumulated per thread.
+ */
+template <int DIMENSIONS, class PRECISION>
+class RHistStatTotalSumOfWeightsConcurrent {
+public:
+   /// The type of a (possibly multi-dimensional) coordinate.
+   using CoordArray_t = Hist::CoordArray_t<DIMENSIONS>;
+   /// The type of the weight and the bin content.
+   using Weight_t = PRECISION;
+
+   /// Fill() can be called concurrently.
+   static constexpr bool kConcurrentFill = true;
+
+   /**
+    \class RBinStat
+    No-op; this class does not provide per-bin statistics.
+   */
+   class RBinStat {
+   public:
+      RBinStat(const RHistStatTotalSumOfWeightsConcurrent &, int) {}
+   };
+
+   using ConstBinStat_t = RBinStat;
+   using BinStat_t = RBinStat;
+
+private:
+   /// Sum of weights.
+   Internal::RPerThreadSum<PRECISION> fSumWeights;
+
+public:
+   RHistStatTotalSumOfWeightsConcurrent() = default;
+   RHistStatTotalSumOfWeightsConcurrent(size_t) {}
+
+   /// Add weight to the sum of weights.
+   void Fill(const CoordArray_t & /*x*/, int, Weight_t weight = 1.) { fSumWeights.Add(weight); }
+
+   /// Get the sum of weights.
+   Weight_t GetSumOfWeights() const { return fSumWeights.Get(); }
+};
+
+/**
+ \class RHistStatTotalSumOfSquaredWeightsConcurrent
+ Like RHistStatTotalSumOfSquaredWeights, but Fill() can be called concurrently
+ from several threads; the sum is accumulated per thread.
+ */
+template <int DIMENSIONS, class PRECISION>
+class RHistStatTotalSumOfSquaredWeightsConcurrent {
+public:
+   /// The type of a (possibly multi-dimensional) coordinate.
+   using CoordArray_t = Hist::CoordArray_t<DIMENSIONS>;
+   /// The type of the weight and the bin content.
+   using Weight_t = PRECISION;
+
+   /// Fill() can be called concurrently.
+   static constexpr bool kConcurrentFill = true;
+
+   /**
+    \class RBinStat
+    No-op; this class does not provide per-bin statistics.
+   */
+   class RBinStat {
+   public:
+      RBinStat(const RHistStatTotalSumOfSquaredWeightsConcurrent &, int) {}
+   };
+
+   using ConstBinStat_t = RBinStat;
+   using BinStat_t = RBinStat;
+
+private:
+   /// Sum of (weights^2).
+   Internal::RPerThreadSum<PRECISION> fSumWeights2;
+
+public:
+   RHistStatTotalSumOfSquaredWeightsConcurrent() = default;
+   RHistStatTotalSumOfSquaredWeightsConcurrent(size_t) {}
+
+   /// Add the squared weight to the sum of squared weights.
+   void Fill(const CoordArray_t & /*x*/, int /*binidx*/, Weight_t weight = 1.) { fSumWeights2.Add(weight * weight); }
+
+   /// Get the sum of squared weights.
+   Weight_t GetSumOfSquaredWeights() const { return fSumWeights2.Get(); }
+};
+
 namespace Detail {
 
 /** \class RHistBinStat
@@ -458,6 +824,17 @@ public:
       return sizeof(HaveUncertainty<AllYourBaseAreBelongToUs>(nullptr)) == sizeof(double);
    }
 
+   /// Whether Fill() can be called concurrently from several threads, i.e.
+   /// whether all STATs support that (see e.g. RHistStatContentConcurrent).
+   static constexpr bool CanFillConcurrently()
+   {
+      const bool canFill[] = {true, Internal::RHistStatCanFillConcurrently<STAT<DIMENSIONS, PRECISION>>::value...};
+      for (bool statCanFill: canFill)
+         if (!statCanFill)
+            return false;
+      return true;
+   }
+
    /// Calculate the bin content's uncertainty for the given bin, using base class information,
    /// i.e. forwarding to a base's `GetBinUncertaintyImpl(binidx)`.
    template <bool B = true, class = typename std::enable_if<B && HasBinUncertainty()>::type>
@@ -0,0 +1,105 @@
+/// \file histconcurrentspeedtest.cxx
+///
+/// Compare the speed of filling a histogram from several threads through a
+/// RHistConcurrentFillManager, with the default statistics (flushes under a
+/// lock) and with the concurrent statistics (lock-free flushes).
+///
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+#include "TRandom3.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "ROOT/RHist.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
+
+using namespace ROOT;
+
+using RH2DLocked_t = Experimental::RHist<2, double, Experimental::RHistStatContent, Experimental::RHistStatUncertainty>;
+using RH2DConcurrent_t =
+   Experimental::RHist<2, double, Experimental::RHistStatContentConcurrent,
+                       Experimental::RHistStatUncertaintyConcurrent>;
+
+struct Timer {
+   using TimePoint_t = decltype(std::chrono::high_resolution_clock::now());
+
+   std::string fTitle;
+   size_t fCount;
+   TimePoint_t fStart;
+
+   Timer(const std::string &title, size_t count)
+      : fTitle(title), fCount(count), fStart(std::chrono::high_resolution_clock::now())
+   {}
+
+   ~Timer()
+   {
+      using namespace std::chrono;
+      auto end = high_resolution_clock::now();
+      duration<double> time_span = duration_cast<duration<double>>(end - fStart);
+      std::cout << fCount << " * " << fTitle << ": " << time_span.count() << " seconds, \t";
+      std::cout << fCount / (1e6) / time_span.count() << " millions per seconds \n";
+   }
+};
+
+/// Fill `hist` with `input` from `nThreads` threads, each filling a contiguous
+/// chunk of the input through its own RHistConcurrentFiller.
+template <class HIST>
+void FillConcurrently(HIST &hist, const std::vector<double> &input, unsigned nThreads, const char *title)
+{
+   using Manager_t = Experimental::RHistConcurrentFillManager<HIST>;
+   Manager_t manager(hist);
+
+   const size_t nPoints = input.size() / 2;
+   const size_t chunk = (nPoints + nThreads - 1) / nThreads;
+   Timer t(std::string(title) + (manager.IsLockFree() ? " lock-free, " : " locked, ") + std::to_string(nThreads) +
+              " threads",
+           nPoints);
+
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&manager, &input, chunk, nPoints, i]() {
+         auto filler = manager.MakeFiller();
+         const size_t end = std::min(nPoints, (i + 1) * chunk);
+         for (size_t j = i * chunk; j < end; ++j)
+            filler.Fill({input[2 * j], input[2 * j + 1]});
+      });
+   }
+   for (auto &thread: threads)
+      thread.join();
+}
+
+void histconcurrentspeedtest(size_t iter, unsigned maxThreads)
+{
+   std::vector<double> input(2 * iter);
+   TRandom3 r(42);
+   for (auto &x: input)
+      x = r.Rndm();
+
+   for (unsigned nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+      {
+         RH2DLocked_t hist({100, 0., 1.}, {100, 0., 1.});
+         FillConcurrently(hist, input, nThreads, "RH2D");
+      }
+      {
+         RH2DConcurrent_t hist({100, 0., 1.}, {100, 0., 1.});
+         FillConcurrently(hist, input, nThreads, "RH2D concurrent stat");
+      }
+   }
+}
+
+int main(int argc, char **argv)
+{
+   size_t iter = 1e7;
+   unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+   if (argc > 1)
+      iter = atof(argv[1]);
+   if (argc > 2)
+      maxThreads = atoi(argv[2]);
+
+   histconcurrentspeedtest(iter, maxThreads);
+}
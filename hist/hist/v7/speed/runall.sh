@@ -26,3 +26,7 @@ run "THistStatContent,THistStatUncertainty,THistStatTotalSumOfWeights,THistStatT
 
 echo 'Not running with THistDataRuntime'
 # run THistDataRuntime
+
+echo "Concurrent filling"
+${CXX} -o concurrentspeedtest histconcurrentspeedtest.cxx `root-config --cflags --libs` -O3
+./concurrentspeedtest 1e7 | tee concurrent.1e7.$$.speedlog
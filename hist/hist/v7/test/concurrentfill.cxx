@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RHist.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
+
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+template <int DIM, class PRECISION>
+using RHistConcurrent_t = RHist<DIM, PRECISION, RHistStatContentConcurrent, RHistStatUncertaintyConcurrent,
+                                RHistStatTotalSumOfWeightsConcurrent, RHistStatTotalSumOfSquaredWeightsConcurrent>;
+
+// Fill `hist` from several threads through a RHistConcurrentFillManager.
+template <class HIST>
+void FillConcurrently(HIST &hist, int nThreads, int nFillsPerThread)
+{
+   RHistConcurrentFillManager<HIST, 64> manager(hist);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&manager, nFillsPerThread, t]() {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < nFillsPerThread; ++i)
+            filler.Fill({(t * nFillsPerThread + i) % 100 / 100. + 0.005}, 0.5);
+      });
+   }
+   for (auto &thread: threads)
+      thread.join();
+}
+
+// Only histograms with concurrent statistics and without growing axes are
+// filled lock-free.
+TEST(HistConcurrentFillTest, LockFree)
+{
+   using HistConcurrent_t = RHistConcurrent_t<1, double>;
+
+   RH1D hist({100, 0., 1.});
+   EXPECT_FALSE(RHistConcurrentFillManager<RH1D>(hist).IsLockFree());
+
+   HistConcurrent_t histConcurrent({100, 0., 1.});
+   EXPECT_TRUE(RHistConcurrentFillManager<HistConcurrent_t>(histConcurrent).IsLockFree());
+
+   HistConcurrent_t histGrow({RAxisConfig::Grow, 100, 0., 1.});
+   EXPECT_FALSE(RHistConcurrentFillManager<HistConcurrent_t>(histGrow).IsLockFree());
+}
+
+// Concurrent statistics give the same result as the locked, sequential flushes.
+TEST(HistConcurrentFillTest, Fill)
+{
+   const int nThreads = 8;
+   const int nFillsPerThread = 10000;
+
+   RH1D hist({100, 0., 1.});
+   FillConcurrently(hist, nThreads, nFillsPerThread);
+   RHistConcurrent_t<1, double> histConcurrent({100, 0., 1.});
+   FillConcurrently(histConcurrent, nThreads, nFillsPerThread);
+
+   EXPECT_EQ(nThreads * nFillsPerThread, hist.GetEntries());
+   EXPECT_EQ(nThreads * nFillsPerThread, histConcurrent.GetEntries());
+   for (int bin = 0; bin < 100; ++bin) {
+      const double x = bin / 100. + 0.005;
+      EXPECT_DOUBLE_EQ(hist.GetBinContent({x}), histConcurrent.GetBinContent({x}));
+      EXPECT_DOUBLE_EQ(hist.GetBinUncertainty({x}), histConcurrent.GetBinUncertainty({x}));
+   }
+   // RHistStatUncertaintyConcurrent also has a GetSumOfSquaredWeights().
+   using SumW2_t = RHistStatTotalSumOfSquaredWeightsConcurrent<1, double>;
+   const auto &stat = histConcurrent.GetImpl()->GetStat();
+   EXPECT_DOUBLE_EQ(0.5 * nThreads * nFillsPerThread, stat.GetSumOfWeights());
+   EXPECT_DOUBLE_EQ(0.25 * nThreads * nFillsPerThread, stat.SumW2_t::GetSumOfSquaredWeights());
+}
+
+// A copy of a concurrently filled histogram holds the same statistics.
+TEST(HistConcurrentFillTest, Copy)
+{
+   const int nThreads = 4;
+   const int nFillsPerThread = 1000;
+
+   RHistConcurrent_t<1, double> histConcurrent({100, 0., 1.});
+   FillConcurrently(histConcurrent, nThreads, nFillsPerThread);
+   const auto &stat = histConcurrent.GetImpl()->GetStat();
+   auto copy = stat;
+
+   EXPECT_EQ(nThreads * nFillsPerThread, copy.GetEntries());
+   EXPECT_EQ(stat.size(), copy.size());
+   for (int bin = 0; bin < (int)stat.size(); ++bin) {
+      EXPECT_DOUBLE_EQ(stat.GetBinContent(bin), copy.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(stat.GetBinUncertainty(bin), copy.GetBinUncertainty(bin));
+   }
+}
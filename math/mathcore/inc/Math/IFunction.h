@@ -360,6 +360,26 @@ namespace ROOT {
             Gradient(x, df);
          }
 
+         /**
+            Return true if the gradient is calculated numerically and the implementation also provides
+            the second derivatives and the step sizes of the calculation (see G2ndDerivative and GStepSize).
+            Minimizers calculating their own numerical derivatives, like Minuit2, can then use them as
+            the starting point of their calculations.
+         */
+         virtual bool HasG2ndDerivative() const { return false; }
+
+         /**
+            Evaluate the diagonal second derivatives of the function at a point x, as estimated in
+            the numerical calculation of the gradient. Only meaningful if HasG2ndDerivative() is true.
+         */
+         virtual void G2ndDerivative(const T * /* x */, T * /* g2 */) const {}
+
+         /**
+            Evaluate the step sizes used in the numerical calculation of the gradient at a point x.
+            Only meaningful if HasG2ndDerivative() is true.
+         */
+         virtual void GStepSize(const T * /* x */, T * /* gstep */) const {}
+
 
       };
 
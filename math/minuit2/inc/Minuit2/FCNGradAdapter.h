@@ -71,6 +71,20 @@ public:
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
    bool CheckGradient() const { return false; }
 
+   bool HasG2ndDerivative() const { return fFunc.HasG2ndDerivative(); }
+
+   std::vector<double> G2ndDerivative(const std::vector<double>& v) const {
+      std::vector<double> g2(fFunc.NDim());
+      fFunc.G2ndDerivative(&v[0], &g2[0]);
+      return g2;
+   }
+
+   std::vector<double> GStepSize(const std::vector<double>& v) const {
+      std::vector<double> gstep(fFunc.NDim());
+      fFunc.GStepSize(&v[0], &gstep[0]);
+      return gstep;
+   }
+
 private:
    const Function & fFunc;
    double fUp;
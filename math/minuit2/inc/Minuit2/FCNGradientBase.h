@@ -39,6 +39,15 @@ public:
 
    virtual bool CheckGradient() const {return true;}
 
+   /// Return true if the Gradient is calculated numerically and G2ndDerivative and GStepSize
+   /// provide the second derivatives and the step sizes of the calculation, which are then used
+   /// in place of the ones of the internal numerical Gradient.
+   virtual bool HasG2ndDerivative() const {return false;}
+
+   virtual std::vector<double> G2ndDerivative(const std::vector<double>&) const {return std::vector<double>();}
+
+   virtual std::vector<double> GStepSize(const std::vector<double>&) const {return std::vector<double>();}
+
 };
 
   }  // namespace Minuit2
@@ -15,6 +15,8 @@
 #include "Minuit2/MnMatrix.h"
 #include "Minuit2/MnPrint.h"
 
+#include <cmath>
+
 namespace ROOT {
    namespace Minuit2 {
 
@@ -42,6 +44,32 @@ FunctionGradient AnalyticalGradientCalculator::operator()(const MinimumParameter
    std::cout << "User given gradient in Minuit2" << v << std::endl;
 #endif   
 
+   if (fGradCalc.HasG2ndDerivative()) {
+      // numerical gradient calculated by the user: take also its second derivatives
+      // and step sizes, transformed to the internal parameters
+      std::vector<double> g2 = fGradCalc.G2ndDerivative(fTransformation(par.Vec()));
+      std::vector<double> gstep = fGradCalc.GStepSize(fTransformation(par.Vec()));
+      assert(g2.size() == grad.size() && gstep.size() == grad.size());
+
+      MnAlgebraicVector v2(par.Vec().size());
+      MnAlgebraicVector vstep(par.Vec().size());
+      for(unsigned int i = 0; i < par.Vec().size(); i++) {
+         unsigned int ext = fTransformation.ExtOfInt(i);
+         double dd = 1.;
+         if(fTransformation.Parameter(ext).HasLimits()) {
+            dd = fTransformation.DInt2Ext(i, par.Vec()(i));
+         }
+         if (dd != 0.) {
+            v2(i) = dd*dd*g2[ext];
+            vstep(i) = fabs(gstep[ext]/dd);
+         } else {
+            v2(i) = g2[ext];
+            vstep(i) = gstep[ext];
+         }
+      }
+      return FunctionGradient(v, v2, vstep);
+   }
+
    return FunctionGradient(v);
 }
 
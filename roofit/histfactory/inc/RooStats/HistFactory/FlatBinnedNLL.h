@@ -0,0 +1,103 @@
+// @(#)root/roostats:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef HISTFACTORY_FLATBINNEDNLL
+#define HISTFACTORY_FLATBINNEDNLL
+
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+
+#include <string>
+#include <vector>
+
+class RooAbsBinning;
+class RooAbsData;
+class RooSimultaneous;
+
+namespace RooStats{
+  namespace HistFactory{
+
+class FlatBinnedNLL : public RooAbsReal {
+public:
+
+  FlatBinnedNLL() ;
+  FlatBinnedNLL(const char *name, const char *title, RooSimultaneous& pdf, RooAbsData& data,
+                const RooArgSet& constraints, const RooArgSet& constraintNormSet) ;
+  FlatBinnedNLL(const FlatBinnedNLL& other, const char* name=0) ;
+  virtual TObject* clone(const char* newname) const { return new FlatBinnedNLL(*this,newname); }
+  virtual ~FlatBinnedNLL() ;
+
+  virtual Bool_t setData(RooAbsData& data, Bool_t cloneData=kTRUE) ;
+
+  virtual void enableOffsetting(Bool_t flag) ;
+  virtual Bool_t isOffsetting() const { return _doOffset ; }
+  virtual Double_t offset() const { return _offset ; }
+
+  Int_t numChannels() const { return _channels.size() ; }
+  Int_t numBins() const ;
+
+  // Per-bin shape factor interpolated between a nominal and low/high
+  // variations (a flattened PiecewiseInterpolation)
+  struct Interpolation {
+    std::vector<Int_t> params ;       // Indices of the interpolation parameters in _nodes
+    std::vector<Int_t> codes ;        // Interpolation code of each parameter
+    std::vector<Double_t> nominal ;   // Nominal value per bin
+    std::vector<Double_t> low ;       // Low variation per parameter and bin (param-major)
+    std::vector<Double_t> high ;      // High variation per parameter and bin (param-major)
+    Bool_t positiveDefinite ;
+  } ;
+
+  // Expected yield density of one sample in one channel
+  struct Sample {
+    std::string name ;
+    std::vector<Int_t> scalars ;      // Indices in _nodes of the bin-independent factors
+    std::vector<Double_t> shape ;     // Product of the constant per-bin factors
+    std::vector<Interpolation> interpolations ;
+    std::vector<Int_t> gammas ;       // Indices in _nodes of the per-bin parameters (set-major)
+  } ;
+
+  struct Channel {
+    std::string label ;               // State of the index category
+    std::vector<Double_t> volume ;    // Bin volume
+    std::vector<Double_t> counts ;    // Observed (weighted) counts per bin
+    std::vector<Sample> samples ;
+  } ;
+
+protected:
+
+  void compileChannel(RooAbsPdf& channelPdf, const char* label, const RooAbsData& data) ;
+  void fillCounts(RooAbsData& data) ;
+  Int_t addNode(RooAbsReal& node) ;
+
+  Double_t evaluateChannel(const Channel& channel) const ;
+  Double_t evaluate() const ;
+
+  RooListProxy _nodes ;             // All parameter-dependent nodes read by the compiled model
+  Int_t _constrIndex ;              // Index in _nodes of the sum of the constraint terms, or -1
+  std::vector<Channel> _channels ;  // Compiled model and observed counts of each channel
+  std::string _catName ;            // Name of the index category in the dataset
+  std::vector<std::vector<std::string> > _obsNames ;      // Names of the observables of each channel
+  std::vector<std::vector<RooAbsBinning*> > _binnings ;   // Binnings of the observables of each channel
+  Bool_t _doOffset ;                // Subtract the value of the first evaluation
+  mutable Double_t _offset ;        // Offset subtracted from the likelihood
+  mutable std::vector<Double_t> _values ;  // Values of _nodes in the current evaluation
+  mutable std::vector<Double_t> _density ; // Scratch buffer of the channel density
+  mutable std::vector<Double_t> _shape ;   // Scratch buffer of a sample shape
+  mutable std::vector<Double_t> _interp ;  // Scratch buffer of an interpolated factor
+
+private:
+
+  ClassDef(RooStats::HistFactory::FlatBinnedNLL,0) // -log(L) of a HistFactory model evaluated on flat per-bin arrays
+};
+
+  }
+}
+
+#endif
@@ -8,7 +8,10 @@
 #include "RooStats/HistFactory/ParamHistFunc.h"
 
 namespace RooStats {
+class ModelConfig;
 namespace HistFactory {
+  class HistFactorySimultaneous;
+
   ///\ingroup HistFactory
   std::string channelNameFromPdf( RooAbsPdf* channelPdf );
 
@@ -32,6 +35,9 @@ namespace HistFactory {
   int getStatUncertaintyConstraintTerm( RooArgList* constraints, RooRealVar* gamma_stat, 
 					RooAbsReal*& pois_mean, RooRealVar*& tau );
 
+  ///\ingroup HistFactory
+  HistFactorySimultaneous* EnableFlatEvaluation( ModelConfig& config );
+
 }
 }
 
@@ -27,7 +27,7 @@ class HistFactorySimultaneous : public RooSimultaneous {
 public:
 
   // Constructors, assignment etc
-  inline HistFactorySimultaneous() : RooSimultaneous() {} //_plotCoefNormRange(0) { }
+  inline HistFactorySimultaneous() : RooSimultaneous(), _flatEvaluation(kFALSE) {} //_plotCoefNormRange(0) { }
   HistFactorySimultaneous(const char *name, const char *title, RooAbsCategoryLValue& indexCat) ;
   HistFactorySimultaneous(const char *name, const char *title, std::map<std::string,RooAbsPdf*> pdfMap, RooAbsCategoryLValue& inIndexCat) ;
   HistFactorySimultaneous(const char *name, const char *title, const RooArgList& pdfList, RooAbsCategoryLValue& indexCat) ;
@@ -44,11 +44,17 @@ public:
 				const RooCmdArg& arg3 = RooCmdArg::none(), const RooCmdArg& arg4 = RooCmdArg::none(), 
 				const RooCmdArg& arg5 = RooCmdArg::none(), const RooCmdArg& arg6 = RooCmdArg::none(), 
 				const RooCmdArg& arg7 = RooCmdArg::none(), const RooCmdArg& arg8 = RooCmdArg::none());
-    
+
+  void setFlatEvaluation(Bool_t flag=kTRUE) { _flatEvaluation = flag ; }
+  Bool_t flatEvaluation() const { return _flatEvaluation ; }
   
 protected:
 
-  ClassDef(RooStats::HistFactory::HistFactorySimultaneous,2)  // Simultaneous operator p.d.f, functions like C++  'switch()' on input p.d.fs operating on index category5A
+  RooAbsReal* createFlatNLL(RooAbsData& data, const RooLinkedList& cmdList) ;
+
+  Bool_t _flatEvaluation ; // createNLL returns a FlatBinnedNLL instead of a RooBarlowBeestonLL
+
+  ClassDef(RooStats::HistFactory::HistFactorySimultaneous,3)  // Simultaneous operator p.d.f, functions like C++  'switch()' on input p.d.fs operating on index category5A
 };
 
 }
@@ -0,0 +1,634 @@
+// @(#)root/roostats:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+/** \class RooStats::HistFactory::FlatBinnedNLL
+ * \ingroup HistFactory
+ *
+ * -log(L) of a binned HistFactory model, evaluated on flat per-bin arrays
+ * instead of by walking the RooFit computation graph bin by bin.
+ *
+ * At construction, the RooRealSumPdf of each channel of the RooSimultaneous
+ * built by HistoToWorkspaceFactoryFast is compiled into
+ * - the product of the factors of each sample that depend only on the
+ *   observables (the nominal RooHistFunc), tabulated per bin,
+ * - the per-bin nominal, low and high values of the PiecewiseInterpolation
+ *   (HistoSys) of each sample,
+ * - the per-bin parameters of the ParamHistFunc (stat. errors, ShapeSys and
+ *   ShapeFactor) of each sample,
+ * - the bin-independent factors of each sample (normalisation factors,
+ *   FlexibleInterpVar for the OverallSys, luminosity and bin width).
+ *
+ * An evaluation reads the current value of each of these parameters once and
+ * computes all bins of a sample in tight loops over contiguous arrays.  The
+ * value is the extended likelihood of the channels,
+ * \f[ \sum_c \sum_b \left( V_{cb}\, f_{cb} - n_{cb} \log f_{cb} \right) \f]
+ * where \f$ f_{cb} \f$ is the density of the channel in the bin, \f$ V_{cb} \f$
+ * the bin volume and \f$ n_{cb} \f$ the observed count, plus the sum of the
+ * constraint terms.  This is exactly what RooNLLVar computes for the same model
+ * and dataset (with the RooBinIntegrator the HistFactory models use), so the
+ * object can replace it in a fit or in the RooStats calculators.  It is
+ * created by HistFactorySimultaneous::createNLL when flat evaluation is enabled
+ * (see HistFactorySimultaneous::setFlatEvaluation).  For a model built by
+ * HistoToWorkspaceFactoryFast, RooStats::HistFactory::EnableFlatEvaluation()
+ * sets such a pdf in the ModelConfig, for use by the RooStats calculators:
+ * \code
+ * RooStats::HistFactory::EnableFlatEvaluation(*mc);
+ * RooStats::ProfileLikelihoodCalculator plc(*data, *mc);
+ * \endcode
+ *
+ * Models containing other per-bin functions than the ones listed above cannot
+ * be compiled: the constructor throws a hf_exc.
+ */
+
+#include "RooStats/HistFactory/FlatBinnedNLL.h"
+
+#include "RooStats/HistFactory/HistFactoryException.h"
+#include "RooStats/HistFactory/HistFactoryModelUtils.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+
+#include "RooAbsBinning.h"
+#include "RooAbsData.h"
+#include "RooAbsRealLValue.h"
+#include "RooCatType.h"
+#include "RooConstraintSum.h"
+#include "RooMsgService.h"
+#include "RooProduct.h"
+#include "RooRealSumPdf.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace std ;
+
+ClassImp(RooStats::HistFactory::FlatBinnedNLL);
+
+namespace {
+
+  // Factors of the expected yield of one sample, sorted by how they depend on
+  // the observables
+  struct FactorList {
+    RooArgList scalars ;                          // Do not depend on the observables
+    RooArgList constants ;                        // Depend only on the observables
+    std::vector<PiecewiseInterpolation*> interps ;
+    std::vector<ParamHistFunc*> gammas ;
+  } ;
+
+  Bool_t dependsOnlyOn(const RooAbsArg& arg, const RooArgSet& obs)
+  {
+    RooArgSet* vars = arg.getVariables() ;
+    vars->remove(obs,kTRUE,kTRUE) ;
+    Bool_t ret = (vars->getSize()==0) ;
+    delete vars ;
+    return ret ;
+  }
+
+  Bool_t dependsOnlyOn(const RooAbsCollection& args, const RooArgSet& obs)
+  {
+    for (Int_t i=0 ; i<args.getSize() ; i++) {
+      if (!dependsOnlyOn(*args[i],obs)) return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  Bool_t anyDependsOn(const RooAbsCollection& args, const RooArgSet& obs)
+  {
+    for (Int_t i=0 ; i<args.getSize() ; i++) {
+      if (args[i]->dependsOn(obs)) return kTRUE ;
+    }
+    return kFALSE ;
+  }
+
+  Bool_t classifyFactor(RooAbsReal& factor, const RooArgSet& obs, FactorList& factors)
+  {
+    if (!factor.dependsOn(obs)) {
+      factors.scalars.add(factor) ;
+      return kTRUE ;
+    }
+
+    if (RooProduct* prod = dynamic_cast<RooProduct*>(&factor)) {
+      RooArgList comps = prod->components() ;
+      for (Int_t i=0 ; i<comps.getSize() ; i++) {
+        RooAbsReal* comp = dynamic_cast<RooAbsReal*>(comps.at(i)) ;
+        if (!comp || !classifyFactor(*comp,obs,factors)) return kFALSE ;
+      }
+      return kTRUE ;
+    }
+
+    if (PiecewiseInterpolation* interp = dynamic_cast<PiecewiseInterpolation*>(&factor)) {
+      if (!dependsOnlyOn(*interp->nominalHist(),obs) || !dependsOnlyOn(interp->lowList(),obs) ||
+          !dependsOnlyOn(interp->highList(),obs) || anyDependsOn(interp->paramList(),obs)) {
+        return kFALSE ;
+      }
+      const std::vector<int>& codes = interp->interpolationCodes() ;
+      for (unsigned int i=0 ; i<codes.size() ; i++) {
+        if (codes[i]<0 || codes[i]>5) return kFALSE ;
+      }
+      factors.interps.push_back(interp) ;
+      return kTRUE ;
+    }
+
+    if (ParamHistFunc* phf = dynamic_cast<ParamHistFunc*>(&factor)) {
+      if (anyDependsOn(phf->paramList(),obs)) return kFALSE ;
+      factors.gammas.push_back(phf) ;
+      return kTRUE ;
+    }
+
+    if (dependsOnlyOn(factor,obs)) {
+      factors.constants.add(factor) ;
+      return kTRUE ;
+    }
+
+    return kFALSE ;
+  }
+
+  // Multiply the shape by the interpolated factor of the parameters x
+  void applyInterpolation(const RooStats::HistFactory::FlatBinnedNLL::Interpolation& ip, const Double_t* values,
+                          std::size_t n, Double_t* sum, Double_t* shape)
+  {
+    const Double_t* nom = ip.nominal.data() ;
+    std::copy(nom, nom+n, sum) ;
+
+    for (std::size_t k=0 ; k<ip.params.size() ; k++) {
+      const Double_t x = values[ip.params[k]] ;
+      const Double_t* lo = ip.low.data() + k*n ;
+      const Double_t* hi = ip.high.data() + k*n ;
+
+      // The choice of the branch depends only on the parameter, the loops over
+      // the bins are branch-free
+      switch (ip.codes[k]) {
+      case 0:
+        if (x>0) {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(hi[b]-nom[b]) ;
+        } else {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(nom[b]-lo[b]) ;
+        }
+        break ;
+      case 1:
+        if (x>=0) {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] *= std::pow(hi[b]/nom[b], x) ;
+        } else {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] *= std::pow(lo[b]/nom[b], -x) ;
+        }
+        break ;
+      case 2:
+      case 3:
+        if (x>1) {
+          for (std::size_t b=0 ; b<n ; b++) {
+            const Double_t a = 0.5*(hi[b]+lo[b])-nom[b] ;
+            const Double_t c = 0.5*(hi[b]-lo[b]) ;
+            sum[b] += (2*a+c)*(x-1)+hi[b]-nom[b] ;
+          }
+        } else if (x<-1) {
+          for (std::size_t b=0 ; b<n ; b++) {
+            const Double_t a = 0.5*(hi[b]+lo[b])-nom[b] ;
+            const Double_t c = 0.5*(hi[b]-lo[b]) ;
+            sum[b] += -1*(2*a-c)*(x+1)+lo[b]-nom[b] ;
+          }
+        } else {
+          for (std::size_t b=0 ; b<n ; b++) {
+            const Double_t a = 0.5*(hi[b]+lo[b])-nom[b] ;
+            const Double_t c = 0.5*(hi[b]-lo[b]) ;
+            sum[b] += a*x*x + c*x ;
+          }
+        }
+        break ;
+      case 4:
+        if (x>1) {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(hi[b]-nom[b]) ;
+        } else if (x<-1) {
+          for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(nom[b]-lo[b]) ;
+        } else {
+          const Double_t poly = x*x*(15 + x*x*(-10 + x*x*3)) ;
+          for (std::size_t b=0 ; b<n ; b++) {
+            const Double_t epsPlus = hi[b]-nom[b] ;
+            const Double_t epsMinus = nom[b]-lo[b] ;
+            const Double_t S = 0.5*(epsPlus+epsMinus) ;
+            const Double_t A = 0.0625*(epsPlus-epsMinus) ;
+            const Double_t val = std::max(nom[b] + x*S + A*poly, 0.) ;
+            sum[b] += val-nom[b] ;
+          }
+        }
+        break ;
+      case 5:
+        if (x>1 || x<-1) {
+          if (x>0) {
+            for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(hi[b]-nom[b]) ;
+          } else {
+            for (std::size_t b=0 ; b<n ; b++) sum[b] += x*(nom[b]-lo[b]) ;
+          }
+        } else {
+          for (std::size_t b=0 ; b<n ; b++) {
+            const Double_t epsPlus = hi[b]-nom[b] ;
+            const Double_t epsMinus = nom[b]-lo[b] ;
+            const Double_t S = 0.5*(epsPlus+epsMinus) ;
+            const Double_t A = 0.5*(epsPlus-epsMinus) ;
+            const Double_t val = std::max(nom[b] + S*x + 1.5*A*x*x - 0.5*A*x*x*x*x, 0.) ;
+            sum[b] += (nom[b]!=0) ? val-nom[b] : 0. ;
+          }
+        }
+        break ;
+      }
+    }
+
+    if (ip.positiveDefinite) {
+      for (std::size_t b=0 ; b<n ; b++) sum[b] = sum[b]<0 ? 0. : sum[b] ;
+    }
+    for (std::size_t b=0 ; b<n ; b++) shape[b] *= sum[b] ;
+  }
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor.
+
+RooStats::HistFactory::FlatBinnedNLL::FlatBinnedNLL() :
+  _constrIndex(-1), _doOffset(kFALSE), _offset(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the channels of the HistFactory model pdf and the counts of data.
+/// The constraint p.d.f.s are added as a RooConstraintSum normalised over
+/// constraintNormSet, as RooAbsPdf::createNLL does. Throws a hf_exc if the
+/// model cannot be compiled.
+
+RooStats::HistFactory::FlatBinnedNLL::FlatBinnedNLL(const char *name, const char *title, RooSimultaneous& pdf,
+                                                     RooAbsData& data, const RooArgSet& constraints,
+                                                     const RooArgSet& constraintNormSet) :
+  RooAbsReal(name,title),
+  _nodes("nodes","Parameters of the compiled model",this),
+  _constrIndex(-1), _catName(pdf.indexCat().GetName()), _doOffset(kFALSE), _offset(0)
+{
+  TIterator* iter = pdf.indexCat().typeIterator() ;
+  RooCatType* type ;
+  while ((type=(RooCatType*)iter->Next())) {
+    RooAbsPdf* channelPdf = pdf.getPdf(type->GetName()) ;
+    if (channelPdf) {
+      compileChannel(*channelPdf,type->GetName(),data) ;
+    }
+  }
+  delete iter ;
+
+  fillCounts(data) ;
+
+  if (constraints.getSize()>0) {
+    RooConstraintSum* constr = new RooConstraintSum(Form("%s_constr",name),"nllCons",constraints,constraintNormSet) ;
+    _constrIndex = addNode(*constr) ;
+    addOwnedComponents(*constr) ;
+  }
+
+  _values.resize(_nodes.getSize()) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+RooStats::HistFactory::FlatBinnedNLL::FlatBinnedNLL(const FlatBinnedNLL& other, const char* name) :
+  RooAbsReal(other,name),
+  _nodes("nodes",this,other._nodes),
+  _constrIndex(other._constrIndex), _channels(other._channels), _catName(other._catName),
+  _obsNames(other._obsNames), _doOffset(other._doOffset), _offset(other._offset),
+  _values(other._values), _density(other._density), _shape(other._shape), _interp(other._interp)
+{
+  for (unsigned int c=0 ; c<other._binnings.size() ; c++) {
+    _binnings.push_back(std::vector<RooAbsBinning*>()) ;
+    for (unsigned int j=0 ; j<other._binnings[c].size() ; j++) {
+      _binnings.back().push_back(other._binnings[c][j]->clone()) ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+RooStats::HistFactory::FlatBinnedNLL::~FlatBinnedNLL()
+{
+  for (unsigned int c=0 ; c<_binnings.size() ; c++) {
+    for (unsigned int j=0 ; j<_binnings[c].size() ; j++) {
+      delete _binnings[c][j] ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of node in the list of nodes, adding it if needed.
+
+Int_t RooStats::HistFactory::FlatBinnedNLL::addNode(RooAbsReal& node)
+{
+  Int_t index = _nodes.index(&node) ;
+  if (index<0) {
+    _nodes.add(node) ;
+    index = _nodes.getSize()-1 ;
+  }
+  return index ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the total number of bins of all channels.
+
+Int_t RooStats::HistFactory::FlatBinnedNLL::numBins() const
+{
+  Int_t n(0) ;
+  for (unsigned int c=0 ; c<_channels.size() ; c++) {
+    n += _channels[c].volume.size() ;
+  }
+  return n ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tabulate the samples of one channel in all the bins of its observables.
+
+void RooStats::HistFactory::FlatBinnedNLL::compileChannel(RooAbsPdf& channelPdf, const char* label, const RooAbsData& data)
+{
+  RooRealSumPdf* sumPdf = dynamic_cast<RooRealSumPdf*>(getSumPdfFromChannel(&channelPdf)) ;
+  if (!sumPdf || sumPdf->funcList().getSize()!=sumPdf->coefList().getSize()) {
+    coutE(InputArguments) << "FlatBinnedNLL::compileChannel(" << GetName() << ") ERROR: channel " << label
+                          << " is not a sum of samples with one coefficient each" << endl ;
+    throw hf_exc() ;
+  }
+
+  // Observables of the channel and their binnings
+  RooArgSet* obsSet = sumPdf->getObservables(data) ;
+  RooArgList obs(*obsSet) ;
+  delete obsSet ;
+
+  std::vector<RooAbsRealLValue*> obsVars ;
+  std::vector<std::string> obsNames ;
+  std::vector<RooAbsBinning*> binnings ;
+  std::vector<Double_t> savedValues ;
+  Int_t nBins(1) ;
+  for (Int_t j=0 ; j<obs.getSize() ; j++) {
+    RooAbsRealLValue* var = dynamic_cast<RooAbsRealLValue*>(obs.at(j)) ;
+    if (!var) {
+      coutE(InputArguments) << "FlatBinnedNLL::compileChannel(" << GetName() << ") ERROR: observable "
+                            << obs.at(j)->GetName() << " of channel " << label << " is not real-valued" << endl ;
+      throw hf_exc() ;
+    }
+    obsVars.push_back(var) ;
+    obsNames.push_back(var->GetName()) ;
+    binnings.push_back(var->getBinning().clone()) ;
+    savedValues.push_back(var->getVal()) ;
+    nBins *= var->getBinning().numBins() ;
+  }
+
+  // Sort the factors of each sample
+  std::vector<FactorList> factors(sumPdf->funcList().getSize()) ;
+  for (Int_t s=0 ; s<sumPdf->funcList().getSize() ; s++) {
+    RooAbsReal* func = static_cast<RooAbsReal*>(sumPdf->funcList().at(s)) ;
+    RooAbsReal* coef = static_cast<RooAbsReal*>(sumPdf->coefList().at(s)) ;
+    if (coef->dependsOn(obs) || !classifyFactor(*func,obs,factors[s])) {
+      coutE(InputArguments) << "FlatBinnedNLL::compileChannel(" << GetName() << ") ERROR: sample " << func->GetName()
+                            << " of channel " << label << " contains unsupported per-bin functions" << endl ;
+      for (unsigned int j=0 ; j<binnings.size() ; j++) delete binnings[j] ;
+      throw hf_exc() ;
+    }
+    factors[s].scalars.add(*coef) ;
+  }
+
+  Channel channel ;
+  channel.label = label ;
+  channel.volume.resize(nBins) ;
+  channel.samples.resize(factors.size()) ;
+  for (unsigned int s=0 ; s<factors.size() ; s++) {
+    Sample& sample = channel.samples[s] ;
+    sample.name = sumPdf->funcList().at(s)->GetName() ;
+    for (Int_t i=0 ; i<factors[s].scalars.getSize() ; i++) {
+      sample.scalars.push_back(addNode(static_cast<RooAbsReal&>(*factors[s].scalars.at(i)))) ;
+    }
+    sample.shape.assign(nBins,1.) ;
+    sample.interpolations.resize(factors[s].interps.size()) ;
+    for (unsigned int k=0 ; k<factors[s].interps.size() ; k++) {
+      PiecewiseInterpolation* pi = factors[s].interps[k] ;
+      Interpolation& ip = sample.interpolations[k] ;
+      for (Int_t i=0 ; i<pi->paramList().getSize() ; i++) {
+        ip.params.push_back(addNode(static_cast<RooAbsReal&>(*pi->paramList().at(i)))) ;
+      }
+      ip.codes.assign(pi->interpolationCodes().begin(),pi->interpolationCodes().end()) ;
+      ip.nominal.resize(nBins) ;
+      ip.low.resize(nBins*ip.params.size()) ;
+      ip.high.resize(nBins*ip.params.size()) ;
+      ip.positiveDefinite = pi->positiveDefinite() ;
+    }
+    sample.gammas.resize(nBins*factors[s].gammas.size()) ;
+  }
+
+  // Evaluate the per-bin factors at the bin centres. The first observable
+  // runs fastest in the bin index.
+  for (Int_t bin=0 ; bin<nBins ; bin++) {
+    Int_t rest(bin) ;
+    Double_t volume(1) ;
+    for (unsigned int j=0 ; j<obsVars.size() ; j++) {
+      const Int_t nj = binnings[j]->numBins() ;
+      obsVars[j]->setVal(binnings[j]->binCenter(rest % nj)) ;
+      volume *= binnings[j]->binWidth(rest % nj) ;
+      rest /= nj ;
+    }
+    channel.volume[bin] = volume ;
+
+    for (unsigned int s=0 ; s<factors.size() ; s++) {
+      Sample& sample = channel.samples[s] ;
+      for (Int_t i=0 ; i<factors[s].constants.getSize() ; i++) {
+        sample.shape[bin] *= static_cast<RooAbsReal*>(factors[s].constants.at(i))->getVal() ;
+      }
+      for (unsigned int k=0 ; k<factors[s].interps.size() ; k++) {
+        PiecewiseInterpolation* pi = factors[s].interps[k] ;
+        Interpolation& ip = sample.interpolations[k] ;
+        ip.nominal[bin] = pi->nominalHist()->getVal() ;
+        for (unsigned int i=0 ; i<ip.params.size() ; i++) {
+          ip.low[i*nBins+bin] = static_cast<RooAbsReal*>(pi->lowList().at(i))->getVal() ;
+          ip.high[i*nBins+bin] = static_cast<RooAbsReal*>(pi->highList().at(i))->getVal() ;
+        }
+      }
+      for (unsigned int g=0 ; g<factors[s].gammas.size() ; g++) {
+        sample.gammas[g*nBins+bin] = addNode(factors[s].gammas[g]->getParameter()) ;
+      }
+    }
+  }
+
+  for (unsigned int j=0 ; j<obsVars.size() ; j++) {
+    obsVars[j]->setVal(savedValues[j]) ;
+  }
+
+  if ((Int_t)_density.size()<nBins) {
+    _density.resize(nBins) ;
+    _shape.resize(nBins) ;
+    _interp.resize(nBins) ;
+  }
+
+  _channels.push_back(channel) ;
+  _obsNames.push_back(obsNames) ;
+  _binnings.push_back(binnings) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Histogram the (weighted) entries of data in the bins of the channels.
+/// Entries outside of the observable ranges are ignored.
+
+void RooStats::HistFactory::FlatBinnedNLL::fillCounts(RooAbsData& data)
+{
+  std::map<std::string,Int_t> channelIndex ;
+  for (unsigned int c=0 ; c<_channels.size() ; c++) {
+    _channels[c].counts.assign(_channels[c].volume.size(),0.) ;
+    channelIndex[_channels[c].label] = c ;
+  }
+
+  for (Int_t i=0 ; i<data.numEntries() ; i++) {
+    const RooArgSet* row = data.get(i) ;
+    const Double_t weight = data.weight() ;
+    if (weight==0) continue ;
+
+    const RooAbsCategory* cat = dynamic_cast<const RooAbsCategory*>(row->find(_catName.c_str())) ;
+    if (!cat) {
+      coutE(InputArguments) << "FlatBinnedNLL::fillCounts(" << GetName() << ") ERROR: dataset " << data.GetName()
+                            << " has no index category " << _catName << endl ;
+      throw hf_exc() ;
+    }
+    std::map<std::string,Int_t>::const_iterator found = channelIndex.find(cat->getLabel()) ;
+    if (found==channelIndex.end()) continue ;
+    const Int_t c = found->second ;
+
+    Int_t bin(0), stride(1) ;
+    Bool_t inRange(kTRUE) ;
+    for (unsigned int j=0 ; j<_obsNames[c].size() && inRange ; j++) {
+      const RooAbsReal* var = dynamic_cast<const RooAbsReal*>(row->find(_obsNames[c][j].c_str())) ;
+      if (!var) {
+        coutE(InputArguments) << "FlatBinnedNLL::fillCounts(" << GetName() << ") ERROR: dataset " << data.GetName()
+                              << " has no observable " << _obsNames[c][j] << endl ;
+        throw hf_exc() ;
+      }
+      const RooAbsBinning* binning = _binnings[c][j] ;
+      const Double_t x = var->getVal() ;
+      inRange = (x>=binning->lowBound() && x<=binning->highBound()) ;
+      bin += stride*binning->binNumber(x) ;
+      stride *= binning->numBins() ;
+    }
+    if (inRange) {
+      _channels[c].counts[bin] += weight ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the observed counts by the ones of data. The model is not
+/// recompiled.
+
+Bool_t RooStats::HistFactory::FlatBinnedNLL::setData(RooAbsData& data, Bool_t /*cloneData*/)
+{
+  fillCounts(data) ;
+  _offset = 0 ;
+  setValueDirty() ;
+  return kTRUE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Subtract the value of the first evaluation from the likelihood.
+
+void RooStats::HistFactory::FlatBinnedNLL::enableOffsetting(Bool_t flag)
+{
+  _doOffset = flag ;
+  _offset = 0 ;
+  setValueDirty() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the extended -log(L) of one channel.
+
+Double_t RooStats::HistFactory::FlatBinnedNLL::evaluateChannel(const Channel& channel) const
+{
+  const std::size_t n = channel.volume.size() ;
+  const Double_t* values = _values.data() ;
+  Double_t* density = _density.data() ;
+  Double_t* shape = _shape.data() ;
+
+  std::fill(density, density+n, 0.) ;
+  for (unsigned int s=0 ; s<channel.samples.size() ; s++) {
+    const Sample& sample = channel.samples[s] ;
+
+    Double_t norm(1) ;
+    for (unsigned int i=0 ; i<sample.scalars.size() ; i++) {
+      norm *= values[sample.scalars[i]] ;
+    }
+
+    const Double_t* nominal = sample.shape.data() ;
+    for (std::size_t b=0 ; b<n ; b++) shape[b] = norm*nominal[b] ;
+
+    for (unsigned int k=0 ; k<sample.interpolations.size() ; k++) {
+      applyInterpolation(sample.interpolations[k], values, n, _interp.data(), shape) ;
+    }
+
+    for (std::size_t g=0 ; g<sample.gammas.size() ; g+=n) {
+      const Int_t* gamma = sample.gammas.data() + g ;
+      for (std::size_t b=0 ; b<n ; b++) shape[b] *= values[gamma[b]] ;
+    }
+
+    for (std::size_t b=0 ; b<n ; b++) density[b] += shape[b] ;
+  }
+
+  const Double_t* volume = channel.volume.data() ;
+  const Double_t* counts = channel.counts.data() ;
+  Double_t expected(0), sumLog(0) ;
+  for (std::size_t b=0 ; b<n ; b++) {
+    expected += volume[b]*density[b] ;
+  }
+  for (std::size_t b=0 ; b<n ; b++) {
+    if (counts[b]==0) continue ;
+    if (density[b]<=0) {
+      logEvalError(Form("p.d.f. value is zero or negative in bin %d of channel %s",(Int_t)b,channel.label.c_str())) ;
+    }
+    sumLog += counts[b]*std::log(density[b]) ;
+  }
+
+  return expected - sumLog ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the current values of all parameters and sum the likelihood of all
+/// channels and the constraint terms.
+
+Double_t RooStats::HistFactory::FlatBinnedNLL::evaluate() const
+{
+  for (Int_t i=0 ; i<_nodes.getSize() ; i++) {
+    _values[i] = static_cast<RooAbsReal*>(_nodes.at(i))->getVal() ;
+  }
+
+  Double_t result(0) ;
+  for (unsigned int c=0 ; c<_channels.size() ; c++) {
+    result += evaluateChannel(_channels[c]) ;
+  }
+  if (_constrIndex>=0) {
+    result += _values[_constrIndex] ;
+  }
+
+  if (_doOffset) {
+    if (_offset==0) {
+      _offset = result ;
+    }
+    result -= _offset ;
+  }
+
+  return result ;
+}
@@ -20,6 +20,7 @@
 
 #include "RooStats/HistFactory/HistFactorySimultaneous.h"
 #include "RooStats/HistFactory/HistFactoryModelUtils.h"
+#include "RooStats/ModelConfig.h"
 
 namespace RooStats{
 namespace HistFactory{
@@ -422,6 +423,38 @@ namespace HistFactory{
   }
 
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Let the calculators using config evaluate the likelihood of its model on
+  /// flat arrays (see HistFactorySimultaneous::setFlatEvaluation). The
+  /// RooSimultaneous built by HistoToWorkspaceFactoryFast is replaced, as the
+  /// pdf of config, by a HistFactorySimultaneous of the same channels, which is
+  /// imported in the workspace of config with the name of the model followed
+  /// by "_flat". Returns the pdf of config, or 0 if its pdf is not a
+  /// RooSimultaneous.
+
+  HistFactorySimultaneous* EnableFlatEvaluation( ModelConfig& config ) {
+
+    RooSimultaneous* simPdf = dynamic_cast<RooSimultaneous*>( config.GetPdf() );
+    if( !simPdf ) {
+      std::cout << "Error: The pdf of the ModelConfig: " << config.GetName()
+		<< " is not a RooSimultaneous, cannot enable the flat evaluation" << std::endl;
+      return NULL;
+    }
+
+    HistFactorySimultaneous* hfPdf = dynamic_cast<HistFactorySimultaneous*>( simPdf );
+    if( !hfPdf ) {
+      std::string flatName = std::string(simPdf->GetName()) + "_flat";
+      HistFactorySimultaneous flatPdf( *simPdf, flatName.c_str() );
+      config.SetPdf( flatPdf );
+      hfPdf = dynamic_cast<HistFactorySimultaneous*>( config.GetPdf() );
+      if( !hfPdf ) return NULL;
+    }
+    hfPdf->setFlatEvaluation();
+    return hfPdf;
+
+  }
+
+
 
 } // close RooStats namespace
 } // close HistFactory namespace
@@ -34,9 +34,14 @@
 
 
 #include "RooNLLVar.h"
+#include "RooAbsData.h"
+#include "RooCmdConfig.h"
+#include "RooMsgService.h"
 
 #include "RooStats/HistFactory/RooBarlowBeestonLL.h"
 #include "RooStats/HistFactory/HistFactorySimultaneous.h"
+#include "RooStats/HistFactory/FlatBinnedNLL.h"
+#include "RooStats/HistFactory/HistFactoryException.h"
 
 using namespace std ;
 
@@ -48,32 +53,32 @@ ClassImp(RooStats::HistFactory::HistFactorySimultaneous);
 
 RooStats::HistFactory::HistFactorySimultaneous::HistFactorySimultaneous(const char *name, const char *title, 
 						 RooAbsCategoryLValue& inIndexCat) : 
-  RooSimultaneous(name, title, inIndexCat ) {}
+  RooSimultaneous(name, title, inIndexCat ), _flatEvaluation(kFALSE) {}
 
 
 ////////////////////////////////////////////////////////////////////////////////
 
 RooStats::HistFactory::HistFactorySimultaneous::HistFactorySimultaneous(const char *name, const char *title, 
 				 const RooArgList& inPdfList, RooAbsCategoryLValue& inIndexCat) :
-  RooSimultaneous(name, title, inPdfList, inIndexCat) {}
+  RooSimultaneous(name, title, inPdfList, inIndexCat), _flatEvaluation(kFALSE) {}
 
 
 ////////////////////////////////////////////////////////////////////////////////
 
 RooStats::HistFactory::HistFactorySimultaneous::HistFactorySimultaneous(const char *name, const char *title, 
 				 map<string,RooAbsPdf*> pdfMap, RooAbsCategoryLValue& inIndexCat) :
-  RooSimultaneous(name, title, pdfMap, inIndexCat) {}
+  RooSimultaneous(name, title, pdfMap, inIndexCat), _flatEvaluation(kFALSE) {}
 
 
 ////////////////////////////////////////////////////////////////////////////////
 
 RooStats::HistFactory::HistFactorySimultaneous::HistFactorySimultaneous(const HistFactorySimultaneous& other, const char* name) : 
-  RooSimultaneous(other, name) {}
+  RooSimultaneous(other, name), _flatEvaluation(other._flatEvaluation) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 RooStats::HistFactory::HistFactorySimultaneous::HistFactorySimultaneous(const RooSimultaneous& other, const char* name) : 
-  RooSimultaneous(other, name) {}
+  RooSimultaneous(other, name), _flatEvaluation(kFALSE) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor
@@ -121,6 +126,14 @@ RooAbsReal* RooStats::HistFactory::HistFactorySimultaneous::createNLL(RooAbsData
   // Also, check for ownership/memory issue with the newly created nll
   // and whether RooBarlowBeestonLL owns it, etc
 
+  // With flat evaluation enabled, the model is compiled into a
+  // FlatBinnedNLL (see createFlatNLL). If this is not possible the
+  // Barlow-Beeston likelihood is returned as usual.
+  if (_flatEvaluation) {
+    RooAbsReal* flatnll = createFlatNLL( data, cmdList );
+    if (flatnll) return flatnll;
+  }
+
   // Create a standard nll
   RooNLLVar* nll = (RooNLLVar*) RooSimultaneous::createNLL( data, cmdList );
 
@@ -132,3 +145,100 @@ RooAbsReal* RooStats::HistFactory::HistFactorySimultaneous::createNLL(RooAbsData
   return bbnll;
 
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a FlatBinnedNLL of the model for data.
+///
+/// The constraint terms and their normalisation are determined from the
+/// Constrain(), GlobalObservables() and GlobalObservablesTag() arguments as in
+/// RooAbsPdf::createNLL, and Offset() is supported, as well as conditional
+/// observables the model does not depend on. Return 0 if other options
+/// (ranges, external constraints, non-extended likelihood, ...) are requested
+/// or if the model cannot be compiled.
+
+RooAbsReal* RooStats::HistFactory::HistFactorySimultaneous::createFlatNLL(RooAbsData& data, const RooLinkedList& cmdList) {
+
+  // Options changing the likelihood that the flat evaluation does not implement
+  const char* unsupported[] = { "Range", "RangeWithName", "SumCoefRange", "SplitRange",
+                                "ExternalConstraints", "Constrained" } ;
+  RooArgSet* observables = getObservables(data) ;
+  RooLinkedListIter iter = cmdList.iterator() ;
+  RooCmdArg* arg ;
+  while ((arg=(RooCmdArg*)iter.Next())) {
+    // Conditional observables only change the likelihood if the model depends
+    // on them: the RooStats calculators always pass them, mostly empty
+    const RooArgSet* projObs = arg->getSet(0) ;
+    if (std::string(arg->GetName())=="ProjectedObservables" && projObs && projObs->overlaps(*observables)) {
+      coutW(Minimization) << "HistFactorySimultaneous::createNLL(" << GetName() << ") conditional observables "
+                          << "are not supported by the flat evaluation, using the standard likelihood" << endl ;
+      delete observables ;
+      return 0 ;
+    }
+    for (unsigned int i=0 ; i<sizeof(unsupported)/sizeof(unsupported[0]) ; i++) {
+      if (std::string(arg->GetName())==unsupported[i]) {
+        coutW(Minimization) << "HistFactorySimultaneous::createNLL(" << GetName() << ") option " << arg->GetName()
+                            << " is not supported by the flat evaluation, using the standard likelihood" << endl ;
+        delete observables ;
+        return 0 ;
+      }
+    }
+  }
+  delete observables ;
+
+  RooCmdConfig pc(Form("HistFactorySimultaneous::createFlatNLL(%s)",GetName())) ;
+  pc.allowUndefined() ;
+  pc.defineString("globstag","GlobalObservablesTag",0,"") ;
+  pc.defineInt("ext","Extended",0,2) ;
+  pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineSet("cPars","Constrain",0,0) ;
+  pc.defineSet("glObs","GlobalObservables",0,0) ;
+  pc.process(cmdList) ;
+  if (!pc.ok(kTRUE)) {
+    return 0 ;
+  }
+
+  if (pc.getInt("ext")==0) {
+    coutW(Minimization) << "HistFactorySimultaneous::createNLL(" << GetName() << ") the flat evaluation "
+                        << "always uses the extended likelihood, using the standard likelihood" << endl ;
+    return 0 ;
+  }
+
+  // Global observables, as in RooAbsPdf::createNLL
+  RooArgSet* glObs = pc.getSet("glObs") ;
+  RooArgSet* ownedGlObs(0) ;
+  const char* globsTag = pc.hasProcessed("GlobalObservablesTag") ? pc.getString("globstag",0,kTRUE) : getStringAttribute("DefaultGlobalObservablesTag") ;
+  if (!pc.hasProcessed("GlobalObservables") && globsTag) {
+    RooArgSet* allVars = getVariables() ;
+    ownedGlObs = (RooArgSet*) allVars->selectByAttrib(globsTag,kTRUE) ;
+    glObs = ownedGlObs ;
+    delete allVars ;
+  }
+
+  RooArgSet* cPars = pc.getSet("cPars") ;
+  Bool_t doStripDisconnected(kFALSE) ;
+  if (!cPars) {
+    cPars = getParameters(data,kFALSE) ;
+    doStripDisconnected = kTRUE ;
+  }
+  RooArgSet* constraints = getAllConstraints(*data.get(), *cPars, doStripDisconnected) ;
+
+  RooAbsReal* nll(0) ;
+  try {
+    nll = new FlatBinnedNLL(Form("nll_%s_%s",GetName(),data.GetName()), "-log(likelihood)", *this, data,
+                            *constraints, glObs ? *glObs : *cPars) ;
+    if (pc.getInt("doOffset")) {
+      nll->enableOffsetting(kTRUE) ;
+    }
+  } catch (hf_exc&) {
+    coutW(Minimization) << "HistFactorySimultaneous::createNLL(" << GetName() << ") the model cannot be "
+                        << "evaluated on flat arrays, using the standard likelihood" << endl ;
+    nll = 0 ;
+  }
+
+  delete constraints ;
+  if (doStripDisconnected) delete cPars ;
+  delete ownedGlObs ;
+
+  return nll ;
+}
@@ -1,9 +1,25 @@
 // Tests for the HistFactory
 // Authors: Stephan Hageboeck, CERN  01/2019
 
+#include "RooStats/HistFactory/Channel.h"
+#include "RooStats/HistFactory/FlatBinnedNLL.h"
+#include "RooStats/HistFactory/HistFactoryModelUtils.h"
+#include "RooStats/HistFactory/HistFactorySimultaneous.h"
+#include "RooStats/HistFactory/HistoToWorkspaceFactoryFast.h"
+#include "RooStats/HistFactory/Measurement.h"
 #include "RooStats/HistFactory/Sample.h"
+#include "RooStats/LikelihoodInterval.h"
+#include "RooStats/ModelConfig.h"
+#include "RooStats/ProfileLikelihoodCalculator.h"
+#include "RooProfileLL.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+#include "RooWorkspace.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <memory>
+
 using namespace RooStats;
 using namespace RooStats::HistFactory;
 
@@ -22,3 +38,120 @@ TEST(Sample, CopyAssignment)
   ASSERT_EQ(hist->GetNbinsX(), 10);
 }
 
+
+/// Build the workspace of a model with all the usual kinds of systematics.
+static RooWorkspace* MakeFlatTestModel()
+{
+  Measurement meas("meas", "meas");
+  meas.SetPOI("mu");
+  meas.SetLumi(1.0);
+  meas.SetLumiRelErr(0.05);
+  meas.SetExportOnly(true);
+
+  auto hData = new TH1D("data", "data", 5, 0, 5);
+  auto hSig = new TH1D("sig", "sig", 5, 0, 5);
+  auto hBkg = new TH1D("bkg", "bkg", 5, 0, 5);
+  auto hBkgLow = new TH1D("bkgLow", "bkgLow", 5, 0, 5);
+  auto hBkgHigh = new TH1D("bkgHigh", "bkgHigh", 5, 0, 5);
+  hBkg->Sumw2();
+  for (int i = 1; i <= 5; ++i) {
+    hSig->SetBinContent(i, 2. * i);
+    hBkg->SetBinContent(i, 50. - 5. * i);
+    hBkg->SetBinError(i, 2. + 0.3 * i);
+    hBkgLow->SetBinContent(i, 48. - 6. * i);
+    hBkgHigh->SetBinContent(i, 53. - 4. * i);
+    hData->SetBinContent(i, 52. - 2. * i);
+  }
+
+  Channel chan("channel1");
+  chan.SetData(hData);
+  chan.SetStatErrorConfig(0.01, "Poisson");
+
+  Sample sig("signal");
+  sig.SetHisto(hSig);
+  sig.AddNormFactor("mu", 1, 0, 5);
+  sig.AddOverallSys("sigXsec", 0.9, 1.15);
+  chan.AddSample(sig);
+
+  Sample bkg("background");
+  bkg.SetHisto(hBkg);
+  bkg.ActivateStatError();
+  HistoSys shape;
+  shape.SetName("bkgShape");
+  shape.SetHistoLow(hBkgLow);
+  shape.SetHistoHigh(hBkgHigh);
+  bkg.AddHistoSys(shape);
+  chan.AddSample(bkg);
+  meas.AddChannel(chan);
+
+  return HistoToWorkspaceFactoryFast::MakeCombinedModel(meas);
+}
+
+/// The likelihood evaluated on the flat arrays must agree with the one of
+/// RooFit for a model with all the usual kinds of systematics.
+TEST(HistFactorySimultaneous, FlatEvaluation)
+{
+  std::unique_ptr<RooWorkspace> ws(MakeFlatTestModel());
+  auto mc = static_cast<ModelConfig*>(ws->obj("ModelConfig"));
+  auto simPdf = static_cast<RooSimultaneous*>(mc->GetPdf());
+  RooAbsData* data = ws->data("obsData");
+  ASSERT_NE(simPdf, nullptr);
+  ASSERT_NE(data, nullptr);
+
+  HistFactorySimultaneous hfPdf(*simPdf);
+  hfPdf.setFlatEvaluation();
+
+  std::unique_ptr<RooArgSet> params(simPdf->getParameters(*data));
+  std::unique_ptr<RooAbsReal> nll(simPdf->createNLL(*data, RooFit::Constrain(*params),
+                                                    RooFit::GlobalObservables(*mc->GetGlobalObservables())));
+  std::unique_ptr<RooAbsReal> flatNll(hfPdf.createNLL(*data, RooFit::Constrain(*params),
+                                                      RooFit::GlobalObservables(*mc->GetGlobalObservables())));
+  ASSERT_NE(dynamic_cast<FlatBinnedNLL*>(flatNll.get()), nullptr);
+  EXPECT_NEAR(nll->getVal(), flatNll->getVal(), 1.E-9 * std::abs(nll->getVal()));
+
+  ws->var("mu")->setVal(1.7);
+  ws->var("alpha_sigXsec")->setVal(-1.3);
+  ws->var("alpha_bkgShape")->setVal(0.6);
+  ws->var("gamma_stat_channel1_bin_2")->setVal(1.1);
+  EXPECT_NEAR(nll->getVal(), flatNll->getVal(), 1.E-9 * std::abs(nll->getVal()));
+}
+
+/// The calculators of RooStats use the flat evaluation once it is enabled on
+/// the ModelConfig, although they pass conditional observables, and find the
+/// same interval as with the standard likelihood.
+TEST(HistFactorySimultaneous, FlatEvaluationProfileLikelihoodCalculator)
+{
+  std::unique_ptr<RooWorkspace> ws(MakeFlatTestModel());
+  auto mc = static_cast<ModelConfig*>(ws->obj("ModelConfig"));
+  RooAbsData* data = ws->data("obsData");
+  ASSERT_NE(data, nullptr);
+  std::unique_ptr<RooArgSet> params(mc->GetPdf()->getParameters(*data));
+  ws->saveSnapshot("initial", *params);
+
+  ProfileLikelihoodCalculator plc(*data, *mc);
+  plc.SetConfidenceLevel(0.683);
+  std::unique_ptr<LikelihoodInterval> interval(plc.GetInterval());
+  ASSERT_NE(interval, nullptr);
+  auto profile = dynamic_cast<RooProfileLL*>(interval->GetLikelihoodRatio());
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(dynamic_cast<FlatBinnedNLL*>(&profile->nll()), nullptr);
+  RooRealVar* mu = ws->var("mu");
+  const double lower = interval->LowerLimit(*mu);
+  const double upper = interval->UpperLimit(*mu);
+
+  ws->loadSnapshot("initial");
+  HistFactorySimultaneous* hfPdf = EnableFlatEvaluation(*mc);
+  ASSERT_NE(hfPdf, nullptr);
+  EXPECT_EQ(hfPdf, mc->GetPdf());
+  EXPECT_TRUE(hfPdf->flatEvaluation());
+
+  ProfileLikelihoodCalculator flatPlc(*data, *mc);
+  flatPlc.SetConfidenceLevel(0.683);
+  std::unique_ptr<LikelihoodInterval> flatInterval(flatPlc.GetInterval());
+  ASSERT_NE(flatInterval, nullptr);
+  auto flatProfile = dynamic_cast<RooProfileLL*>(flatInterval->GetLikelihoodRatio());
+  ASSERT_NE(flatProfile, nullptr);
+  EXPECT_NE(dynamic_cast<FlatBinnedNLL*>(&flatProfile->nll()), nullptr);
+  EXPECT_NEAR(lower, flatInterval->LowerLimit(*mu), 1.E-3);
+  EXPECT_NEAR(upper, flatInterval->UpperLimit(*mu), 1.E-3);
+}
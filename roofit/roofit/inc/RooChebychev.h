@@ -45,6 +45,7 @@ private:
   mutable TNamed* _refRangeName ; 
 
   Double_t evaluate() const;
+  Bool_t evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const;
   Double_t evalAnaInt(const Double_t x) const;
 
   ClassDef(RooChebychev,2) // Chebychev polynomial PDF
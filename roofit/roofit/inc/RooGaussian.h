@@ -46,6 +46,7 @@ protected:
   RooRealProxy sigma ;
 
   Double_t evaluate() const ;
+  Bool_t evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const ;
 
 private:
 
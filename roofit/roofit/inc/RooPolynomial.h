@@ -50,6 +50,7 @@ protected:
 
   /// Evaluation
   Double_t evaluate() const;
+  Bool_t evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const;
 
   ClassDef(RooPolynomial,1) // Polynomial PDF
 };
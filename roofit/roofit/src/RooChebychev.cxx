@@ -129,6 +129,44 @@ Double_t RooChebychev::evaluate() const
   return sum;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the value of the polynomial in a batch of events. The coefficients
+/// must be the same in all the events.
+
+Bool_t RooChebychev::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  const Int_t order = _coefList.getSize();
+  if (order > 7) return kFALSE;
+  Double_t coef[7];
+  for (Int_t i = 0; i < order; ++i) {
+    const RooAbsReal& c = (RooAbsReal&)_coefList[i];
+    if (inputs.dependsOnEvent(c)) return kFALSE;
+    coef[i] = c.getVal();
+  }
+  std::vector<Double_t> xBuf;
+  const Double_t* xVal;
+  if (!getServerBatch(_x.arg(), xBuf, xVal, nEvents, inputs, normSet)) return kFALSE;
+
+  Double_t xmin = _x.min(_refRangeName?_refRangeName->GetName():0) ; Double_t xmax = _x.max(_refRangeName?_refRangeName->GetName():0);
+  for (Int_t j = 0; j < nEvents; ++j) {
+    Double_t x(-1+2*(xVal[j]-xmin)/(xmax-xmin));
+    Double_t x2(x*x);
+    Double_t sum(0) ;
+    switch (order) {
+    case  7: sum+=coef[6]*x*p3(x2,64,-112,56,-7);
+    case  6: sum+=coef[5]*p3(x2,32,-48,18,-1);
+    case  5: sum+=coef[4]*x*p2(x2,16,-20,5);
+    case  4: sum+=coef[3]*p2(x2,8,-8,1);
+    case  3: sum+=coef[2]*x*p1(x2,4,-3);
+    case  2: sum+=coef[1]*p1(x2,2,-1);
+    case  1: sum+=coef[0]*x;
+    case  0: sum+=1; break;
+    }
+    output[j] = sum;
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooChebychev::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /* rangeName */) const
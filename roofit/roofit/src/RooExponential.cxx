@@ -57,6 +57,23 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the (unnormalized) exponential in a batch of events.
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  std::vector<Double_t> xBuf, cBuf;
+  const Double_t *xVal, *cVal;
+  if (!getServerBatch(x.arg(), xBuf, xVal, nEvents, inputs, normSet) ||
+      !getServerBatch(c.arg(), cBuf, cVal, nEvents, inputs, normSet)) {
+    return kFALSE;
+  }
+  for (Int_t i = 0; i < nEvents; i++) {
+    output[i] = exp(cVal[i]*xVal[i]);
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
@@ -65,6 +65,26 @@ Double_t RooGaussian::evaluate() const
   return exp(-0.5*arg*arg/(sig*sig)) ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the (unnormalized) Gaussian in a batch of events.
+
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  std::vector<Double_t> xBuf, meanBuf, sigmaBuf ;
+  const Double_t *xVal, *meanVal, *sigmaVal ;
+  if (!getServerBatch(x.arg(), xBuf, xVal, nEvents, inputs, normSet) ||
+      !getServerBatch(mean.arg(), meanBuf, meanVal, nEvents, inputs, normSet) ||
+      !getServerBatch(sigma.arg(), sigmaBuf, sigmaVal, nEvents, inputs, normSet)) {
+    return kFALSE ;
+  }
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    const double arg = xVal[i] - meanVal[i];
+    const double sig = sigmaVal[i];
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
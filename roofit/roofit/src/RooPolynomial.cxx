@@ -31,6 +31,7 @@ RooPolynomial::RooPolynomial(const char*, const char*, RooAbsReal&, const RooArg
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "RooPolynomial.h"
 #include "RooAbsReal.h"
@@ -146,6 +147,41 @@ Double_t RooPolynomial::evaluate() const
   return retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the value of the polynomial in a batch of events. The coefficients
+/// must be the same in all the events.
+
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    std::fill(output, output + nEvents, lowestOrder ? 1. : 0.);
+    return kTRUE;
+  }
+  _wksp.clear();
+  _wksp.reserve(sz);
+  {
+    const RooArgSet* nset = _coefList.nset();
+    RooFIter it = _coefList.fwdIterator();
+    RooAbsReal* c;
+    while ((c = (RooAbsReal*) it.next())) {
+      if (inputs.dependsOnEvent(*c)) return kFALSE;
+      _wksp.push_back(c->getVal(nset));
+    }
+  }
+  std::vector<Double_t> xBuf;
+  const Double_t* xVal;
+  if (!getServerBatch(_x.arg(), xBuf, xVal, nEvents, inputs, normSet)) return kFALSE;
+  for (Int_t j = 0; j < nEvents; j++) {
+    const Double_t x = xVal[j];
+    Double_t retVal = _wksp[sz - 1];
+    for (unsigned i = sz - 1; i--; ) retVal = _wksp[i] + x * retVal;
+    output[j] = retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Advertise to RooFit that this function can be analytically integrated.
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
@@ -50,6 +50,7 @@ class RooListProxy ;
 class RooExpensiveObjectCache ;
 class RooWorkspace ;
 class RooRealProxy ;
+class RooDirtyGraph ;
 
 class RooRefArray : public TObjArray {
  public:
@@ -398,6 +399,7 @@ public:
     case Auto:
       if (_valueDirty) {
 	_valueDirty = kFALSE ;
+	if (_dirtyGraph) dirtyGraphNodeCleaned() ;
 	return isDerived();
       }
       return kFALSE ;
@@ -417,6 +419,7 @@ public:
       return kTRUE ;
     case Auto:
       if (_valueDirty || _shapeDirty) {
+	if (_valueDirty && _dirtyGraph) dirtyGraphNodeCleaned() ;
 	_shapeDirty = kFALSE ;
 	_valueDirty = kFALSE ;
 	return isDerived();
@@ -481,11 +484,13 @@ public:
   inline void setShapeDirty() const { setShapeDirty(0) ; }
 
   inline void clearValueAndShapeDirty() const {
+    if (_valueDirty && _dirtyGraph) dirtyGraphNodeCleaned() ;
     _valueDirty=kFALSE ;
     _shapeDirty=kFALSE ;
   }
 
   inline void clearValueDirty() const {
+    if (_valueDirty && _dirtyGraph) dirtyGraphNodeCleaned() ;
     _valueDirty=kFALSE ;
   }
   inline void clearShapeDirty() const {
@@ -609,6 +614,11 @@ public:
   mutable Bool_t _valueDirty ;  // Flag set if value needs recalculating because input values modified
   mutable Bool_t _shapeDirty ;  // Flag set if value needs recalculating because input shapes modified
 
+  // Compiled dirty state propagation (see RooDirtyGraph)
+  friend class RooDirtyGraph ;
+  void dirtyGraphNodeCleaned() const ;
+  void invalidateDirtyGraph() const ;
+
   friend class RooRealProxy ;
   mutable OperMode _operMode ; // Dirty state propagation mode
   mutable Bool_t _fast ; // Allow fast access mode in getVal() and proxies
@@ -630,6 +640,9 @@ public:
 
   mutable RooWorkspace *_myws; //! In which workspace do I live, if any
 
+  RooDirtyGraph* _dirtyGraph ; //! Compiled graph that propagates the dirty state of this object, if any
+  Int_t _dirtyGraphId ; //! Index of this object in _dirtyGraph
+
   public:
   virtual void ioStreamerPass2() ;
   static void ioStreamerPass2Finalize() ;
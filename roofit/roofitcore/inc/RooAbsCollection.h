@@ -22,6 +22,8 @@
 #include "RooCmdArg.h"
 #include "RooLinkedListIter.h"
 #include <string>
+#include <memory>
+#include <unordered_map>
 
 class RooCmdArg;
 
@@ -92,6 +94,7 @@ public:
   // List search methods
   RooAbsArg *find(const char *name) const ;
   RooAbsArg *find(const RooAbsArg&) const ;
+  void useHashMapForFind(Bool_t flag) const ;
 
   Bool_t contains(const RooAbsArg& var) const { 
     // Returns true if object with same name as var is contained in this collection
@@ -233,6 +236,16 @@ protected:
 
   void makeStructureTag() ;
   void makeTypedStructureTag() ;
+
+  // Name index for find() in large collections (see useHashMapForFind())
+  using NameIndex_t = std::unordered_map<const TNamed*,RooAbsArg*> ;
+  RooAbsArg* findInNameIndex(const TNamed* namePtr) const ;
+  inline void addToNameIndex(RooAbsArg* arg) { if (_nameIndex) _nameIndex->emplace(arg->namePtr(),arg) ; }
+  inline void clearNameIndex() { _nameIndex.reset() ; }
+
+  mutable Bool_t _useNameIndex{kFALSE} ; //! Use the name index in find()
+  mutable std::unique_ptr<NameIndex_t> _nameIndex ; //! Elements by name pointer, built on first use
+  mutable std::size_t _nameIndexRenames{0} ; //! Value of RooNameReg::renameCounter() when _nameIndex was built
   
 private:
   std::unique_ptr<LegacyIterator_t> makeLegacyIterator (bool forward = true) const;
@@ -58,6 +58,7 @@ public:
   TTree *GetClonedTree() const;
 
   void convertToVectorStore() ;
+  void convertToCompactStore() ;
   void convertToTreeStore();
 
   void attachBuffers(const RooArgSet& extObs) ;
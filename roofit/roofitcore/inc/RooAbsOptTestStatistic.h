@@ -24,6 +24,7 @@
 class RooArgSet ;
 class RooAbsData ;
 class RooAbsReal ;
+class RooDirtyGraph ;
 
 class RooAbsOptTestStatistic : public RooAbsTestStatistic {
 public:
@@ -55,6 +56,10 @@ public:
   Bool_t isSealed() const { return _sealed ; }
   const char* sealNotice() const { return _sealNotice.Data() ; }
 
+  void setDirtyGraphCompilation(Bool_t flag) ;
+  Bool_t dirtyGraphCompilation() const { return _compileDirtyGraph ; }
+  const RooDirtyGraph* dirtyGraph() const { return _funcGraph ; }
+
 
 protected:
 
@@ -72,6 +77,7 @@ protected:
   virtual RooArgSet requiredExtraObservables() const { return RooArgSet() ; }
   void optimizeCaching() ;
   void optimizeConstantTerms(Bool_t,Bool_t=kTRUE) ;
+  void updateFuncGraph() const ;
 
   RooArgSet*  _normSet ; // Pointer to set with observables used for normalization
   RooArgSet*  _funcCloneSet ; // Set owning all components of internal clone of input function
@@ -87,6 +93,8 @@ protected:
   RooAbsReal* _origFunc ; // Original function 
   RooAbsData* _origData ; // Original data 
   Bool_t      _optimized ; //!
+  mutable RooDirtyGraph* _funcGraph ; //! Compiled dirty state propagation graph of the function clone
+  Bool_t _compileDirtyGraph ; //! Compile the function clone into a dirty state propagation graph
 
   ClassDef(RooAbsOptTestStatistic,4) // Abstract base class for optimized test statistics
 };
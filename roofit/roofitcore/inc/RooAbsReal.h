@@ -47,7 +47,9 @@ class TH2F;
 class TH3F;
 
 #include <list>
+#include <map>
 #include <string>
+#include <vector>
 #include <iostream>
 
 class RooAbsReal : public RooAbsArg {
@@ -90,6 +92,32 @@ public:
 
   virtual Double_t getValV(const RooArgSet* normalisationSet = nullptr) const ;
 
+  //////////////////////////////////////////////////////////////////////////////////
+  /// Values of the observables of a batch of consecutive events, see getValBatch().
+  /// The dataset provides, for each real observable and cached node it stores, a
+  /// contiguous array with its value in each event.
+  class BatchInputs {
+  public:
+    BatchInputs(const RooArgSet& observables) : _observables(&observables), _begin(0) {}
+    /// Register the array of values of arg in all the events.
+    void addColumn(const RooAbsArg& arg, const Double_t* values) { _columns[arg.namePtr()] = values ; }
+    /// Set the index of the first event of the batch in the arrays.
+    void setFirstEvent(Int_t begin) { _begin = begin ; }
+    /// Return the values of arg in the events of the batch, or a null pointer if they are not stored.
+    const Double_t* column(const RooAbsArg& arg) const {
+      auto iter = _columns.find(arg.namePtr()) ;
+      return iter == _columns.end() ? nullptr : iter->second + _begin ;
+    }
+    /// Check if the value of arg changes from event to event.
+    Bool_t dependsOnEvent(const RooAbsArg& arg) const { return arg.dependsOnValue(*_observables) ; }
+  private:
+    const RooArgSet* _observables ;                    // Observables changing from event to event
+    std::map<const TNamed*,const Double_t*> _columns ; // Arrays of values, by name of the observable
+    Int_t _begin ;                                     // Index of the first event of the batch
+  } ;
+
+  virtual Bool_t getValBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet=nullptr) const ;
+
   Double_t getPropagatedError(const RooFitResult &fr, const RooArgSet &nset = RooArgSet());
 
   Bool_t operator==(Double_t value) const ;
@@ -389,6 +417,9 @@ protected:
   }
   /// Evaluate this PDF / function / constant. Needs to be overridden by all derived classes.
   virtual Double_t evaluate() const = 0 ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const ;
+  Bool_t getServerBatch(const RooAbsReal& server, std::vector<Double_t>& buffer, const Double_t*& values,
+                        Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet=nullptr) const ;
 
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
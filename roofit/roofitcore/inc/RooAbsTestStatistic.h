@@ -21,6 +21,9 @@
 #include "RooRealProxy.h"
 #include "TStopwatch.h"
 #include <string>
+#include <vector>
+
+namespace ROOT { class TThreadExecutor ; }
 
 class RooArgSet ;
 class RooAbsData ;
@@ -58,6 +61,9 @@ public:
   
   Bool_t setData(RooAbsData& data, Bool_t cloneData=kTRUE) ;
 
+  void setNumThreads(Int_t nThreads) ;
+  Int_t numThreads() const { return _nThreads ; }
+
   void enableOffsetting(Bool_t flag) ;
   Bool_t isOffsetting() const { return _doOffset ; }
   virtual Double_t offset() const { return _offset ; }
@@ -121,6 +127,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode() ;
+  Double_t evaluateThreaded(Int_t nFirst, Int_t nLast, Int_t nStep) const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -139,6 +147,12 @@ protected:
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
 
+  // Multi-threaded mode data
+  Int_t          _nThreads ;  //! Number of threads sharing the events in the calculation
+  std::vector<RooAbsTestStatistic*> _mtArray ; //! Clones calculating all but the last partition of the events
+  ROOT::TThreadExecutor* _mtExecutor ; //! Thread pool running the partitions
+  mutable Bool_t _mtWarm ;    //! Were all partitions evaluated once since the last change of the caches?
+
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
   mutable Double_t _offset ; //! Offset
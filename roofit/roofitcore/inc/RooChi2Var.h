@@ -53,8 +53,10 @@ public:
 				      const RooArgSet& projDeps, const char* rangeName=0, const char* addCoefRangeName=0, 
 				      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition,Bool_t verbose=kTRUE, Bool_t splitCutRange=kTRUE, Bool_t = kFALSE) {
     // Virtual constructor
-    return new RooChi2Var(name,title,(RooAbsPdf&)pdf,(RooDataHist&)dhist,projDeps,_funcMode,rangeName,
-			  addCoefRangeName,nCPU,interleave,verbose, splitCutRange,_etype) ;
+    RooChi2Var* chi2 = new RooChi2Var(name,title,(RooAbsPdf&)pdf,(RooDataHist&)dhist,projDeps,_funcMode,rangeName,
+				      addCoefRangeName,nCPU,interleave,verbose, splitCutRange,_etype) ;
+    chi2->_compileDirtyGraph = _compileDirtyGraph ;
+    return chi2 ;
   }
   
   virtual ~RooChi2Var();
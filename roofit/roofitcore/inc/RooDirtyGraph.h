@@ -0,0 +1,65 @@
+// @(#)root/roofitcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROO_DIRTY_GRAPH
+#define ROO_DIRTY_GRAPH
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class RooAbsArg ;
+class RooAbsReal ;
+class RooArgSet ;
+
+class RooDirtyGraph {
+public:
+
+  RooDirtyGraph(RooAbsArg& top) ;
+  ~RooDirtyGraph() ;
+
+  RooDirtyGraph(const RooDirtyGraph&) = delete ;
+  RooDirtyGraph& operator=(const RooDirtyGraph&) = delete ;
+
+  Bool_t isValid() const { return !_nodes.empty() ; }
+  void compile() ;
+
+  RooAbsArg& top() const { return *_top ; }
+  Int_t numNodes() const { return _nodes.size() ; }
+  RooAbsArg* node(Int_t id) const { return _nodes[id] ; }
+  std::vector<RooAbsArg*> dirtyNodes() const ;
+
+  void evaluateFunctions() ;
+  Double_t evaluate(const RooArgSet* nset=0) ;
+
+private:
+
+  friend class RooAbsArg ;
+
+  void markDirty(Int_t id, const RooAbsArg* source) ;
+  void nodeCleaned(Int_t id) ;
+  void invalidate() ;
+
+  static Bool_t testBit(const std::vector<ULong64_t>& bits, Int_t id) { return (bits[id>>6] >> (id&63)) & 1 ; }
+  static void setBit(std::vector<ULong64_t>& bits, Int_t id) { bits[id>>6] |= (ULong64_t(1) << (id&63)) ; }
+  static void clearBit(std::vector<ULong64_t>& bits, Int_t id) { bits[id>>6] &= ~(ULong64_t(1) << (id&63)) ; }
+
+  RooAbsArg* _top ;                    // Node on which the graph was compiled
+  std::vector<RooAbsArg*> _nodes ;     // Nodes in evaluation order (servers before clients)
+  std::vector<RooAbsReal*> _functions ; // Nodes that are real-valued functions but not p.d.f.s, null otherwise
+  std::vector<Int_t> _clientBegin ;    // Start of the value clients of each node in _clients
+  std::vector<Int_t> _clients ;        // Ids of the value clients of all nodes
+  std::vector<ULong64_t> _dirty ;      // Nodes marked dirty and not evaluated since
+  std::vector<ULong64_t> _propagated ; // Nodes whose dirty state has been propagated since the last evaluation of any node
+  Bool_t _anyPropagated ;              // Some bit of _propagated is set
+  std::vector<Int_t> _stack ;          // Work list of markDirty()
+} ;
+
+#endif
@@ -19,14 +19,17 @@
 #include "RooHistPdf.h"
 #include "TVirtualFFT.h"
 class RooRealVar ;
+class RooChangeTracker ;
 
 #include <map>
+#include <memory>
+#include <vector>
 
 ///PDF for the numerical (FFT) convolution of two PDFs.
 class RooFFTConvPdf : public RooAbsCachedPdf {
 public:
 
-  RooFFTConvPdf() {
+  RooFFTConvPdf() : _reuseTransforms(kTRUE) {
     // coverity[UNINIT_CTOR]
   } ;
   RooFFTConvPdf(const char *name, const char *title, RooRealVar& convVar, RooAbsPdf& pdf1, RooAbsPdf& pdf2, Int_t ipOrder=2);
@@ -56,6 +59,15 @@ public:
   void setBufferStrategy(BufStrat bs) ;
   void setBufferFraction(Double_t frac) ;
 
+  void setReuseTransforms(Bool_t flag) {
+    // Keep the Fourier transform of an input p.d.f. until its parameters change
+    _reuseTransforms = flag ;
+  }
+  Bool_t reuseTransforms() const { return _reuseTransforms ; }
+
+  struct FFTPlans ; // Forward and backward transforms of a given size
+  const FFTPlans* fftPlans(const RooArgSet* nset=0) const ;
+
   void printMetaArgs(std::ostream& os) const ;
 
   // Propagate maximum value estimate of pdf1 as convolution can only result in lower max values
@@ -83,13 +95,20 @@ protected:
 
     virtual RooArgList containedArgs(Action) ;
 
-    TVirtualFFT* fftr2c1 ;
-    TVirtualFFT* fftr2c2 ;
-    TVirtualFFT* fftc2r ;
+    std::shared_ptr<FFTPlans> plans ; // Transforms, shared by all cache elements with the same number of sampling points
 
     RooAbsPdf* pdf1Clone ;
     RooAbsPdf* pdf2Clone ;
 
+    RooChangeTracker* tracker1 ; // Tracks the parameters of pdf1Clone
+    RooChangeTracker* tracker2 ; // Tracks the parameters of pdf2Clone
+
+    std::vector<std::vector<Double_t> > spectrum1 ; // Transform of the sampling of pdf1Clone in each slice (re,im pairs)
+    std::vector<std::vector<Double_t> > spectrum2 ; // Transform of the sampling of pdf2Clone in each slice (re,im pairs)
+    std::vector<Int_t> zeroBin1 ; // Position of the zero bin in the sampling of pdf1Clone in each slice
+    Int_t nBins ;  // Number of bins of the convolution observable
+    Int_t nBins2 ; // Number of sampling points including the buffers
+
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
 
@@ -103,7 +122,7 @@ protected:
   virtual RooArgSet* actualParameters(const RooArgSet& nset) const ;
   virtual RooAbsArg& pdfObservable(RooAbsArg& histObservable) const ;
   virtual void fillCacheObject(PdfCacheElem& cache) const ;
-  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition) const ;
+  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition, Int_t slice=0) const ;
 
   virtual PdfCacheElem* createCache(const RooArgSet* nset) const ;
   virtual TString histNameSuffix() const ;
@@ -121,11 +140,13 @@ protected:
   friend class RooConvGenContext ;
   RooSetProxy  _cacheObs ; // Non-convolution observables that are also cached
 
+  Bool_t _reuseTransforms ; // Keep the transform of an input p.d.f. until its parameters change
+
 private:
 
   void prepareFFTBinning(RooRealVar& convVar) const;
 
-  ClassDef(RooFFTConvPdf,1) // Convolution operator p.d.f based on numeric Fourier transforms
+  ClassDef(RooFFTConvPdf,2) // Convolution operator p.d.f based on numeric Fourier transforms
 };
  
 #endif
@@ -194,6 +194,8 @@ RooCmdArg CloneData(Bool_t flag) ;
 RooCmdArg Integrate(Bool_t flag) ;
 RooCmdArg Minimizer(const char* type, const char* alg=0) ;
 RooCmdArg Offset(Bool_t flag=kTRUE) ;
+RooCmdArg BatchMode(Bool_t flag=kTRUE) ;
+RooCmdArg NumThreads(Int_t nThreads) ;
 
 // RooAbsPdf::paramOn arguments
 RooCmdArg Label(const char* str) ;
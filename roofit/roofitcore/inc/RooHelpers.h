@@ -18,8 +18,10 @@
 #define ROOFIT_ROOFITCORE_INC_ROOHELPERS_H_
 
 #include "RooMsgService.h"
+#include "TString.h"
 
 #include <sstream>
+#include <vector>
 
 namespace RooHelpers {
 
@@ -64,6 +66,28 @@ class HijackMessageStream : public std::ostringstream {
 
 std::vector<std::string> tokenise(const std::string &str, const std::string &delims);
 
+std::vector<UInt_t> seedSequence(Int_t n);
+
+
+/// Put the results of tasks run with ROOT::TProcessExecutor::Map() back into
+/// task order. The results arrive in the order in which the tasks finished, so
+/// each task has to name its result after its index. Results with an unknown
+/// or repeated index are deleted; a task without result leaves a null pointer.
+template <class T>
+std::vector<T*> orderTaskResults(const std::vector<T*>& results, UInt_t nTasks) {
+  std::vector<T*> ordered(nTasks, nullptr);
+  for (auto result : results) {
+    if (!result) continue;
+    const UInt_t iTask = TString(result->GetName()).Atoi();
+    if (iTask < nTasks && !ordered[iTask]) {
+      ordered[iTask] = result;
+    } else {
+      delete result;
+    }
+  }
+  return ordered;
+}
+
 }
 
 #endif /* ROOFIT_ROOFITCORE_INC_ROOHELPERS_H_ */
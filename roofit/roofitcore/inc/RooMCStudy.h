@@ -20,6 +20,7 @@
 #include "TNamed.h"
 #include "RooArgSet.h"
 #include <list>
+#include <vector>
 class RooAbsPdf;
 class RooDataSet ;
 class RooAbsData ;
@@ -54,6 +55,14 @@ public:
   Bool_t fit(Int_t nSamples, TList& dataSetList) ;
   Bool_t addFitResult(const RooFitResult& fr) ;
 
+  // Run generateAndFit() in local worker processes
+  void setNumWorkers(Int_t nWorkers) { _nWorkers = nWorkers ; }
+  void setSamplesPerTask(Int_t nSamples) { _samplesPerTask = nSamples ; }
+  void setSeedPerSample(Bool_t flag) { _seedPerSample = flag ; }
+  Int_t numWorkers() const { return _nWorkers ; }
+  Int_t samplesPerTask() const { return _samplesPerTask ; }
+  Bool_t seedPerSample() const { return _seedPerSample ; }
+
   // Result accessors
   const RooArgSet* fitParams(Int_t sampleNum) const ;
   const RooFitResult* fitResult(Int_t sampleNum) const ;
@@ -103,6 +112,9 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  void runSamples(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat, const UInt_t* seeds=0) ;
+  void runParallel(Int_t nSamples, Int_t nEvtPerSample) ;
+  void resetGenContexts() ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -118,6 +130,7 @@ protected:
 
   RooAbsPdf*        _constrPdf ;        // Constraints p.d.f
   RooAbsGenContext* _constrGenContext ; // Generator context for constraints p.d.f
+  RooArgSet         _constrGenParams ;  // Parameters generated from the constraints p.d.f
 
   RooArgSet    _dependents ;    // List of dependents 
   RooArgSet    _allDependents ; // List of generate + prototype dependents
@@ -142,6 +155,9 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  Int_t       _nWorkers         ; // Number of worker processes of generateAndFit()
+  Int_t       _samplesPerTask   ; // Number of samples per task sent to a worker process
+  Bool_t      _seedPerSample    ; // Seed the generator of each sample also when running in this process
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
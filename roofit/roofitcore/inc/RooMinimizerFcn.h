@@ -27,10 +27,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 class RooMinimizer;
 
-class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
+class RooMinimizerFcn : public ROOT::Math::IMultiGradFunction {
 
  public:
 
@@ -64,6 +66,17 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Int_t evalCounter() const { return _evalCounter ; }
   void zeroEvalCount() { _evalCounter = 0 ; }
 
+  void SetGradientWorkers(Int_t nWorkers);
+  Int_t GetGradientWorkers() const;
+  Int_t GetGradientCalculations() const;
+  void SynchronizeGradient(const std::vector<ROOT::Fit::ParameterSettings>& parameters,
+			   Int_t strategy, Double_t errorDef, Int_t optConst);
+
+  virtual void Gradient(const double *x, double *grad) const;
+  virtual bool HasG2ndDerivative() const;
+  virtual void G2ndDerivative(const double *x, double *g2) const;
+  virtual void GStepSize(const double *x, double *gstep) const;
+
 
  private:
   
@@ -77,8 +90,11 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
 
   virtual double DoEval(const double * x) const;  
+  virtual double DoDerivative(const double * x, unsigned int icoord) const;
   void updateFloatVec() ;
 
+  class NumericalGradient;
+
 private:
 
   mutable Int_t _evalCounter ;
@@ -101,6 +117,8 @@ private:
   RooArgList* _initFloatParamList;
   RooArgList* _initConstParamList;
 
+  std::shared_ptr<NumericalGradient> _gradient; //! Parallel numerical gradient calculation, shared with the copies
+
 };
 
 #endif
@@ -19,6 +19,7 @@
 #include "RooAbsOptTestStatistic.h"
 #include "RooCmdArg.h"
 #include "RooAbsPdf.h"
+#include <atomic>
 #include <vector>
 
 class RooRealSumPdf ;
@@ -27,7 +28,7 @@ class RooNLLVar : public RooAbsOptTestStatistic {
 public:
 
   // Constructors, assignment etc
-  RooNLLVar() { _first = kTRUE ; }
+  RooNLLVar() { _first = kTRUE ; _batchEvaluation = kFALSE ; _numBatchPartitions = 0 ; }
   RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooCmdArg& arg1=RooCmdArg::none(), const RooCmdArg& arg2=RooCmdArg::none(),const RooCmdArg& arg3=RooCmdArg::none(),
 	    const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),const RooCmdArg& arg6=RooCmdArg::none(),
@@ -49,12 +50,18 @@ public:
   virtual RooAbsTestStatistic* create(const char *name, const char *title, RooAbsReal& pdf, RooAbsData& adata,
 				      const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName=0, 
 				      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE, Bool_t binnedL=kFALSE) {
-    return new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL) ;
+    RooNLLVar* nll = new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL) ;
+    nll->_batchEvaluation = _batchEvaluation ;
+    nll->_compileDirtyGraph = _compileDirtyGraph ;
+    return nll ;
   }
   
   virtual ~RooNLLVar();
 
   void applyWeightSquared(Bool_t flag) ; 
+  void setBatchEvaluation(Bool_t flag) ;
+  Bool_t batchEvaluation() const { return _batchEvaluation ; }
+  Int_t numBatchPartitions() const ;
 
   virtual Double_t defaultErrorLevel() const { return 0.5 ; }
 
@@ -66,7 +73,11 @@ protected:
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  Bool_t evaluateBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+                                Double_t& sumWeight, Double_t& sumWeightCarry) const ;
   Bool_t _weightSq ; // Apply weights squared?
+  Bool_t _batchEvaluation ; //! Evaluate the p.d.f in batches of events?
+  mutable std::atomic<Int_t> _numBatchPartitions ; //! Number of partitions evaluated in batches
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
   Double_t _offsetCarrySaveW2; //!
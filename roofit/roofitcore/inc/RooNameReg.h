@@ -31,6 +31,8 @@ public:
   static const TNamed* ptr(const char* stringPtr) ;
   static const char* str(const TNamed* ptr) ;
   static const TNamed* known(const char* stringPtr) ;
+  static std::size_t renameCounter() ;
+  static void incrementRenameCounter() ;
 
   static void cleanup() ;
 
@@ -44,6 +46,7 @@ protected:
   RooNameReg(const RooNameReg& other) = delete;
 
   std::unordered_map<std::string,std::unique_ptr<TNamed>> _map;
+  std::size_t _renameCounter = 0; // Number of renames of RooAbsArg objects so far
 
 //  ClassDef(RooNameReg,1) // String name registry
 };
@@ -110,6 +110,19 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Compact storage of the real values in single precision and of the category state indices.
+  // The weights stay in double precision.
+  void setCompact(Bool_t flag=kTRUE) ;
+  Bool_t isCompact() const { return _compact ; }
+  std::size_t memoryUsage() const ;
+
+  // Class version of the columns written in compact form, unknown to the releases without it
+  enum { kCompactStreamerVersion = 0x3FF0 } ;
+
+  // Batch evaluation interface
+  void fillBatchInputs(RooAbsReal::BatchInputs& inputs) const ;
+  const Double_t* weightArray() const ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -135,12 +148,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _compact(kFALSE), _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _compact(kFALSE), _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
@@ -150,8 +163,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
+      _vec(other._vec), _vecF(other._vecF), _compact(other._compact), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
       } else {
@@ -177,6 +191,9 @@ public:
 	_vec = other._vec;
       }
       _vec0 = _vec.size()>0 ? &_vec.front() : 0;
+      _compact = other._compact;
+      _vecF = other._vecF;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0;
       return *this;
     }
     
@@ -212,13 +229,22 @@ public:
     }
 
     void fill() { 
+      if (_compact) {
+	_vecF.push_back(*_buf) ;
+	_vecF0 = &_vecF.front() ;
+	return ;
+      }
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
 
     void write(Int_t i) {
 /*         std::cout << "write(" << this << ") [" << i << "] nativeReal = " << _nativeReal << " = " << _nativeReal->GetName() << " real = " << _real << " buf = " << _buf << " value = " << *_buf << " native getVal() = " << _nativeReal->getVal() << " getVal() = " << _real->getVal() << std::endl ;  */
-      _vec[i] = *_buf ;
+      if (_compact) {
+	_vecF[i] = *_buf ;
+      } else {
+	_vec[i] = *_buf ;
+      }
     }
     
     void reset() { 
@@ -226,19 +252,49 @@ public:
       std::vector<Double_t> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
+      std::vector<Float_t> tmpF;
+      _vecF.swap(tmpF);
+      _vecF0 = 0;
     }
 
     inline void get(Int_t idx) const { 
-      *_buf = *(_vec0+idx) ; 
+      *_buf = _compact ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
     inline void getNative(Int_t idx) const { 
-      *_nativeBuf = *(_vec0+idx) ; 
+      *_nativeBuf = _compact ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _compact ? _vecF.size() : _vec.size() ; }
+
+    // Values in double precision, empty if the values are stored in single precision
+    const std::vector<Double_t>& data() const { return _vec ; }
+
+    Bool_t isCompact() const { return _compact ; }
+
+    void setCompact(Bool_t flag) {
+      // Convert the stored values to single (flag=kTRUE) or double precision
+      if (flag==_compact) return ;
+      if (flag) {
+	std::vector<Float_t> tmp(_vec.begin(),_vec.end()) ;
+	_vecF.swap(tmp) ;
+	std::vector<Double_t>().swap(_vec) ;
+      } else {
+	std::vector<Double_t> tmp(_vecF.begin(),_vecF.end()) ;
+	_vec.swap(tmp) ;
+	std::vector<Float_t>().swap(_vecF) ;
+      }
+      _compact = flag ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
+    }
 
     void resize(Int_t siz) {
+      if (_compact) {
+	_vecF.resize(siz) ;
+	_vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0 ;
+	return ;
+      }
       if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
 	// do an expensive copy, if we save at least a factor 2 in size
 	std::vector<Double_t> tmp;
@@ -255,12 +311,19 @@ public:
     }
 
     void reserve(Int_t siz) {
+      if (_compact) {
+	_vecF.reserve(siz);
+	_vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
+	return ;
+      }
       _vec.reserve(siz);
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
 
   protected:
     std::vector<Double_t> _vec ;
+    std::vector<Float_t> _vecF ; // Values in single precision, used instead of _vec in compact mode
+    Bool_t _compact ;            // Values are stored in single precision
 
   private:
     friend class RooVectorDataStore ;
@@ -269,9 +332,10 @@ public:
     Double_t* _buf ; //!
     Double_t* _nativeBuf ; //!
     Double_t* _vec0 ; //!
+    Float_t* _vecF0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
-    ClassDef(RealVector,1) // STL-vector-based Data Storage class
+    ClassDef(RealVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -461,13 +525,13 @@ public:
   class CatVector {
   public:
     CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
-      _cat(0), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(0), _buf(0), _nativeBuf(0), _compact(kFALSE), _vec0(0), _vecI0(0)
     {
       _vec.reserve(initialCapacity);
     }
 
     CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
-      _cat(cat), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(cat), _buf(0), _nativeBuf(0), _compact(kFALSE), _vec0(0), _vecI0(0)
     {
       _vec.reserve(initialCapacity);
     }
@@ -476,9 +540,10 @@ public:
     }
 
     CatVector(const CatVector& other, RooAbsCategory* cat=0) : 
-      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec) 
+      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec), _vecI(other._vecI), _compact(other._compact)
       {
 	_vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+	_vecI0 = _vecI.size()>0 ? &_vecI.front() : 0 ;
       }
 
     CatVector& operator=(const CatVector& other) {
@@ -495,6 +560,9 @@ public:
 	_vec = other._vec;
       }
       _vec0 = _vec.size()>0 ? &_vec.front() : 0;
+      _compact = other._compact;
+      _vecI = other._vecI;
+      _vecI0 = _vecI.size()>0 ? &_vecI.front() : 0;
       return *this;
     }
 
@@ -508,27 +576,75 @@ public:
     }
     
     void fill() { 
+      if (_compact) {
+	_vecI.push_back(_buf->getVal()) ;
+	_vecI0 = &_vecI.front() ;
+	return ;
+      }
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
     void write(Int_t i) { 
-      _vec[i]=*_buf ; 
+      if (_compact) {
+	_vecI[i]=_buf->getVal() ;
+      } else {
+	_vec[i]=*_buf ; 
+      }
     } ;
     void reset() { 
       // make sure the vector releases the underlying memory
       std::vector<RooCatType> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
+      std::vector<Int_t> tmpI;
+      _vecI.swap(tmpI);
+      _vecI0 = 0;
     }
     inline void get(Int_t idx) const { 
-      _buf->assignFast(*(_vec0+idx)) ;
+      if (_compact) {
+	_buf->assignFast(*(_vecI0+idx)) ;
+      } else {
+	_buf->assignFast(*(_vec0+idx)) ;
+      }
     }
     inline void getNative(Int_t idx) const { 
-      _nativeBuf->assignFast(*(_vec0+idx)) ;
+      if (_compact) {
+	_nativeBuf->assignFast(*(_vecI0+idx)) ;
+      } else {
+	_nativeBuf->assignFast(*(_vec0+idx)) ;
+      }
+    }
+    Int_t size() const { return _compact ? _vecI.size() : _vec.size() ; }
+
+    Bool_t isCompact() const { return _compact ; }
+
+    void setCompact(Bool_t flag) {
+      // Store the state indices only (flag=kTRUE) or the full RooCatType objects.
+      // The labels of the stored states are not used by get(), nothing is lost.
+      if (flag==_compact) return ;
+      if (flag) {
+	std::vector<Int_t> tmp ;
+	tmp.reserve(_vec.size()) ;
+	for (const auto& type : _vec) tmp.push_back(type.getVal()) ;
+	_vecI.swap(tmp) ;
+	std::vector<RooCatType>().swap(_vec) ;
+      } else {
+	std::vector<RooCatType> tmp(_vecI.size()) ;
+	for (size_t i=0 ; i<_vecI.size() ; i++) tmp[i].setVal(_vecI[i]) ;
+	_vec.swap(tmp) ;
+	std::vector<Int_t>().swap(_vecI) ;
+      }
+      _compact = flag ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecI0 = _vecI.size()>0 ? &_vecI.front() : 0 ;
     }
-    Int_t size() const { return _vec.size() ; }
 
     void resize(Int_t siz) {
+      if (_compact) {
+	_vecI.resize(siz) ;
+	_vecI0 = _vecI.size() > 0 ? &_vecI.front() : 0 ;
+	return ;
+      }
       if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
 	// do an expensive copy, if we save at least a factor 2 in size
 	std::vector<RooCatType> tmp;
@@ -545,6 +661,11 @@ public:
     }
 
     void reserve(Int_t siz) {
+      if (_compact) {
+	_vecI.reserve(siz);
+	_vecI0 = _vecI.size() > 0 ? &_vecI.front() : 0;
+	return ;
+      }
       _vec.reserve(siz);
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
@@ -558,8 +679,11 @@ public:
     RooCatType* _buf ;  //!
     RooCatType* _nativeBuf ;  //!
     std::vector<RooCatType> _vec ;
+    std::vector<Int_t> _vecI ;  // State indices, used instead of _vec in compact mode
+    Bool_t _compact ;           // Only the state indices are stored
     RooCatType* _vec0 ; //!
-    ClassDef(CatVector,1) // STL-vector-based Data Storage class
+    Int_t* _vecI0 ; //!
+    ClassDef(CatVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -587,6 +711,7 @@ public:
 
     // If nothing found this will make an entry
     _catStoreList.push_back(new CatVector(cat)) ;
+    _catStoreList.back()->setCompact(_compact) ;
     _nCat++ ;
 
     // Update cached ptr to first element as push_back may have reallocated
@@ -622,6 +747,7 @@ public:
 
     // If nothing found this will make an entry
     _realStoreList.push_back(new RealVector(real)) ;
+    _realStoreList.back()->setCompact(_compact && !isWeightColumn(real)) ;
     _nReal++ ;
 
     // Update cached ptr to first element as push_back may have reallocated
@@ -706,6 +832,7 @@ public:
 
     // If nothing found this will make an entry
     _realfStoreList.push_back(new RealFullVector(real)) ;
+    _realfStoreList.back()->setCompact(_compact && !isWeightColumn(real)) ;
     _nRealF++ ;
 
     // Update cached ptr to first element as push_back may have reallocated
@@ -728,6 +855,7 @@ public:
   std::vector<CatVector*> _catStoreList ;
 
   void setAllBuffersNative() ;
+  Bool_t isWeightColumn(const RooAbsArg* arg) const ;
 
   Int_t _nReal ;
   Int_t _nRealF ;
@@ -754,7 +882,9 @@ public:
 
   Bool_t _forcedUpdate ; //! Request for forced cache update 
 
-  ClassDef(RooVectorDataStore,2) // STL-vector-based Data Storage class
+  Bool_t _compact ; // Store the values of new columns in compact form
+
+  ClassDef(RooVectorDataStore,3) // STL-vector-based Data Storage class
 };
 
 
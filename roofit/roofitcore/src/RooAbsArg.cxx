@@ -64,6 +64,7 @@ setting/clearing/testing named attributes.
 #include "RooResolutionModel.h"
 #include "RooVectorDataStore.h"
 #include "RooTreeDataStore.h"
+#include "RooDirtyGraph.h"
 
 #include <sstream>
 #include <string.h>
@@ -92,7 +93,7 @@ std::stack<RooAbsArg*> RooAbsArg::_ioReadStack ;
 RooAbsArg::RooAbsArg()
    : TNamed(), _deleteWatch(kFALSE), _valueDirty(kTRUE), _shapeDirty(kTRUE), _operMode(Auto), _fast(kFALSE), _ownedComponents(nullptr),
      _prohibitServerRedirect(kFALSE), _eocache(0), _namePtr(0), _isConstant(kFALSE), _localNoInhibitDirty(kFALSE),
-     _myws(0)
+     _myws(0), _dirtyGraph(0), _dirtyGraphId(-1)
 {
   _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
 
@@ -106,7 +107,7 @@ RooAbsArg::RooAbsArg()
 RooAbsArg::RooAbsArg(const char *name, const char *title)
    : TNamed(name, title), _deleteWatch(kFALSE), _valueDirty(kTRUE), _shapeDirty(kTRUE), _operMode(Auto), _fast(kFALSE),
      _ownedComponents(0), _prohibitServerRedirect(kFALSE), _eocache(0), _namePtr(0), _isConstant(kFALSE),
-     _localNoInhibitDirty(kFALSE), _myws(0)
+     _localNoInhibitDirty(kFALSE), _myws(0), _dirtyGraph(0), _dirtyGraphId(-1)
 {
   _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
 }
@@ -119,7 +120,8 @@ RooAbsArg::RooAbsArg(const RooAbsArg &other, const char *name)
    : TNamed(other.GetName(), other.GetTitle()), RooPrintable(other), _boolAttrib(other._boolAttrib),
      _stringAttrib(other._stringAttrib), _deleteWatch(other._deleteWatch), _operMode(Auto), _fast(kFALSE),
      _ownedComponents(0), _prohibitServerRedirect(kFALSE), _eocache(other._eocache), _namePtr(other._namePtr),
-     _isConstant(other._isConstant), _localNoInhibitDirty(other._localNoInhibitDirty), _myws(0)
+     _isConstant(other._isConstant), _localNoInhibitDirty(other._localNoInhibitDirty), _myws(0),
+     _dirtyGraph(0), _dirtyGraphId(-1)
 {
   // Use name in argument, if supplied
   if (name) {
@@ -153,6 +155,8 @@ RooAbsArg::RooAbsArg(const RooAbsArg &other, const char *name)
 
 RooAbsArg::~RooAbsArg()
 {
+  invalidateDirtyGraph() ;
+
   // Notify all servers that they no longer need to serve us
   while (!_serverList.empty()) {
     removeServer(*_serverList.containedObjects().back(), kTRUE);
@@ -333,6 +337,9 @@ void RooAbsArg::addServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapeProp,
     setOperMode(ADirty) ;
   }
 
+  invalidateDirtyGraph() ;
+  server.invalidateDirtyGraph() ;
+
 
   // LM: use hash tables for larger lists
 //  if (_serverList.GetSize() > 999 && _serverList.getHashTableSize() == 0) _serverList.setHashTableSize(1000);
@@ -381,6 +388,9 @@ void RooAbsArg::removeServer(RooAbsArg& server, Bool_t force)
 			   << server.GetName() << "(" << &server << ")" << endl ;
   }
 
+  invalidateDirtyGraph() ;
+  server.invalidateDirtyGraph() ;
+
   // Remove server link to given server
   _serverList.Remove(&server, force) ;
 
@@ -419,6 +429,9 @@ void RooAbsArg::changeServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapePr
     return ;
   }
 
+  invalidateDirtyGraph() ;
+  server.invalidateDirtyGraph() ;
+
   // Remove all propagation links, then reinstall requested ones ;
   Int_t vcount = server._clientListValue.refCount(this) ;
   Int_t scount = server._clientListShape.refCount(this) ;
@@ -783,7 +796,16 @@ Bool_t RooAbsArg::observableOverlaps(const RooArgSet* nset, const RooAbsArg& tes
 
 void RooAbsArg::setValueDirty(const RooAbsArg* source) const
 {
-  if (_operMode!=Auto || _inhibitDirty) return ;
+  if (_inhibitDirty) return ;
+
+  // Propagation through a compiled graph, which also handles the objects
+  // that are not in the Auto operation mode
+  if (_dirtyGraph) {
+    _dirtyGraph->markDirty(_dirtyGraphId,source) ;
+    return ;
+  }
+
+  if (_operMode!=Auto) return ;
 
   // Handle no-propagation scenarios first
   if (_clientListValue.size() == 0) {
@@ -819,6 +841,27 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Inform the compiled graph this object belongs to that its value has been
+/// recalculated.
+
+void RooAbsArg::dirtyGraphNodeCleaned() const
+{
+  _dirtyGraph->nodeCleaned(_dirtyGraphId) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Detach all objects of the compiled graph this object belongs to, if any,
+/// from the graph. This is needed whenever the client-server structure or the
+/// operation mode of the object changes.
+
+void RooAbsArg::invalidateDirtyGraph() const
+{
+  if (_dirtyGraph) _dirtyGraph->invalidate() ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark this object as having changed its shape, and propagate this status
 /// change to all of our clients.
@@ -1682,6 +1725,8 @@ void RooAbsArg::setOperMode(OperMode mode, Bool_t recurseADirty)
   // Prevent recursion loops
   if (mode==_operMode) return ;
 
+  invalidateDirtyGraph() ;
+
   _operMode = mode ;
   _fast = ((mode==AClean) || dynamic_cast<RooRealVar*>(this)!=0 || dynamic_cast<RooConstVar*>(this)!=0 ) ;
   for (Int_t i=0 ;i<numCaches() ; i++) {
@@ -2247,6 +2292,7 @@ void RooAbsArg::SetName(const char* name)
     //cout << "Rename '" << _namePtr->GetName() << "' to '" << name << "' (set flag in new name)" << endl;
     _namePtr = newPtr;
     _namePtr->SetBit(RooNameReg::kRenamedArg);
+    RooNameReg::incrementRenameCounter();
   }
 }
 
@@ -2263,6 +2309,7 @@ void RooAbsArg::SetNameTitle(const char *name, const char *title)
     //cout << "Rename '" << _namePtr->GetName() << "' to '" << name << "' (set flag in new name)" << endl;
     _namePtr = newPtr;
     _namePtr->SetBit(RooNameReg::kRenamedArg);
+    RooNameReg::incrementRenameCounter();
   }
 }
 
@@ -44,6 +44,7 @@ implemented using the container denoted by RooAbsCollection::Storage_t.
 #include "RooRealVar.h"
 #include "RooGlobalFunc.h"
 #include "RooMsgService.h"
+#include "RooNameReg.h"
 #include <ROOT/RMakeUnique.hxx>
 
 #include <algorithm>
@@ -156,6 +157,7 @@ void RooAbsCollection::safeDeleteList()
         delete item;
       }
       _list.erase(newEnd, _list.end());
+      clearNameIndex() ;
     } while (!tmp.empty() && _list.size() > 1);
 
     // Check if there are any remaining elements
@@ -171,6 +173,7 @@ void RooAbsCollection::safeDeleteList()
     delete item;
   }
   _list.clear();
+  clearNameIndex() ;
 }
 
 
@@ -282,6 +285,7 @@ Bool_t RooAbsCollection::addServerClonesToList(const RooAbsArg& var)
       RooAbsArg* serverClone = (RooAbsArg*)server->Clone() ;
       serverClone->setAttribute("SnapShot_ExtRefClone") ;
       _list.push_back(serverClone) ;
+      addToNameIndex(serverClone) ;
       if (_allRRV && dynamic_cast<RooRealVar*>(serverClone)==0) {
         _allRRV=kFALSE ;
       }
@@ -389,6 +393,7 @@ Bool_t RooAbsCollection::addOwned(RooAbsArg& var, Bool_t silent)
   _ownCont= kTRUE;
 
   _list.push_back(&var);
+  addToNameIndex(&var) ;
   if (_allRRV && dynamic_cast<RooRealVar*>(&var)==0) {
     _allRRV=kFALSE ;
   }
@@ -416,7 +421,10 @@ RooAbsArg *RooAbsCollection::addClone(const RooAbsArg& var, Bool_t silent)
 
   // add a pointer to a clone of this variable to our list (we now own it!)
   auto clone2 = static_cast<RooAbsArg*>(var.Clone());
-  if (clone2) _list.push_back(clone2);
+  if (clone2) {
+    _list.push_back(clone2);
+    addToNameIndex(clone2) ;
+  }
   if (_allRRV && dynamic_cast<const RooRealVar*>(&var)==0) {
     _allRRV=kFALSE ;
   }
@@ -441,6 +449,7 @@ Bool_t RooAbsCollection::add(const RooAbsArg& var, Bool_t silent)
 
   // add a pointer to this variable to our list (we don't own it!)
   _list.push_back(const_cast<RooAbsArg*>(&var)); //FIXME
+  addToNameIndex(const_cast<RooAbsArg*>(&var)) ;
   if (_allRRV && dynamic_cast<const RooRealVar*>(&var)==0) {
     _allRRV=kFALSE ;
   }
@@ -560,6 +569,7 @@ Bool_t RooAbsCollection::replace(const RooAbsArg& var1, const RooAbsArg& var2)
 
   // replace var1 with var2
   *var1It = const_cast<RooAbsArg*>(&var2); //FIXME
+  clearNameIndex() ;
 
   if (_allRRV && dynamic_cast<const RooRealVar*>(&var2)==0) {
     _allRRV=kFALSE ;
@@ -604,7 +614,11 @@ Bool_t RooAbsCollection::remove(const RooAbsArg& var, Bool_t , Bool_t matchByNam
       delete arg;
   }
 
-  return sizeBefore != _list.size();
+  if (sizeBefore != _list.size()) {
+    clearNameIndex() ;
+    return kTRUE ;
+  }
+  return kFALSE ;
 }
 
 
@@ -639,6 +653,7 @@ void RooAbsCollection::removeAll()
   }
   else {
     _list.clear();
+    clearNameIndex() ;
   }
 }
 
@@ -791,6 +806,11 @@ RooAbsArg * RooAbsCollection::find(const char *name) const
 {
   if (!name)
     return nullptr;
+
+  if (_useNameIndex) {
+    const TNamed* nptr = RooNameReg::known(name);
+    return nptr ? findInNameIndex(nptr) : nullptr;
+  }
   
   decltype(_list)::const_iterator item;
 
@@ -824,6 +844,10 @@ RooAbsArg * RooAbsCollection::find(const char *name) const
 RooAbsArg * RooAbsCollection::find(const RooAbsArg& arg) const
 {
   const auto nptr = arg.namePtr();
+  if (_useNameIndex) {
+    return findInNameIndex(nptr);
+  }
+
   auto findByNamePtr = [nptr](const RooAbsArg * listItem) {
     return nptr == listItem->namePtr();
   };
@@ -835,6 +859,44 @@ RooAbsArg * RooAbsCollection::find(const RooAbsArg& arg) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make find() use an index of the elements by name pointer (see RooNameReg)
+/// instead of a linear search. This pays off for large collections in which
+/// many lookups are made, such as the contents of a RooWorkspace. The index
+/// is not persisted: it is built on the first lookup, kept up to date when
+/// elements are added, and rebuilt on the next lookup after elements were
+/// removed or replaced, or after any RooAbsArg has been renamed.
+/// If several elements have the same name, the first one is found, as in
+/// the linear search.
+
+void RooAbsCollection::useHashMapForFind(Bool_t flag) const
+{
+  _useNameIndex = flag ;
+  _nameIndex.reset() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up an element in the name index, building the index first if needed.
+
+RooAbsArg* RooAbsCollection::findInNameIndex(const TNamed* namePtr) const
+{
+  if (!_nameIndex || _nameIndexRenames != RooNameReg::renameCounter()) {
+    _nameIndex.reset(new NameIndex_t) ;
+    _nameIndex->reserve(_list.size()) ;
+    for (auto arg : _list) {
+      _nameIndex->emplace(arg->namePtr(),arg) ;
+    }
+    _nameIndexRenames = RooNameReg::renameCounter() ;
+  }
+
+  auto item = _nameIndex->find(namePtr) ;
+  return item != _nameIndex->end() ? item->second : nullptr ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return comma separated list of contained object names as STL string
 
@@ -260,6 +260,23 @@ void RooAbsData::convertToVectorStore()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the storage to the compact vector-based storage, in which the real
+/// values other than the weights are stored in single precision and the
+/// categories as state indices. See RooVectorDataStore::setCompact().
+
+void RooAbsData::convertToCompactStore()
+{
+   convertToVectorStore();
+   RooVectorDataStore *vstore = dynamic_cast<RooVectorDataStore *>(_dstore);
+   if (!vstore) {
+      coutW(InputArguments) << "RooAbsData::convertToCompactStore(" << GetName()
+                            << ") WARNING: only vector-based storage can be made compact" << endl;
+      return;
+   }
+   vstore->setCompact(kTRUE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t RooAbsData::changeObservableName(const char* from, const char* to)
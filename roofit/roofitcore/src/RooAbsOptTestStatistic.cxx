@@ -60,6 +60,7 @@ parallelized calculation of test statistics
 #include "RooRealSumPdf.h"
 #include "RooTrace.h"
 #include "RooVectorDataStore.h" 
+#include "RooDirtyGraph.h"
 
 using namespace std;
 
@@ -88,6 +89,8 @@ RooAbsOptTestStatistic:: RooAbsOptTestStatistic()
   _ownData = kTRUE ;
   _sealed = kFALSE ;
   _optimized = kFALSE ;
+  _funcGraph = 0 ;
+  _compileDirtyGraph = kFALSE ;
 }
 
 
@@ -112,7 +115,9 @@ RooAbsOptTestStatistic::RooAbsOptTestStatistic(const char *name, const char *tit
   RooAbsTestStatistic(name,title,real,indata,projDeps,rangeName, addCoefRangeName, nCPU, interleave, verbose, splitCutRange),
   _projDeps(0),
   _sealed(kFALSE), 
-  _optimized(kFALSE)
+  _optimized(kFALSE),
+  _funcGraph(0),
+  _compileDirtyGraph(kFALSE)
 {
   // Don't do a thing in master mode
 
@@ -140,7 +145,8 @@ RooAbsOptTestStatistic::RooAbsOptTestStatistic(const char *name, const char *tit
 /// Copy constructor
 
 RooAbsOptTestStatistic::RooAbsOptTestStatistic(const RooAbsOptTestStatistic& other, const char* name) : 
-  RooAbsTestStatistic(other,name), _sealed(other._sealed), _sealNotice(other._sealNotice), _optimized(kFALSE)
+  RooAbsTestStatistic(other,name), _sealed(other._sealed), _sealNotice(other._sealNotice), _optimized(kFALSE),
+  _funcGraph(0), _compileDirtyGraph(other._compileDirtyGraph)
 {
   // Don't do a thing in master mode
   if (operMode()!=Slave) {    
@@ -431,6 +437,7 @@ void RooAbsOptTestStatistic::initSlave(RooAbsReal& real, RooAbsData& indata, con
 RooAbsOptTestStatistic::~RooAbsOptTestStatistic()
 {
   if (operMode()==Slave) {
+    delete _funcGraph ;
     delete _funcClone ;
     delete _funcObsSet ;
     if (_projDeps) {
@@ -445,6 +452,56 @@ RooAbsOptTestStatistic::~RooAbsOptTestStatistic()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, the function clone of this test statistic, and the ones of
+/// its components, are compiled into RooDirtyGraph objects at their next
+/// evaluation. The dirty state of their nodes is then propagated over the flat
+/// graph rather than by walking the client lists recursively, which avoids
+/// visiting the nodes shared by several branches of the expression more than
+/// once per change of the observables or parameters, and the functions of the
+/// graph are evaluated in graph order before the function clone.
+
+void RooAbsOptTestStatistic::setDirtyGraphCompilation(Bool_t flag)
+{
+  _compileDirtyGraph = flag ;
+  if (_gofOpMode==SimMaster) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      static_cast<RooAbsOptTestStatistic*>(_gofArray[i])->setDirtyGraphCompilation(flag) ;
+  }
+  for (auto gof : _mtArray)
+    static_cast<RooAbsOptTestStatistic*>(gof)->setDirtyGraphCompilation(flag) ;
+  setValueDirty() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create, recompile or delete the dirty state propagation graph of the
+/// function clone, following the setting of setDirtyGraphCompilation().
+/// The graph detaches itself when the structure of the function changes, e.g.
+/// when normalization integrals are created or when the constant term
+/// optimization changes the operation mode of its nodes, and it is
+/// recompiled lazily here.
+
+void RooAbsOptTestStatistic::updateFuncGraph() const
+{
+  if (!_compileDirtyGraph) {
+    if (_funcGraph) {
+      delete _funcGraph ;
+      _funcGraph = 0 ;
+    }
+    return ;
+  }
+
+  if (!_funcGraph) {
+    _funcGraph = new RooDirtyGraph(*_funcClone) ;
+  } else if (!_funcGraph->isValid()) {
+    _funcGraph->compile() ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Method to combined test statistic results calculated into partitions into
 /// the global result. This default implementation adds the partition return
@@ -326,6 +326,45 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the p.d.f, normalized over the observables in
+/// normSet, in a batch of events (see RooAbsReal::getValBatch()).
+///
+/// The unnormalized values are computed by evaluateBatch() and divided by the
+/// normalization integral, as in getValV(). The batch is refused, to be
+/// evaluated event by event, if the normalization integral changes from event
+/// to event (conditional p.d.f) or if any value would raise an evaluation
+/// error, so that the errors are reported as usual.
+
+Bool_t RooAbsPdf::getValBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  if (inputs.column(*this) || !inputs.dependsOnEvent(*this)) {
+    return RooAbsReal::getValBatch(output, nEvents, inputs, normSet) ;
+  }
+
+  // Synchronize the normalization (and the caches of the p.d.f) for this
+  // normalization set, as in the evaluation of a single event
+  if (normSet) {
+    getVal(normSet) ;
+    if (!_norm || inputs.dependsOnEvent(*_norm)) return kFALSE ;
+  }
+
+  if (!evaluateBatch(output, nEvents, inputs, normSet)) return kFALSE ;
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    if (TMath::IsNaN(output[i]) || output[i]<0) return kFALSE ;
+  }
+  if (!normSet) return kTRUE ;
+
+  const Double_t normVal = _norm->getVal() ;
+  if (normVal<=0.) return kFALSE ;
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] /= normVal ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -766,6 +805,10 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 /// <tr><td> `CloneData(Bool flag)`           <td> Use clone of dataset in NLL (default is true)
 /// <tr><td> `Offset(Bool_t)`                 <td> Offset likelihood by initial value (so that starting value of FCN in minuit is zero).
 ///                                              This can improve numeric stability in simultaneously fits with components with large likelihood values
+/// <tr><td> `BatchMode(Bool_t)`              <td> Evaluate the p.d.f in batches of events instead of event by event (see RooNLLVar::setBatchEvaluation()).
+///                                              The likelihood value is identical, p.d.f.s not supporting it are evaluated event by event
+/// <tr><td> `NumThreads(int num)`            <td> Evaluate the NLL in num threads of the implicit multi-threading pool (see RooAbsTestStatistic::setNumThreads()).
+///                                              Each thread processes a partition of the events, cannot be combined with NumCPU
 /// </table>
 /// 
 /// 
@@ -815,6 +858,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineSet("glObs","GlobalObservables",0,0) ;
   pc.defineInt("constrAll","Constrained",0,0) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
+  pc.defineInt("nThreads","NumThreads",0,1) ;
   pc.defineSet("extCons","ExternalConstraints",0,0) ;
   pc.defineMutex("Range","RangeWithName") ;
   pc.defineMutex("Constrain","Constrained") ;
@@ -839,6 +884,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
   Int_t doOffset = pc.getInt("doOffset") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
+  Int_t nThreads = pc.getInt("nThreads") ;
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -918,6 +965,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
     nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    static_cast<RooNLLVar*>(nll)->setBatchEvaluation(batchMode) ;
+    static_cast<RooNLLVar*>(nll)->setNumThreads(nThreads) ;
 
   } else {
     // Composite case: multiple ranges
@@ -927,7 +976,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      nllComp->setBatchEvaluation(batchMode) ;
+      nllComp->setNumThreads(nThreads) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -1049,6 +1100,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 /// <tr><td> `ExternalConstraints(const RooArgSet& )`   <td>  Include given external constraints to likelihood
 /// <tr><td> `Offset(Bool_t)`                           <td>  Offset likelihood by initial value (so that starting value of FCN in minuit is zero).
 ///                                                         This can improve numeric stability in simultaneously fits with components with large likelihood values
+/// <tr><td> `BatchMode(Bool_t)`                        <td>  Evaluate the p.d.f in batches of events in the likelihood (see RooNLLVar::setBatchEvaluation())
+/// <tr><td> `NumThreads(int num)`                      <td>  Evaluate the likelihood in num threads (see RooAbsTestStatistic::setNumThreads())
 ///
 /// <tr><th><th> Options to control flow of fit procedure
 /// <tr><td> `Minimizer(type,algo)`   <td>  Choose minimization package and algorithm to use. Default is MINUIT/MIGRAD through the RooMinimizer interface,
@@ -1120,7 +1173,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode,NumThreads") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
@@ -1139,6 +1192,8 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("doWarn","Warnings",0,1) ;
   pc.defineInt("doSumW2","SumW2Error",0,-1) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
+  pc.defineInt("nThreads","NumThreads",0,1) ;
   pc.defineString("mintype","Minimizer",0,"Minuit") ;
   pc.defineString("minalg","Minimizer",1,"minuit") ;
   pc.defineObject("minosSet","Minos",0,0) ;
@@ -1492,7 +1547,7 @@ RooFitResult* RooAbsPdf::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdLi
 
   // Pull arguments to be passed to chi2 construction from list
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,Optimize,ProjectedObservables,AddCoefRange,SplitRange,DataError,Extended") ;
+  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,NumThreads,Optimize,ProjectedObservables,AddCoefRange,SplitRange,DataError,Extended") ;
 
   RooAbsReal* chi2 = createChi2(data,chi2CmdList) ;
   RooFitResult* ret = chi2FitDriver(*chi2,fitCmdList) ;
@@ -1519,6 +1574,7 @@ RooFitResult* RooAbsPdf::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdLi
 ///                             - Poisson interval [RooAbsData::Poisson]
 ///                             - Default: Expected error for unweighted data, Sum-of-weights for weighted data [RooAbsData::Auto]
 /// <tr><td> `NumCPU()`     <td>  Activate parallel processing feature
+/// <tr><td> `NumThreads()` <td>  Activate multi-threaded evaluation
 /// <tr><td> `Range()`      <td>  Fit only selected region
 /// <tr><td> `SumCoefRange()` <td>  Set the range in which to interpret the coefficients of RooAddPdf components 
 /// <tr><td> `SplitRange()`   <td>  Fit range is split by index category of simultaneous PDF
@@ -104,6 +104,8 @@
 #include "TVector.h"
 
 #include <sstream>
+#include <algorithm>
+#include <mutex>
 
 using namespace std ;
 
@@ -265,6 +267,69 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this object in a batch of nEvents consecutive events
+/// and write them into output. This is the batch equivalent of getVal(normSet):
+/// instead of loading each event into the observables and walking the
+/// expression tree once per event, each node of the tree computes the values
+/// of all the events in one go from the arrays of values of the observables
+/// (see BatchInputs) and of its servers.
+///
+/// The values are taken directly from the dataset if it stores this object,
+/// and are all equal to getVal(normSet) if this object does not depend on any
+/// observable. Otherwise they are computed by evaluateBatch().
+///
+/// \return kFALSE if the batch cannot be computed, e.g. because a node of the
+/// expression tree does not implement evaluateBatch(). The caller should then
+/// evaluate the events one by one.
+
+Bool_t RooAbsReal::getValBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  const Double_t* column = inputs.column(*this) ;
+  if (column) {
+    std::copy(column, column + nEvents, output) ;
+    return kTRUE ;
+  }
+  if (!inputs.dependsOnEvent(*this)) {
+    std::fill(output, output + nEvents, getVal(normSet)) ;
+    return kTRUE ;
+  }
+  return evaluateBatch(output, nEvents, inputs, normSet) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch equivalent of evaluate(), used by getValBatch(): compute the values of
+/// this object in the nEvents events of the batch. The values of the servers
+/// should be obtained with getServerBatch().
+///
+/// Classes override this function to support batch evaluation. The default
+/// implementation returns kFALSE: batch evaluation is not supported.
+
+Bool_t RooAbsReal::evaluateBatch(Double_t* /*output*/, Int_t /*nEvents*/, const BatchInputs& /*inputs*/, const RooArgSet* /*normSet*/) const
+{
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the values of a server in a batch of events for evaluateBatch(). On
+/// return, values points either to the array of the dataset storing the
+/// server, or to buffer, which is resized and filled by the batch evaluation
+/// of the server.
+/// \return kFALSE if the server does not support batch evaluation.
+
+Bool_t RooAbsReal::getServerBatch(const RooAbsReal& server, std::vector<Double_t>& buffer, const Double_t*& values,
+                                  Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  values = inputs.column(server) ;
+  if (values) return kTRUE ;
+  buffer.resize(nEvents) ;
+  values = buffer.data() ;
+  return server.getValBatch(buffer.data(), nEvents, inputs, normSet) ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3605,6 +3670,18 @@ Double_t RooAbsReal::maxVal(Int_t /*code*/) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Mutex protecting the static list and counter of evaluation errors, which are
+/// logged concurrently by the test statistics evaluated in several threads.
+
+static std::recursive_mutex& evalErrorMutex()
+{
+  static std::recursive_mutex mutex ;
+  return mutex ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to insert remote error logging messages received by RooRealMPFE into current error loggin stream
 
@@ -3614,6 +3691,8 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3669,6 +3748,8 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -4292,6 +4373,7 @@ RooMultiGenFunction* RooAbsReal::iGenFunction(const RooArgSet& observables, cons
 /// <tr><td> `Range(Double_t lo, Double_t hi)` <td> Fit only data inside given range. A range named "fit" is created on the fly on all observables.
 ///                                               Multiple comma separated range names can be specified.
 /// <tr><td> `NumCPU(int num)`                 <td> Parallelize NLL calculation on num CPUs
+/// <tr><td> `NumThreads(int num)`             <td> Evaluate the \f$ \chi^2 \f$ in num threads
 /// <tr><td> `Optimize(Bool_t flag)`           <td> Activate constant term optimization (on by default)
 ///
 /// <tr><th> <th> Options to control flow of fit procedure
@@ -4341,7 +4423,7 @@ RooFitResult* RooAbsReal::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdL
 
   // Pull arguments to be passed to chi2 construction from list
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,Optimize") ;
+  RooLinkedList chi2CmdList = pc.filterCmdList(fitCmdList,"Range,RangeWithName,NumCPU,NumThreads,Optimize") ;
 
   RooAbsReal* chi2 = createChi2(data,chi2CmdList) ;
   RooFitResult* ret = chi2FitDriver(*chi2,fitCmdList) ;
@@ -4363,6 +4445,7 @@ RooFitResult* RooAbsReal::chi2FitTo(RooDataHist& data, const RooLinkedList& cmdL
 ///  |-|-----------------------------------------
 ///  | `DataError(RooAbsData::ErrorType)`  | Choose between Poisson errors and Sum-of-weights errors
 ///  | `NumCPU(Int_t)`                     | Activate parallel processing feature on N processes
+///  | `NumThreads(Int_t)`                 | Activate multi-threaded evaluation in N threads
 ///  | `Range()`                           | Calculate \f$ \chi^2 \f$ only in selected region
 ///
 /// \param data Histogram with data
@@ -51,6 +51,9 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 #include <string>
 
 using namespace std;
@@ -64,7 +67,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _nThreads(1), _mtExecutor(0), _mtWarm(kFALSE), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -102,6 +105,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _nThreads(1),
+  _mtExecutor(0),
+  _mtWarm(kFALSE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -161,6 +167,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _nThreads(other._nThreads),
+  _mtExecutor(0),
+  _mtWarm(kFALSE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -216,6 +225,11 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  for (auto gof : _mtArray) delete gof ;
+#ifdef R__USE_IMT
+  delete _mtExecutor ;
+#endif
+
   delete _projDeps ;
 
 }
@@ -289,20 +303,23 @@ Double_t RooAbsTestStatistic::evaluate() const
 
   } else {
 
-    // Evaluate as straight FUNC
+    // Evaluate as straight FUNC. In multi-threaded mode this object
+    // calculates the last partition, the clones all the others
     Int_t nFirst(0), nLast(_nEvents), nStep(1) ;
+    const Int_t partNum = _mtArray.empty() ? _setNum : _nThreads - 1 ;
+    const Int_t numParts = _mtArray.empty() ? _numSets : _nThreads ;
     
     switch (_mpinterl) {
     case RooFit::BulkPartition:
-      nFirst = _nEvents * _setNum / _numSets ;
-      nLast  = _nEvents * (_setNum+1) / _numSets ;
+      nFirst = _nEvents * partNum / numParts ;
+      nLast  = _nEvents * (partNum+1) / numParts ;
       nStep  = 1 ;
       break;
       
     case RooFit::Interleave:
-      nFirst = _setNum ;
+      nFirst = partNum ;
       nLast  = _nEvents ;
-      nStep  = _numSets ;
+      nStep  = numParts ;
       break ;
       
     case RooFit::SimComponents:
@@ -316,7 +333,7 @@ Double_t RooAbsTestStatistic::evaluate() const
       break ;
     }
 
-    Double_t ret = evaluatePartition(nFirst,nLast,nStep);
+    Double_t ret = _mtArray.empty() ? evaluatePartition(nFirst,nLast,nStep) : evaluateThreaded(nFirst,nLast,nStep) ;
 
     if (numSets()==1) {
       const Double_t norm = globalNormalization();
@@ -344,6 +361,8 @@ Bool_t RooAbsTestStatistic::initialize()
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (_nThreads > 1) {
+    initMTMode() ;
   }
   _init = kTRUE;
   return kFALSE;
@@ -372,6 +391,10 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
       }
     }
   }
+  // Forward to clones of multi-threaded mode
+  for (auto gof : _mtArray) {
+    gof->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+  }
   return kFALSE;
 }
 
@@ -421,6 +444,12 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (!_mtArray.empty()) {
+    // The caches of the clones change, the next evaluation is sequential
+    for (auto gof : _mtArray) {
+      gof->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtWarm = kFALSE ;
   }
 }
 
@@ -478,6 +507,113 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create a clone of this test statistic,
+/// with its own copy of the function and the data, for all but one of the event partitions.
+/// The last partition is calculated by this object and all partitions are evaluated
+/// concurrently on the implicit multi-threading pool of ROOT.
+
+void RooAbsTestStatistic::initMTMode()
+{
+#ifdef R__USE_IMT
+  if (_numSets != 1 || (_mpinterl != RooFit::BulkPartition && _mpinterl != RooFit::Interleave)) {
+    coutW(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") multi-threaded evaluation is only supported for "
+		<< "bulk or interleaved partitioning in a single process, evaluating in one thread" << endl ;
+    _nThreads = 1 ;
+    return ;
+  }
+
+  for (Int_t i = 0; i < _nThreads - 1; ++i) {
+    RooAbsTestStatistic* gof = static_cast<RooAbsTestStatistic*>(clone(Form("%s_MT%d",GetName(),i))) ;
+    gof->_nThreads = 1 ;
+    gof->setMPSet(i,_nThreads) ;
+    gof->setSimCount(_simCount) ;
+    gof->setEventCount(_nEvents) ;
+    _mtArray.push_back(gof) ;
+  }
+  _mtExecutor = new ROOT::TThreadExecutor(_nThreads) ;
+  _mtWarm = kFALSE ;
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: evaluating " << GetName() << " in " << _nThreads << " threads" << endl ;
+#else
+  coutW(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") ROOT was built without implicit multi-threading "
+	      << "support, evaluating in one thread" << endl ;
+  _nThreads = 1 ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the partitions of the multi-threaded mode concurrently and combine
+/// them, in a fixed order, with a Kahan summation. The range [nFirst,nLast) with
+/// step nStep is the partition calculated by this object.
+///
+/// The first evaluation after an initialization or a change of the constant term
+/// optimization is sequential, as the functions lazily create their caches
+/// (normalization integrals, cached p.d.f.s) when first evaluated.
+
+Double_t RooAbsTestStatistic::evaluateThreaded(Int_t nFirst, Int_t nLast, Int_t nStep) const
+{
+  const UInt_t nParts = _mtArray.size() + 1 ;
+  std::vector<Double_t> values(nParts), carries(nParts) ;
+
+  auto evalPart = [&](UInt_t i) {
+    if (i < _mtArray.size()) {
+      values[i] = _mtArray[i]->getVal() ;
+      carries[i] = _mtArray[i]->getCarry() ;
+    } else {
+      values[i] = evaluatePartition(nFirst,nLast,nStep) ;
+      carries[i] = getCarry() ;
+    }
+  } ;
+
+#ifdef R__USE_IMT
+  if (_mtWarm && _mtExecutor) {
+    _mtExecutor->Foreach(evalPart, nParts) ;
+  } else {
+    for (UInt_t i = 0; i < nParts; ++i) evalPart(i) ;
+    _mtWarm = kTRUE ;
+  }
+#else
+  for (UInt_t i = 0; i < nParts; ++i) evalPart(i) ;
+#endif
+
+  Double_t sum = 0., carry = 0. ;
+  for (UInt_t i = 0; i < nParts; ++i) {
+    Double_t y = values[i] ;
+    carry += carries[i] ;
+    y -= carry ;
+    const Double_t t = sum + y ;
+    carry = (t - sum) - y ;
+    sum = t ;
+  }
+  _evalCarry = carry ;
+  return sum ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the test statistic in nThreads threads, see initMTMode(). This must be
+/// called before the first evaluation and is ignored for the multi-process mode.
+
+void RooAbsTestStatistic::setNumThreads(Int_t nThreads)
+{
+  if (_init) {
+    coutW(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") cannot change the number of threads "
+		<< "after initialization, ignored" << endl ;
+    return ;
+  }
+  if (MPMaster == _gofOpMode && nThreads > 1) {
+    coutW(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") multi-threaded evaluation cannot be "
+		<< "combined with multiple processes, ignored" << endl ;
+    return ;
+  }
+  _nThreads = nThreads > 1 ? nThreads : 1 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -563,6 +699,7 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 			      rangeName,addCoefRangeName,_nCPU,_mpinterl,_verbose,_splitRange,binnedL);
       }
       _gofArray[n]->setSimCount(_nGof);
+      _gofArray[n]->setNumThreads(_nThreads);
       // *** END HERE
 
       // Fill per-component split mode with Bulk Partition for now so that Auto will map to bulk-splitting of all components
@@ -623,7 +760,11 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
 
   switch(operMode()) {
   case Slave:
-    // Delegate to implementation
+    // Delegate to implementation, the clones of the multi-threaded mode need their own copy
+    for (auto gof : _mtArray) {
+      gof->setDataSlave(indata, kTRUE);
+    }
+    _mtWarm = kFALSE ;
     return setDataSlave(indata, cloneData);
   case SimMaster:
     // Forward to slaves
@@ -680,6 +821,9 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _offset = 0 ;
       _offsetCarry = 0;
     }
+    for (auto gof : _mtArray) {
+      gof->enableOffsetting(flag);
+    }
     setValueDirty() ;
     break ;
   case SimMaster:
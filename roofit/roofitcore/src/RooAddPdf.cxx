@@ -836,6 +836,54 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): sum the batch values of the component p.d.f.s
+/// weighted by the coefficients. The coefficients must be the same for all the
+/// events of the batch.
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  const RooArgSet* nset = normSet ;
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  for (auto arg : _coefList) {
+    if (inputs.dependsOnEvent(*arg)) return kFALSE ;
+  }
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  std::fill(output, output + nEvents, 0.) ;
+  std::vector<Double_t> buffer ;
+  const Double_t* pdfVal ;
+  Int_t i(0) ;
+  for (auto arg : _pdfList) {
+    auto pdf = static_cast<RooAbsPdf*>(arg);
+    const Double_t coef = _coefCache[i] ;
+    const RooAbsReal* snorm = cache->_needSupNorm ? static_cast<const RooAbsReal*>(cache->_suppNormList.at(i)) : 0 ;
+    i++ ;
+    if (!pdf->isSelectedComp()) continue ;
+    if (!getServerBatch(*pdf, buffer, pdfVal, nEvents, inputs, nset)) return kFALSE ;
+    if (snorm) {
+      if (inputs.dependsOnEvent(*snorm)) return kFALSE ;
+      const Double_t snormVal = snorm->getVal() ;
+      for (Int_t j=0 ; j<nEvents ; j++) {
+        output[j] += pdfVal[j]*coef/snormVal ;
+      }
+    } else {
+      for (Int_t j=0 ; j<nEvents ; j++) {
+        output[j] += pdfVal[j]*coef ;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
@@ -72,6 +72,17 @@ void RooArgSet::cleanup() { }
 #else
 
 #include "MemPoolForRooSets.h"
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mutex protecting the memory pool, as RooArgSets are created and deleted
+/// concurrently by test statistics evaluated in several threads. It is leaked
+/// like the pool, which can outlive the static objects.
+
+static std::mutex& memPoolMutex() {
+  static auto * mutex = new std::mutex();
+  return *mutex;
+}
 
 RooArgSet::MemPool* RooArgSet::memPool() {
   RooSentinel::activate();
@@ -105,6 +116,7 @@ void* RooArgSet::operator new (size_t bytes)
   //This will fail if a derived class uses this operator
   assert(sizeof(RooArgSet) == bytes);
 
+  std::lock_guard<std::mutex> lock(memPoolMutex());
   return memPool()->allocate(bytes);
 }
 
@@ -126,8 +138,11 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 void RooArgSet::operator delete (void* ptr)
 {
   // Decrease use count in pool that ptr is on
-  if (memPool()->deallocate(ptr))
-    return;
+  {
+    std::lock_guard<std::mutex> lock(memPoolMutex());
+    if (memPool()->deallocate(ptr))
+      return;
+  }
 
   std::cerr << __func__ << " " << ptr << " is not in any of the pools." << std::endl;
 
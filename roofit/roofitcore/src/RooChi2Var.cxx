@@ -39,6 +39,7 @@
 #include "Riostream.h"
 
 #include "RooRealVar.h"
+#include "RooDirtyGraph.h"
 #include "RooAbsDataStore.h"
 
 
@@ -67,12 +68,14 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsReal& func, Ro
   //
   //  DataError()  -- Choose between Poisson errors and Sum-of-weights errors
   //  NumCPU()     -- Activate parallel processing feature
+  //  NumThreads() -- Activate multi-threaded evaluation
   //  Range()      -- Fit only selected region
   //  Verbose()    -- Verbose output of GOF framework
 {
   RooCmdConfig pc("RooChi2Var::RooChi2Var") ;
   pc.defineInt("etype","DataError",0,(Int_t)RooDataHist::Auto) ;  
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("nThreads","NumThreads",0,1) ;
   pc.allowUndefined() ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
@@ -89,6 +92,7 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsReal& func, Ro
   if (_etype==RooAbsData::Auto) {
     _etype = hdata.isNonPoissonWeighted()? RooAbsData::SumW2 : RooAbsData::Expected ;
   }
+  setNumThreads(pc.getInt("nThreads")) ;
 
 }
 
@@ -114,6 +118,7 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsPdf& pdf, RooD
   //  Extended()   -- Include extended term in calculation
   //  DataError()  -- Choose between Poisson errors and Sum-of-weights errors
   //  NumCPU()     -- Activate parallel processing feature
+  //  NumThreads() -- Activate multi-threaded evaluation
   //  Range()      -- Fit only selected region
   //  SumCoefRange() -- Set the range in which to interpret the coefficients of RooAddPdf components 
   //  SplitRange() -- Fit range is split by index catory of simultaneous PDF
@@ -123,6 +128,7 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsPdf& pdf, RooD
   RooCmdConfig pc("RooChi2Var::RooChi2Var") ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
   pc.defineInt("etype","DataError",0,(Int_t)RooDataHist::Auto) ;  
+  pc.defineInt("nThreads","NumThreads",0,1) ;
   pc.allowUndefined() ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
@@ -134,6 +140,7 @@ RooChi2Var::RooChi2Var(const char *name, const char* title, RooAbsPdf& pdf, RooD
   if (_etype==RooAbsData::Auto) {
     _etype = hdata.isNonPoissonWeighted()? RooAbsData::SumW2 : RooAbsData::Expected ;
   }
+  setNumThreads(pc.getInt("nThreads")) ;
 }
 
 
@@ -224,6 +231,8 @@ Double_t RooChi2Var::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t
   Int_t i ;
   Double_t result(0), carry(0);
 
+  updateFuncGraph() ;
+
   _dataClone->store()->recalculateCache( _projDeps, firstEvent, lastEvent, stepSize, kFALSE) ;
 
 
@@ -246,7 +255,8 @@ Double_t RooChi2Var::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t
 
     const Double_t nData = hdata->weight() ;
 
-    const Double_t nPdf = _funcClone->getVal(_normSet) * normFactor * hdata->binVolume() ;
+    const Double_t funcVal = _funcGraph ? _funcGraph->evaluate(_normSet) : _funcClone->getVal(_normSet) ;
+    const Double_t nPdf = funcVal * normFactor * hdata->binVolume() ;
 
     const Double_t eExt = nPdf-nData ;
 
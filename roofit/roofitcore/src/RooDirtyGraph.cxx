@@ -0,0 +1,313 @@
+// @(#)root/roofitcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\file RooDirtyGraph.cxx
+\class RooDirtyGraph
+\ingroup Roofitcore
+
+RooDirtyGraph compiles the expression graph below a node into a flat
+structure in which dirty state propagation does not need to walk the client
+lists of the RooAbsArg objects recursively.
+
+The derived value servers of the top node are numbered in a topological
+order (servers before clients), and the value client links between them
+are stored as arrays of integer ids. Two bitsets are kept: the nodes that
+have been marked dirty and not evaluated since, and the nodes whose dirty
+state has already been propagated to their clients. When a server
+(typically a parameter) changes, RooAbsArg::setValueDirty() hands the
+propagation over to the graph, which marks the downstream nodes without
+visiting any node twice. When several parameters are changed in a row, as
+the minimisers do before each function call, the nodes that are common to
+the downstream sets are visited only once.
+
+Only the nodes all of whose value clients belong to the graph are compiled
+in, so that all propagation paths leaving the graph go through the top
+node. The others keep the usual recursive propagation, and so do the nodes
+that are already part of another graph. The graph detaches itself (see
+isValid()) when the structure of the compiled nodes changes or when their
+operation mode changes; compile() has to be called again in that case.
+
+Nodes in the ADirty operation mode are recalculated at every access and
+have no dirty state of their own. Unlike the recursive propagation, which
+stops at them, the graph propagates through them, such that the nodes in the
+Auto mode downstream of them are still marked. They are however never marked
+dirty themselves, nor reported by dirtyNodes() or evaluated by
+evaluateFunctions(). This matters for the function of a likelihood: after
+the caching optimisation of the test statistics (see
+RooAbsOptTestStatistic::optimizeCaching()), every node that depends on an
+observable, including the top node, is in the ADirty mode and is evaluated
+for each event by the likelihood itself. What the graph marks and evaluates
+is then limited to the parameter-only subtrees, for example a RooFormulaVar
+of parameters feeding a p.d.f., which evaluateFunctions() evaluates before
+the loop over the events.
+
+evaluate() walks the dirty nodes in the compiled order and evaluates the
+real-valued functions among them before evaluating the top node, such that
+the top node finds its servers clean; evaluateFunctions() does the same for
+callers evaluating the top node themselves, like RooNLLVar with getLogVal().
+P.d.f.s are left to be evaluated by their clients, as their value depends on
+the normalisation set requested by the client.
+
+The graph must not outlive its top node.
+**/
+
+#include "RooDirtyGraph.h"
+
+#include "RooAbsArg.h"
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+#include "RooMsgService.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using namespace std ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the graph of the derived value servers of top.
+
+RooDirtyGraph::RooDirtyGraph(RooAbsArg& top) :
+  _top(&top), _anyPropagated(kFALSE)
+{
+  compile() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor. The nodes go back to the recursive dirty state propagation.
+
+RooDirtyGraph::~RooDirtyGraph()
+{
+  invalidate() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// (Re)compile the graph below the top node and attach its nodes to it.
+
+void RooDirtyGraph::compile()
+{
+  invalidate() ;
+
+  // Collect the derived value servers of the top node in post order, which is
+  // a topological order of the graph
+  vector<RooAbsArg*> order ;
+  unordered_set<const RooAbsArg*> visited ;
+  vector<pair<RooAbsArg*,size_t> > stack ;
+  stack.push_back(make_pair(_top,size_t(0))) ;
+  visited.insert(_top) ;
+  while (!stack.empty()) {
+    RooAbsArg* arg = stack.back().first ;
+    const size_t next = stack.back().second ;
+    const auto& servers = arg->servers().containedObjects() ;
+    if (next<servers.size()) {
+      stack.back().second++ ;
+      RooAbsArg* server = servers[next] ;
+      if (server->isDerived() && server->valueClients().containsByPointer(arg) && visited.insert(server).second) {
+        stack.push_back(make_pair(server,size_t(0))) ;
+      }
+    } else {
+      order.push_back(arg) ;
+      stack.pop_back() ;
+    }
+  }
+
+  // Keep the nodes all of whose value clients are kept. Clients come after
+  // their servers in the order, so a single backward pass is enough.
+  unordered_map<const RooAbsArg*,Int_t> position ;
+  for (size_t i=0 ; i<order.size() ; i++) {
+    position[order[i]] = i ;
+  }
+  vector<char> keep(order.size(),0) ;
+  for (Int_t i=order.size()-1 ; i>=0 ; i--) {
+    RooAbsArg* arg = order[i] ;
+    if (arg->_dirtyGraph || !arg->isDerived()) continue ;
+    Bool_t closed(kTRUE) ;
+    if (arg!=_top) {
+      for (const auto client : arg->valueClients()) {
+        auto iter = position.find(client) ;
+        if (iter==position.end() || !keep[iter->second]) {
+          closed = kFALSE ;
+          break ;
+        }
+      }
+    }
+    keep[i] = closed ;
+  }
+  if (order.empty() || !keep.back()) {
+    oocoutW(_top,Optimization) << "RooDirtyGraph::compile(" << _top->GetName() << ") the top node is not a derived object "
+                                << "or already belongs to another graph, no graph compiled" << endl ;
+    return ;
+  }
+
+  unordered_map<const RooAbsArg*,Int_t> ids ;
+  for (size_t i=0 ; i<order.size() ; i++) {
+    if (!keep[i]) continue ;
+    ids[order[i]] = _nodes.size() ;
+    _nodes.push_back(order[i]) ;
+  }
+
+  const Int_t nNodes = _nodes.size() ;
+  _functions.assign(nNodes,0) ;
+  _clientBegin.assign(nNodes+1,0) ;
+  _dirty.assign((nNodes+63)/64,0) ;
+  _propagated.assign((nNodes+63)/64,0) ;
+  for (Int_t id=0 ; id<nNodes ; id++) {
+    RooAbsArg* arg = _nodes[id] ;
+    _clientBegin[id] = _clients.size() ;
+    if (arg!=_top) {
+      for (const auto client : arg->valueClients()) {
+        _clients.push_back(ids[client]) ;
+      }
+    }
+    if (!dynamic_cast<RooAbsPdf*>(arg)) {
+      _functions[id] = dynamic_cast<RooAbsReal*>(arg) ;
+    }
+    if (arg->_valueDirty && arg->_operMode==RooAbsArg::Auto) {
+      setBit(_dirty,id) ;
+    }
+    arg->_dirtyGraph = this ;
+    arg->_dirtyGraphId = id ;
+  }
+  _clientBegin[nNodes] = _clients.size() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Detach all nodes from the graph. They go back to the recursive dirty
+/// state propagation until compile() is called again.
+
+void RooDirtyGraph::invalidate()
+{
+  for (auto arg : _nodes) {
+    arg->_dirtyGraph = 0 ;
+    arg->_dirtyGraphId = -1 ;
+  }
+  _nodes.clear() ;
+  _functions.clear() ;
+  _clientBegin.clear() ;
+  _clients.clear() ;
+  _dirty.clear() ;
+  _propagated.clear() ;
+  _anyPropagated = kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark node id and all its downstream nodes dirty. Nodes whose state has
+/// already been propagated since the last evaluation of any node of the
+/// graph are not visited again. The propagation stops at nodes in the AClean
+/// operation mode, and goes through the nodes in the ADirty mode without
+/// marking them, as they are recalculated at every access anyway.
+
+void RooDirtyGraph::markDirty(Int_t id, const RooAbsArg* source)
+{
+  if (!source) source = _nodes[id] ;
+
+  _stack.clear() ;
+  _stack.push_back(id) ;
+  while (!_stack.empty()) {
+    const Int_t n = _stack.back() ;
+    _stack.pop_back() ;
+    if (testBit(_propagated,n)) continue ;
+    RooAbsArg* arg = _nodes[n] ;
+    if (arg->_operMode==RooAbsArg::AClean) continue ;
+
+    if (arg->_operMode==RooAbsArg::Auto) {
+      arg->_valueDirty = kTRUE ;
+      setBit(_dirty,n) ;
+    }
+    setBit(_propagated,n) ;
+    _anyPropagated = kTRUE ;
+
+    for (Int_t c=_clientBegin[n] ; c<_clientBegin[n+1] ; c++) {
+      if (!testBit(_propagated,_clients[c])) _stack.push_back(_clients[c]) ;
+    }
+  }
+
+  // The clients of the top node are outside of the graph. They may have been
+  // evaluated without notifying us, so they are always told.
+  if (testBit(_propagated,_nodes.size()-1)) {
+    for (const auto client : _top->valueClients()) {
+      client->setValueDirty(source) ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Node id has been evaluated. The record of the propagated nodes is reset,
+/// as the clients of a clean node have to be told again at its next change.
+
+void RooDirtyGraph::nodeCleaned(Int_t id)
+{
+  clearBit(_dirty,id) ;
+  if (_anyPropagated) {
+    std::fill(_propagated.begin(),_propagated.end(),0) ;
+    _anyPropagated = kFALSE ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the nodes marked dirty by the graph and not evaluated since, in
+/// evaluation order.
+
+std::vector<RooAbsArg*> RooDirtyGraph::dirtyNodes() const
+{
+  vector<RooAbsArg*> ret ;
+  for (size_t w=0 ; w<_dirty.size() ; w++) {
+    ULong64_t word = _dirty[w] ;
+    for (Int_t b=0 ; word ; b++, word>>=1) {
+      if (word&1) ret.push_back(_nodes[64*w+b]) ;
+    }
+  }
+  return ret ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the dirty real-valued functions of the graph, except the top
+/// node, in evaluation order. The top node then finds them clean.
+
+void RooDirtyGraph::evaluateFunctions()
+{
+  const Int_t topId = Int_t(_nodes.size())-1 ;
+  for (size_t w=0 ; w<_dirty.size() ; w++) {
+    // Evaluating a node clears its bit, work on a copy of the word
+    ULong64_t word = _dirty[w] ;
+    for (Int_t b=0 ; word ; b++, word>>=1) {
+      const Int_t id = 64*w+b ;
+      if ((word&1) && id!=topId && _functions[id] && _functions[id]->isValueDirty()) {
+        _functions[id]->getVal() ;
+      }
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the dirty real-valued functions of the graph in evaluation order,
+/// then return the value of the top node for normalisation set nset.
+
+Double_t RooDirtyGraph::evaluate(const RooArgSet* nset)
+{
+  RooAbsReal* top = dynamic_cast<RooAbsReal*>(_top) ;
+  if (!top) {
+    oocoutE(_top,Eval) << "RooDirtyGraph::evaluate(" << _top->GetName() << ") ERROR: top node is not real-valued" << endl ;
+    return 0 ;
+  }
+
+  evaluateFunctions() ;
+  return top->getVal(nset) ;
+}
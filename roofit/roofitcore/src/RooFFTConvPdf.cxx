@@ -60,7 +60,14 @@
 /// which are also stored in the cache. Subsequent evaluations for different values of the convolution observable and
 /// identical parameters will be retrieved from the cache. If one or more
 /// of the parameters change, the cache will be updated, *i.e.*, a new FFT runs.
-/// 
+/// Only the input p.d.f.s whose own parameters changed are sampled and transformed
+/// again; the transform of the other input is kept from the previous update. This
+/// is typical of fits in which the resolution model is fixed while the physics
+/// p.d.f. varies, and can be switched off with `setReuseTransforms(kFALSE)`.
+/// The FFT plans are shared between all convolutions with the same number of sampling points.
+/// Each shared plan is used under its own lock, so the convolutions with the same number of
+/// sampling points that are evaluated in different threads run their FFTs one at a time.
+///
 /// The sampling density of the FFT is controlled by the binning of the 
 /// the convolution observable, which can be changed using RooRealVar::setBins(N).
 /// For good results, N should be large (>=1000). Additional interpolation
@@ -128,14 +135,68 @@
 #include "RooGlobalFunc.h"
 #include "RooLinearVar.h"
 #include "RooConstVar.h"
+#include "RooChangeTracker.h"
 #include "TClass.h"
 #include "TSystem.h"
 
+#include <mutex>
+#include <string>
+
 using namespace std ;
 
 ClassImp(RooFFTConvPdf); 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Forward and backward transforms for a given number of sampling points.
+/// The transforms of one FFTPlans object are only used while holding its mutex,
+/// as the cache elements that share it may be filled in different threads.
+
+struct RooFFTConvPdf::FFTPlans {
+  std::unique_ptr<TVirtualFFT> r2c ;
+  std::unique_ptr<TVirtualFFT> c2r ;
+  std::mutex mutex ;
+} ;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the transforms for n sampling points, creating them if no cache
+/// element currently uses transforms of that size.
+
+std::shared_ptr<RooFFTConvPdf::FFTPlans> sharedFFTPlans(Int_t n)
+{
+  static std::mutex registryMutex ;
+  static std::map<Int_t,std::weak_ptr<RooFFTConvPdf::FFTPlans> > registry ;
+
+  std::lock_guard<std::mutex> lock(registryMutex) ;
+  std::shared_ptr<RooFFTConvPdf::FFTPlans> plans = registry[n].lock() ;
+  if (!plans) {
+    plans = std::make_shared<RooFFTConvPdf::FFTPlans>() ;
+    plans->r2c.reset(TVirtualFFT::FFT(1, &n, "R2CK")) ;
+    plans->c2r.reset(TVirtualFFT::FFT(1, &n, "C2RK")) ;
+    registry[n] = plans ;
+  }
+  return plans ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transform the n real values of input and store the n/2+1 complex values of
+/// the result as (re,im) pairs in spectrum
+
+void forwardTransform(TVirtualFFT& fft, Double_t* input, Int_t n, std::vector<Double_t>& spectrum)
+{
+  fft.SetPoints(input) ;
+  fft.Transform() ;
+  spectrum.resize(2*(n/2+1)) ;
+  for (Int_t i=0 ; i<n/2+1 ; i++) {
+    fft.GetPointComplex(i,spectrum[2*i],spectrum[2*i+1]) ;
+  }
+}
+
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for numerical (FFT) convolution of PDFs.
@@ -159,7 +220,8 @@ RooFFTConvPdf::RooFFTConvPdf(const char *name, const char *title, RooRealVar& co
   _bufStrat(Extend),
   _shift1(0),
   _shift2(0),
-  _cacheObs("!cacheObs","Cached observables",this,kFALSE,kFALSE)
+  _cacheObs("!cacheObs","Cached observables",this,kFALSE,kFALSE),
+  _reuseTransforms(kTRUE)
 {
   prepareFFTBinning(convVar);
 
@@ -185,7 +247,8 @@ RooFFTConvPdf::RooFFTConvPdf(const char *name, const char *title, RooAbsReal& pd
   _bufStrat(Extend),
   _shift1(0),
   _shift2(0),
-  _cacheObs("!cacheObs","Cached observables",this,kFALSE,kFALSE)
+  _cacheObs("!cacheObs","Cached observables",this,kFALSE,kFALSE),
+  _reuseTransforms(kTRUE)
 {
   prepareFFTBinning(convVar);
 
@@ -210,7 +273,8 @@ RooFFTConvPdf::RooFFTConvPdf(const RooFFTConvPdf& other, const char* name) :
   _bufStrat(other._bufStrat),
   _shift1(other._shift1),
   _shift2(other._shift2),
-  _cacheObs("!cacheObs",this,other._cacheObs)
+  _cacheObs("!cacheObs",this,other._cacheObs),
+  _reuseTransforms(other._reuseTransforms)
  { 
  } 
 
@@ -277,12 +341,27 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the FFT plans used for the normalisation set nset, which are shared
+/// with all the convolutions with the same number of sampling points. The
+/// convolution is computed for nset if needed. Return a null pointer if it was
+/// taken from the expensive object cache instead.
+
+const RooFFTConvPdf::FFTPlans* RooFFTConvPdf::fftPlans(const RooArgSet* nset) const
+{
+  FFTCacheElem* cache = static_cast<FFTCacheElem*>(getCache(nset,kFALSE)) ;
+  return cache ? cache->plans.get() : 0 ;
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clone input pdf and attach to dataset
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  tracker1(0),tracker2(0),nBins(0),nBins2(0)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -366,6 +445,15 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
   scanBinning = new RooUniformBinning (convObs->getMin()-Nbuf*obw,convObs->getMax()+Nbuf*obw,N2) ;
   histBinning = convObs->getBinning().clone() ;
 
+  // Track the parameters of each input p.d.f. separately, to know which
+  // transforms have to be recalculated
+  RooArgSet* params1 = pdf1Clone->getParameters(*hist()->get()) ;
+  RooArgSet* params2 = pdf2Clone->getParameters(*hist()->get()) ;
+  tracker1 = new RooChangeTracker(Form("%s_fftTracker1",self.GetName()),"FFT input 1 tracker",*params1,kTRUE) ;
+  tracker2 = new RooChangeTracker(Form("%s_fftTracker2",self.GetName()),"FFT input 2 tracker",*params2,kTRUE) ;
+  delete params1 ;
+  delete params2 ;
+
   // Deactivate dirty state propagation on datahist observables
   // and set all nodes on both pdfs to operMode AlwaysDirty
   hist()->setDirtyProp(kFALSE) ;  
@@ -392,6 +480,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
   ret.add(*pdf1Clone) ;
   ret.add(*pdf2Clone) ;
+  ret.add(*tracker1) ;
+  ret.add(*tracker2) ;
   if (pdf1Clone->ownedComponents()) {
     ret.add(*pdf1Clone->ownedComponents()) ;
   }
@@ -407,9 +497,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
 RooFFTConvPdf::FFTCacheElem::~FFTCacheElem() 
 { 
-  delete fftr2c1 ; 
-  delete fftr2c2 ; 
-  delete fftc2r ; 
+  delete tracker1 ;
+  delete tracker2 ;
 
   delete pdf1Clone ;
   delete pdf2Clone ;
@@ -429,8 +518,15 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 {
   RooDataHist& cacheHist = *cache.hist() ;
   
-  ((FFTCacheElem&)cache).pdf1Clone->setOperMode(ADirty,kTRUE) ;
-  ((FFTCacheElem&)cache).pdf2Clone->setOperMode(ADirty,kTRUE) ;
+  FFTCacheElem& aux = (FFTCacheElem&) cache ;
+  aux.pdf1Clone->setOperMode(ADirty,kTRUE) ;
+  aux.pdf2Clone->setOperMode(ADirty,kTRUE) ;
+
+  // Forget the transforms of the input p.d.f.s whose parameters have changed
+  const Bool_t changed1 = aux.tracker1->hasChanged(kTRUE) ;
+  const Bool_t changed2 = aux.tracker2->hasChanged(kTRUE) ;
+  if (changed1 || !_reuseTransforms) aux.spectrum1.clear() ;
+  if (changed2 || !_reuseTransforms) aux.spectrum2.clear() ;
 
   // Determine if there other observables than the convolution observable in the cache
   RooArgSet otherObs ;
@@ -446,7 +542,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
   // Handle trivial scenario -- no other observables
   if (otherObs.getSize()==0) {
-    fillCacheSlice((FFTCacheElem&)cache,RooArgSet()) ;
+    fillCacheSlice(aux,RooArgSet()) ;
     return ;
   }
 
@@ -473,6 +569,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
   }
   delete iter ;
 
+  Int_t slice(0) ;
   Bool_t loop(kTRUE) ;
   while(loop) {
     // Set current slice position
@@ -481,7 +578,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 //     cout << "filling slice: bin of obsLV[0] = " << obsLV[0]->getBin() << endl ;
 
     // Fill current slice
-    fillCacheSlice((FFTCacheElem&)cache,otherObs) ;
+    fillCacheSlice(aux,otherObs,slice++) ;
 
     // Determine which iterator to increment
     while(binCur[curObs]==binMax[curObs]) {
@@ -511,13 +608,22 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Fill a slice of cachePdf with the output of the FFT convolution calculation
+/// Fill a slice of cachePdf with the output of the FFT convolution calculation.
+/// The transform of an input p.d.f. calculated for the same slice in a
+/// previous call is reused if it is still stored in the cache element (see
+/// fillCacheObject()), in which case that p.d.f. is not sampled again.
 
-void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos) const 
+void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos, Int_t slice) const 
 {
   // Extract histogram that is the basis of the RooHistPdf
   RooDataHist& cacheHist = *aux.hist() ;
 
+  if (Int_t(aux.spectrum1.size())<=slice) aux.spectrum1.resize(slice+1) ;
+  if (Int_t(aux.spectrum2.size())<=slice) aux.spectrum2.resize(slice+1) ;
+  if (Int_t(aux.zeroBin1.size())<=slice) aux.zeroBin1.resize(slice+1) ;
+  std::vector<Double_t>& spectrum1 = aux.spectrum1[slice] ;
+  std::vector<Double_t>& spectrum2 = aux.spectrum2[slice] ;
+
   // Sample array of input points from both pdfs 
   // Note that returned arrays have optional buffers zones below and above range ends
   // to reduce cyclical effects and have been cyclically rotated so that bin containing
@@ -529,46 +635,46 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   //
   // 
 
-  Int_t N,N2,binShift1,binShift2 ;
+  Int_t N(aux.nBins),N2(aux.nBins2),binShift1(aux.zeroBin1[slice]),binShift2 ;
   
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
+  Double_t* input1 = spectrum1.empty() ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) : 0 ;
+  Double_t* input2 = spectrum2.empty() ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) : 0 ;
   if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
-
+  aux.nBins = N ;
+  aux.nBins2 = N2 ;
+  aux.zeroBin1[slice] = binShift1 ;
 
 
 
   // Retrieve previously defined FFT transformation plans
-  if (!aux.fftr2c1) {
-    aux.fftr2c1 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftr2c2 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftc2r  = TVirtualFFT::FFT(1, &N2, "C2RK");
+  if (!aux.plans) {
+    aux.plans = sharedFFTPlans(N2) ;
   }
-  
+  std::lock_guard<std::mutex> lock(aux.plans->mutex) ;
+  TVirtualFFT& fftr2c = *aux.plans->r2c ;
+  TVirtualFFT& fftc2r = *aux.plans->c2r ;
+
   // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
+  if (input1) forwardTransform(fftr2c,input1,N2,spectrum1) ;
 
   // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+  if (input2) forwardTransform(fftr2c,input2,N2,spectrum2) ;
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
   for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
+    const Double_t re1 = spectrum1[2*i], im1 = spectrum1[2*i+1] ;
+    const Double_t re2 = spectrum2[2*i], im2 = spectrum2[2*i+1] ;
     Double_t re = re1*re2 - im1*im2 ;
     Double_t im = re1*im2 + re2*im1 ;
     TComplex t(re,im) ;
-    aux.fftc2r->SetPointComplex(i,t) ;
+    fftc2r.SetPointComplex(i,t) ;
   }
 
   // Reverse Complex->Real FFT transform product
-  aux.fftc2r->Transform() ;
+  fftc2r.Transform() ;
 
   Int_t totalShift = binShift1 + (N2-N)/2 ;
 
@@ -583,7 +689,7 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
     while (j>=N2) j-= N2 ;
 
     iter->Next() ;
-    cacheHist.set(aux.fftc2r->GetPointReal(j)) ;    
+    cacheHist.set(fftc2r.GetPointReal(j)) ;    
   }
   delete iter ;
 
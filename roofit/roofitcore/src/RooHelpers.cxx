@@ -15,6 +15,10 @@
  *****************************************************************************/
 
 #include "RooHelpers.h"
+#include "RooRandom.h"
+
+#include "TMath.h"
+#include "TRandom2.h"
 
 namespace RooHelpers {
 
@@ -37,6 +41,22 @@ std::vector<std::string> tokenise(const std::string &str, const std::string &del
 
 
 
+/// Return n seeds, one for each of n samples or toys, in the order in which
+/// they are generated. The seeds are drawn from a sequence that is initialised
+/// from RooRandom::randomGenerator(), so they are reproducible after seeding
+/// that generator. Zero, which would request a time-dependent seed, is never
+/// returned.
+std::vector<UInt_t> seedSequence(Int_t n) {
+  std::vector<UInt_t> seeds(n > 0 ? n : 0);
+  TRandom2 seedGen(1 + RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max() - 1));
+  for (auto& seed : seeds) {
+    seed = 1 + seedGen.Integer(TMath::Limits<unsigned int>::Max() - 1);
+  }
+  return seeds;
+}
+
+
+
 HijackMessageStream::HijackMessageStream(RooFit::MsgLevel level, RooFit::MsgTopic topics, const char* objectName) :
   std::ostringstream()
 {
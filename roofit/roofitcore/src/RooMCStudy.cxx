@@ -58,12 +58,21 @@ These study modules should derive from class RooAbsMCStudyModel
 #include "RooPlot.h"
 #include "RooGenericPdf.h"
 #include "RooRandom.h"
+#include "RooHelpers.h"
 #include "RooCmdConfig.h"
 #include "RooGlobalFunc.h"
 #include "RooPullVar.h"
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 using namespace std ;
 
 ClassImp(RooMCStudy);
@@ -146,6 +155,9 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
 
   // Decode command line arguments
   _silence = pc.getInt("silence") ;
+  _nWorkers = 1 ;
+  _samplesPerTask = 100 ;
+  _seedPerSample = kFALSE ;
   _verboseGen = pc.getInt("verboseGen") ;
   _extendedGen = pc.getInt("extendedGen") ;
   _binGenData = pc.getInt("binGenData") ;
@@ -192,7 +204,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
       delete params ;
       delete cparams ;
     }
-    _constrGenContext = _constrPdf->genContext(consPars,0,0,_verboseGen) ;
+    _constrGenParams.add(consPars) ;
+    _constrGenContext = _constrPdf->genContext(_constrGenParams,0,0,_verboseGen) ;
 
     _perExptGenParams = kTRUE ;
 
@@ -332,7 +345,10 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nWorkers(1),
+  _samplesPerTask(100),
+  _seedPerSample(kFALSE)
 {
   // Decode generator options
   TString genOpt(genOptions) ;
@@ -462,9 +478,90 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     (*iter)->initializeRun(nSamples) ;
   }  
   
+  if (_nWorkers>1 && doGenerate && DoFit && !keepGenData && !asciiFilePat && _modList.empty()) {
+    runParallel(nSamples,nEvtPerSample) ;
+  } else if (_seedPerSample && doGenerate) {
+    std::vector<UInt_t> seeds = RooHelpers::seedSequence(nSamples) ;
+    runSamples(doGenerate,DoFit,nSamples,nEvtPerSample,keepGenData,asciiFilePat,seeds.data()) ;
+  } else {
+    runSamples(doGenerate,DoFit,nSamples,nEvtPerSample,keepGenData,asciiFilePat) ;
+  }
+
+  for (iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
+    RooDataSet* auxData = (*iter)->finalizeRun() ;
+    if (auxData) {
+      _fitParData->merge(auxData) ;
+    }
+  }  
+
+  _canAddFitResults = kFALSE ;
+
+  if (_genParData) {
+    const RooArgSet* genPars = _genParData->get() ;
+    TIterator* iter2 = genPars->createIterator() ;
+    RooAbsArg* arg ;
+    while((arg=(RooAbsArg*)iter2->Next())) {
+      _genParData->changeObservableName(arg->GetName(),Form("%s_gen",arg->GetName())) ;
+    }
+    delete iter2 ;
+    
+    _fitParData->merge(_genParData) ;
+  }
+
+  if (DoFit) calcPulls() ;
+
+  if (_silence) {
+    RooMsgService::instance().setGlobalKillBelow(oldLevel) ;
+  }
+
+  return kFALSE ;
+}
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the generator contexts again. Some of them keep state from one
+/// generate() call to the next, e.g. the accept/reject sampler caches the
+/// trial events it has not used yet, so that a sample would otherwise depend
+/// on the samples generated before it in the same process.
+
+void RooMCStudy::resetGenContexts()
+{
+  if (_genContext) {
+    delete _genContext ;
+    _genContext = _genModel->genContext(_dependents,_genProtoData,0,_verboseGen) ;
+    _genContext->attach(*_genParams) ;
+  }
+  if (_constrGenContext) {
+    delete _constrGenContext ;
+    _constrGenContext = _constrPdf->genContext(_constrGenParams,0,0,_verboseGen) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and/or fit 'nSamples' samples in this process, filling the fit
+/// and generator parameter datasets and the lists of samples and fit results.
+/// The study modules are called for each sample. See run() for the arguments.
+/// If 'seeds' is given, RooRandom::randomGenerator() is seeded with seeds[i]
+/// before the i-th sample is generated, and the generator contexts are
+/// created again (see resetGenContexts()), so that each sample only depends
+/// on its seed.
+
+void RooMCStudy::runSamples(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat, const UInt_t* seeds)
+{
   Int_t prescale = nSamples>100 ? Int_t(nSamples/100) : 1 ;
 
   while(nSamples--) {
+
+    if (seeds) {
+      RooRandom::randomGenerator()->SetSeed(*seeds++) ;
+      if (doGenerate) resetGenContexts() ;
+    }
     
     if (nSamples%prescale==0) {
       oocoutP(_fitModel,Generation) << "RooMCStudy::run: " ;
@@ -597,42 +694,91 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
       }
     }
   }
+}
 
-  for (iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
-    RooDataSet* auxData = (*iter)->finalizeRun() ;
-    if (auxData) {
-      _fitParData->merge(auxData) ;
-    }
-  }  
 
-  _canAddFitResults = kFALSE ;
 
-  if (_genParData) {
-    const RooArgSet* genPars = _genParData->get() ;
-    TIterator* iter2 = genPars->createIterator() ;
-    RooAbsArg* arg ;
-    while((arg=(RooAbsArg*)iter2->Next())) {
-      _genParData->changeObservableName(arg->GetName(),Form("%s_gen",arg->GetName())) ;
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and fit 'nSamples' samples of 'nEvtPerSample' events in the
+/// local worker processes requested with setNumWorkers().
+///
+/// Each sample is generated with its own seed of RooRandom::randomGenerator(),
+/// taken from RooHelpers::seedSequence(). The samples are split into tasks of
+/// setSamplesPerTask() samples, which run runSamples() in a worker. The fit
+/// and generator parameters and the fit results of the tasks are collected
+/// in task order, so the outcome depends neither on the number of workers
+/// nor on the number of samples per task, and is the same as that of a run
+/// in this process with setSeedPerSample(kTRUE).
+
+void RooMCStudy::runParallel(Int_t nSamples, Int_t nEvtPerSample)
+{
+#ifdef R__WIN32
+  oocoutW(_fitModel,Generation) << "RooMCStudy::runParallel: multi-process running is not supported on this platform, "
+				<< "running in a single process" << endl ;
+  runSamples(kTRUE,kTRUE,nSamples,nEvtPerSample,kFALSE,0) ;
+#else
+  const Int_t samplesPerTask = _samplesPerTask>0 ? _samplesPerTask : nSamples ;
+  const UInt_t nTasks = nSamples>0 ? (nSamples+samplesPerTask-1)/samplesPerTask : 0 ;
+  if (nTasks==0) return ;
+
+  const std::vector<UInt_t> seeds = RooHelpers::seedSequence(nSamples) ;
+
+  oocoutP(_fitModel,Generation) << "RooMCStudy::runParallel: generating and fitting " << nSamples << " samples in "
+				<< nTasks << " tasks on " << _nWorkers << " worker processes" << endl ;
+
+  // Runs in the forked worker processes, which start from a copy of this
+  // object with empty output datasets
+  auto task = [&](UInt_t iTask) -> TList* {
+    _fitParData->reset() ;
+    if (_genParData) _genParData->reset() ;
+    _fitResList.Clear() ;
+
+    const Int_t first = Int_t(iTask)*samplesPerTask ;
+    runSamples(kTRUE,kTRUE,std::min(samplesPerTask,nSamples-first),nEvtPerSample,kFALSE,0,seeds.data()+first) ;
+
+    TList* output = new TList ;
+    output->SetName(Form("%u",iTask)) ;
+    output->SetOwner() ;
+    output->Add(_fitParData->Clone()) ;
+    output->Add(_genParData ? _genParData->Clone() : new TNamed("noGenParData","")) ;
+    // The fit results are handed over to the output list
+    output->AddAll(&_fitResList) ;
+    _fitResList.Clear() ;
+    return output ;
+  } ;
+
+  ROOT::TProcessExecutor workers(_nWorkers) ;
+  std::vector<TList*> results = workers.Map(task,ROOT::TSeqU(nTasks)) ;
+
+  // The results arrive in the order in which the tasks finished
+  const std::vector<TList*> ordered = RooHelpers::orderTaskResults(results,nTasks) ;
+
+  for (UInt_t iTask=0 ; iTask<nTasks ; iTask++) {
+    TList* output = ordered[iTask] ;
+    if (!output || output->GetSize()<2) {
+      oocoutW(_fitModel,Generation) << "RooMCStudy::runParallel: no result from task " << iTask << endl ;
+      delete output ;
+      continue ;
     }
-    delete iter2 ;
-    
-    _fitParData->merge(_genParData) ;
-  }
-
-  if (DoFit) calcPulls() ;
-
-  if (_silence) {
-    RooMsgService::instance().setGlobalKillBelow(oldLevel) ;
+    RooDataSet* fitParData = dynamic_cast<RooDataSet*>(output->At(0)) ;
+    if (fitParData && fitParData->numEntries()>0) _fitParData->append(*fitParData) ;
+    RooDataSet* genParData = dynamic_cast<RooDataSet*>(output->At(1)) ;
+    if (_genParData && genParData && genParData->numEntries()>0) _genParData->append(*genParData) ;
+
+    // Transfer the fit results to our list
+    for (Int_t i=2 ; i<output->GetSize() ; i++) {
+      _fitResList.Add(output->At(i)) ;
+    }
+    for (Int_t i=output->GetSize()-1 ; i>=2 ; i--) {
+      output->RemoveAt(i) ;
+    }
+    delete output ;
   }
-
-  return kFALSE ;
+#endif
 }
 
 
 
-
-
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Generate and fit 'nSamples' samples of 'nEvtPerSample' events.
 /// If keepGenData is set, all generated data sets will be kept in memory and can be accessed
@@ -642,6 +788,11 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
 /// The pattern, which is a template for snprintf, should look something like "data/toymc_%04d.dat"
 /// and should contain one integer field that encodes the sample serial number.
 ///
+/// If more than one worker was requested with setNumWorkers(), the samples are
+/// generated and fitted in local worker processes (see runParallel()), provided
+/// that no study modules are attached and that the generated data sets are
+/// neither kept nor written out.
+///
 
 Bool_t RooMCStudy::generateAndFit(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) 
 {
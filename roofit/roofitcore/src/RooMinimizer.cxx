@@ -241,6 +241,38 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the gradient of the function numerically in RooFit, distributing the
+/// partial derivatives over nWorkers threads, instead of letting MINUIT calculate it
+/// one parameter after the other. Each thread evaluates its own clone of the function.
+/// The step sizes and second derivatives of the calculation follow the algorithm of
+/// MINUIT and are handed to it (with Minuit2) along with the gradient. A number of
+/// workers of zero (the default) restores the calculation of the gradient by MINUIT.
+
+void RooMinimizer::setParallelGradient(Int_t nWorkers)
+{
+  _fcn->SetGradientWorkers(nWorkers) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the minimization of the fitter on the function, with the gradient calculated
+/// by RooMinimizerFcn if setParallelGradient() was called.
+
+bool RooMinimizer::fitFcn()
+{
+  if (_fcn->GetGradientWorkers()>0) {
+    _fcn->SynchronizeGradient(_theFitter->Config().ParamsSettings(),
+			      _theFitter->Config().MinimizerOptions().Strategy(),
+			      _theFitter->Config().MinimizerOptions().ErrorDef(),_optConst) ;
+    return _theFitter->FitFCN(static_cast<const ROOT::Math::IMultiGradFunction&>(*_fcn)) ;
+  }
+  return _theFitter->FitFCN(static_cast<const ROOT::Math::IMultiGenFunction&>(*_fcn)) ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimzer algorithm.
@@ -320,7 +352,7 @@ Int_t RooMinimizer::minimize(const char* type, const char* alg)
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
   RooAbsReal::clearEvalErrorLog() ;
 
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -349,7 +381,7 @@ Int_t RooMinimizer::migrad()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migrad");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -512,7 +544,7 @@ Int_t RooMinimizer::seek()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"seek");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -541,7 +573,7 @@ Int_t RooMinimizer::simplex()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"simplex");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -570,7 +602,7 @@ Int_t RooMinimizer::improve()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migradimproved");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -38,8 +38,335 @@
 
 #include "RooMinimizer.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cmath>
+#include <limits>
+
 using namespace std;
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Numerical calculation of the gradient of the minimized function, shared by a
+// RooMinimizerFcn and its copies held by the fitter. The partial derivatives
+// are calculated as in ROOT::Minuit2::Numerical2PGradientCalculator, in the
+// internal (unbounded) parameters of MINUIT, and the step sizes and second
+// derivatives are kept from one calculation to the next. The parameters are
+// distributed over the workers, each of them evaluating its own clone of the
+// function (with its own copy of the parameters) in a separate thread.
+
+class RooMinimizerFcn::NumericalGradient {
+public:
+
+  struct Worker {
+    RooAbsReal* func ;                      // Function evaluated by this worker
+    RooArgSet* params ;                     // Parameters of the clone of the function
+    std::vector<RooRealVar*> floatParams ;  // Floating parameters, in the order of the minimizer
+    Int_t optConst ;                        // Constant term optimization level of the clone
+  } ;
+
+  NumericalGradient(RooAbsReal* funct, Int_t nWorkers) ;
+  ~NumericalGradient() ;
+
+  Double_t int2ext(Int_t i, Double_t x) const ;
+  Double_t ext2int(Int_t i, Double_t x) const ;
+  Double_t dInt2Ext(Int_t i, Double_t x) const ;
+
+  void initialize(const std::vector<ROOT::Fit::ParameterSettings>& parameters, Int_t strategy, Double_t errorDef) ;
+  void calculate(const double* x) ;
+  void calculateWorker(Int_t w, const double* x) ;
+
+  RooAbsReal* _funct ;
+  std::vector<Worker> _workers ;
+  std::vector<ROOT::Fit::ParameterSettings> _parameters ;
+
+  // State of the calculation, in internal parameters
+  std::vector<Double_t> _grd ;
+  std::vector<Double_t> _g2 ;
+  std::vector<Double_t> _gstep ;
+
+  // Result of the last calculation, in external parameters
+  std::vector<Double_t> _x ;
+  std::vector<Double_t> _grdExt ;
+  std::vector<Double_t> _g2Ext ;
+  std::vector<Double_t> _gstepExt ;
+  Bool_t _valid ;
+  Bool_t _warm ;
+  Int_t _ncalc ;
+
+  Int_t _ncycle ;
+  Double_t _stepTolerance ;
+  Double_t _gradTolerance ;
+  Double_t _errorDef ;
+  Double_t _eps ;
+  Double_t _eps2 ;
+
+#ifdef R__USE_IMT
+  ROOT::TThreadExecutor* _executor ;
+#endif
+} ;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+RooMinimizerFcn::NumericalGradient::NumericalGradient(RooAbsReal* funct, Int_t nWorkers) :
+  _funct(funct), _valid(kFALSE), _warm(kFALSE), _ncalc(0), _ncycle(3), _stepTolerance(0.3), _gradTolerance(0.05), _errorDef(1.)
+{
+  // Create the workers. A single worker evaluates the function itself, otherwise
+  // each of them evaluates its own clone of the whole expression tree
+
+  // Precision as determined by ROOT::Minuit2::MnMachinePrecision
+  _eps = 4.*std::numeric_limits<double>::epsilon() ;
+  _eps2 = 2.*sqrt(_eps) ;
+
+  for (Int_t i=0 ; i<nWorkers ; i++) {
+    Worker worker ;
+    worker.func = (nWorkers==1) ? funct : (RooAbsReal*) funct->cloneTree() ;
+    worker.params = worker.func->getParameters(RooArgSet()) ;
+    worker.optConst = 0 ;
+    _workers.push_back(worker) ;
+  }
+
+#ifdef R__USE_IMT
+  _executor = (nWorkers>1) ? new ROOT::TThreadExecutor(nWorkers) : 0 ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+RooMinimizerFcn::NumericalGradient::~NumericalGradient()
+{
+  for (auto& worker : _workers) {
+    delete worker.params ;
+    if (worker.func != _funct) delete worker.func ;
+  }
+#ifdef R__USE_IMT
+  delete _executor ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t RooMinimizerFcn::NumericalGradient::int2ext(Int_t i, Double_t x) const
+{
+  // Transformation from internal to external parameter, as in the
+  // ROOT::Minuit2::[Sin|SqrtLow|SqrtUp]ParameterTransformation classes
+
+  const ROOT::Fit::ParameterSettings& par = _parameters[i] ;
+  if (par.IsDoubleBound()) {
+    return par.LowerLimit() + 0.5*(par.UpperLimit() - par.LowerLimit())*(sin(x) + 1.) ;
+  } else if (par.HasLowerLimit()) {
+    return par.LowerLimit() - 1. + sqrt(x*x + 1.) ;
+  } else if (par.HasUpperLimit()) {
+    return par.UpperLimit() + 1. - sqrt(x*x + 1.) ;
+  }
+  return x ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t RooMinimizerFcn::NumericalGradient::ext2int(Int_t i, Double_t x) const
+{
+  // Transformation from external to internal parameter
+
+  const ROOT::Fit::ParameterSettings& par = _parameters[i] ;
+  if (par.IsDoubleBound()) {
+    Double_t yy = 2.*(x - par.LowerLimit())/(par.UpperLimit() - par.LowerLimit()) - 1. ;
+    if (yy*yy > 1. - _eps2) {
+      Double_t vlim = 2.*atan(1.) - 8.*sqrt(_eps2) ;
+      return yy < 0. ? -vlim : vlim ;
+    }
+    return asin(yy) ;
+  } else if (par.IsBound()) {
+    Double_t yy = par.HasLowerLimit() ? x - par.LowerLimit() + 1. : par.UpperLimit() - x + 1. ;
+    return yy*yy < 1. ? 0. : sqrt(yy*yy - 1.) ;
+  }
+  return x ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t RooMinimizerFcn::NumericalGradient::dInt2Ext(Int_t i, Double_t x) const
+{
+  // Derivative of the external with respect to the internal parameter
+
+  const ROOT::Fit::ParameterSettings& par = _parameters[i] ;
+  if (par.IsDoubleBound()) {
+    return 0.5*(par.UpperLimit() - par.LowerLimit())*cos(x) ;
+  } else if (par.HasLowerLimit()) {
+    return x/sqrt(x*x + 1.) ;
+  } else if (par.HasUpperLimit()) {
+    return -x/sqrt(x*x + 1.) ;
+  }
+  return 1. ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RooMinimizerFcn::NumericalGradient::initialize(const std::vector<ROOT::Fit::ParameterSettings>& parameters,
+						    Int_t strategy, Double_t errorDef)
+{
+  // Take the settings of the minimizer and initialize the step sizes and second
+  // derivatives from the parameter errors, as ROOT::Minuit2::InitialGradientCalculator
+
+  _parameters = parameters ;
+  _errorDef = errorDef ;
+  switch (strategy) {
+  case 0: _ncycle = 2 ; _stepTolerance = 0.5 ; _gradTolerance = 0.1 ; break ;
+  case 1: _ncycle = 3 ; _stepTolerance = 0.3 ; _gradTolerance = 0.05 ; break ;
+  default: _ncycle = 5 ; _stepTolerance = 0.1 ; _gradTolerance = 0.02 ; break ;
+  }
+
+  const UInt_t n = _parameters.size() ;
+  _grd.assign(n,0.) ;
+  _g2.assign(n,0.) ;
+  _gstep.assign(n,0.) ;
+  for (UInt_t i=0 ; i<n ; i++) {
+    const ROOT::Fit::ParameterSettings& par = _parameters[i] ;
+    if (par.IsFixed()) continue ;
+
+    Double_t var = ext2int(i,par.Value()) ;
+    Double_t sav2 = par.Value() + par.StepSize() ;
+    if (par.HasUpperLimit() && sav2 > par.UpperLimit()) sav2 = par.UpperLimit() ;
+    Double_t vplu = ext2int(i,sav2) - var ;
+    sav2 = par.Value() - par.StepSize() ;
+    if (par.HasLowerLimit() && sav2 < par.LowerLimit()) sav2 = par.LowerLimit() ;
+    Double_t vmin = ext2int(i,sav2) - var ;
+
+    Double_t gsmin = 8.*_eps2*(fabs(var) + _eps2) ;
+    Double_t dirin = std::max(0.5*(fabs(vplu) + fabs(vmin)), gsmin) ;
+    _g2[i] = 2.0*_errorDef/(dirin*dirin) ;
+    _gstep[i] = std::max(gsmin, 0.1*dirin) ;
+    _grd[i] = _g2[i]*dirin ;
+    if (par.IsBound() && _gstep[i] > 0.5) _gstep[i] = 0.5 ;
+  }
+
+  _valid = kFALSE ;
+  _warm = kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RooMinimizerFcn::NumericalGradient::calculateWorker(Int_t w, const double* x)
+{
+  // Calculate the partial derivatives of the parameters assigned to worker w,
+  // following ROOT::Minuit2::Numerical2PGradientCalculator. Evaluations of the
+  // function failing (not finite values) are not used, the previous estimate
+  // of the derivative is kept instead
+
+  Worker& worker = _workers[w] ;
+  const Int_t nWorkers = _workers.size() ;
+  const Int_t n = _parameters.size() ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    worker.floatParams[i]->setVal(x[i]) ;
+  }
+  const Double_t fcnmin = worker.func->getVal() ;
+  const Double_t dfmin = 8.*_eps2*(fabs(fcnmin) + _errorDef) ;
+  const Double_t vrysml = 8.*_eps*_eps ;
+
+  for (Int_t i=w ; i<n ; i+=nWorkers) {
+    if (_parameters[i].IsFixed()) continue ;
+
+    RooRealVar* par = worker.floatParams[i] ;
+    const Double_t xtf = ext2int(i,x[i]) ;
+    const Double_t epspri = _eps2 + fabs(_grd[i]*_eps2) ;
+    Double_t stepb4 = 0. ;
+    for (Int_t j=0 ; j<_ncycle ; j++) {
+      const Double_t optstp = sqrt(dfmin/(fabs(_g2[i]) + epspri)) ;
+      Double_t step = std::max(optstp, fabs(0.1*_gstep[i])) ;
+      if (_parameters[i].IsBound() && step > 0.5) step = 0.5 ;
+      const Double_t stpmax = 10.*fabs(_gstep[i]) ;
+      if (step > stpmax) step = stpmax ;
+      const Double_t stpmin = std::max(vrysml, 8.*fabs(_eps2*xtf)) ;
+      if (step < stpmin) step = stpmin ;
+      if (fabs((step - stepb4)/step) < _stepTolerance) break ;
+      _gstep[i] = step ;
+      stepb4 = step ;
+
+      par->setVal(int2ext(i,xtf + step)) ;
+      const Double_t fs1 = worker.func->getVal() ;
+      par->setVal(int2ext(i,xtf - step)) ;
+      const Double_t fs2 = worker.func->getVal() ;
+      par->setVal(x[i]) ;
+      if (!std::isfinite(fs1) || !std::isfinite(fs2) || !std::isfinite(fcnmin)) break ;
+
+      const Double_t grdb4 = _grd[i] ;
+      _grd[i] = 0.5*(fs1 - fs2)/step ;
+      _g2[i] = (fs1 + fs2 - 2.*fcnmin)/step/step ;
+      if (fabs(grdb4 - _grd[i])/(fabs(_grd[i]) + dfmin/step) < _gradTolerance) break ;
+    }
+
+    // Results in external parameters
+    Double_t dd = dInt2Ext(i,xtf) ;
+    if (dd==0.) dd = 1. ;
+    _grdExt[i] = _grd[i]/dd ;
+    _g2Ext[i] = _g2[i]/(dd*dd) ;
+    _gstepExt[i] = _gstep[i]*fabs(dd) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RooMinimizerFcn::NumericalGradient::calculate(const double* x)
+{
+  // Calculate the gradient at x, distributing the parameters over the workers.
+  // The first calculation after an initialization runs sequentially, as the
+  // functions create their caches (e.g. normalization integrals) when first
+  // evaluated
+
+  const UInt_t n = _parameters.size() ;
+  if (_valid && _x.size()==n && std::equal(_x.begin(),_x.end(),x)) return ;
+
+  _x.assign(x,x+n) ;
+  _grdExt.assign(n,0.) ;
+  _g2Ext.assign(n,0.) ;
+  _gstepExt.assign(n,0.) ;
+
+  // The workers evaluate the function without offset hiding, as the minimizer
+  // does, and evaluation errors are reported through the function values
+  RooAbsReal::ErrorLoggingMode evalErrorMode = RooAbsReal::evalErrorLoggingMode() ;
+  RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::Ignore) ;
+  RooAbsReal::setHideOffset(kFALSE) ;
+
+  const Int_t nWorkers = _workers.size() ;
+#ifdef R__USE_IMT
+  if (_warm && _executor) {
+    _executor->Foreach([this,x](Int_t w) { calculateWorker(w,x) ; }, nWorkers) ;
+  } else {
+    for (Int_t w=0 ; w<nWorkers ; w++) calculateWorker(w,x) ;
+    _warm = kTRUE ;
+  }
+#else
+  for (Int_t w=0 ; w<nWorkers ; w++) calculateWorker(w,x) ;
+#endif
+
+  RooAbsReal::setHideOffset(kTRUE) ;
+  RooAbsReal::setEvalErrorLoggingMode(evalErrorMode) ;
+  RooAbsPdf::clearEvalError() ;
+
+  _valid = kTRUE ;
+  _ncalc++ ;
+}
+
 RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
 			   bool verbose) :
   _funct(funct), _context(context),
@@ -47,7 +374,8 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
   _nDim(0), _logfile(0),
-  _verbose(verbose)
+  _verbose(verbose),
+  _gradient()
 { 
 
   _evalCounter = 0 ;
@@ -94,7 +422,7 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
 
 
 
-RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBaseFunctionMultiDim(other), 
+RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IMultiGradFunction(other), 
   _evalCounter(other._evalCounter),
   _funct(other._funct),
   _context(other._context),
@@ -105,7 +433,8 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
   _nDim(other._nDim),
   _logfile(other._logfile),
   _verbose(other._verbose),
-  _floatParamVec(other._floatParamVec)
+  _floatParamVec(other._floatParamVec),
+  _gradient(other._gradient)
 {  
   _floatParamList = new RooArgList(*other._floatParamList) ;
   _constParamList = new RooArgList(*other._constParamList) ;
@@ -376,6 +705,158 @@ Bool_t RooMinimizerFcn::Synchronize(std::vector<ROOT::Fit::ParameterSettings>& p
 
 }
 
+void RooMinimizerFcn::SetGradientWorkers(Int_t nWorkers)
+{
+  // Let the minimizer use the gradient calculated numerically by this
+  // function, with the parameters distributed over nWorkers threads, each
+  // evaluating its own clone of the minimized function. A number of workers
+  // of zero restores the calculation of the gradient by the minimizer. The
+  // copies of this function made before keep the previous calculation
+
+  _gradient.reset();
+  if (nWorkers<=0) return;
+
+#ifndef R__USE_IMT
+  if (nWorkers>1) {
+    oocoutW(_context,Minimization) << "RooMinimizerFcn::SetGradientWorkers: ROOT was built without implicit "
+				   << "multi-threading support, calculating the gradient in one thread" << endl;
+    nWorkers = 1;
+  }
+#endif
+  _gradient = std::make_shared<NumericalGradient>(_funct, nWorkers);
+}
+
+
+Int_t RooMinimizerFcn::GetGradientWorkers() const
+{
+  // Return the number of workers calculating the gradient, zero if the
+  // minimizer calculates it
+  return _gradient ? _gradient->_workers.size() : 0;
+}
+
+
+Int_t RooMinimizerFcn::GetGradientCalculations() const
+{
+  // Return the number of gradients calculated by the workers, including the
+  // calculations made through the copies of this function
+  return _gradient ? _gradient->_ncalc : 0;
+}
+
+
+void RooMinimizerFcn::SynchronizeGradient(const std::vector<ROOT::Fit::ParameterSettings>& parameters,
+					  Int_t strategy, Double_t errorDef, Int_t optConst)
+{
+  // Synchronize the workers calculating the gradient with the parameters of the
+  // minimized function and the minimizer settings, to be called after Synchronize()
+  // at the start of each minimization
+
+  if (!_gradient) return;
+
+  for (auto& worker : _gradient->_workers) {
+
+    worker.floatParams.assign(_nDim, 0);
+    for (Int_t i = 0; i < _nDim; i++) {
+      worker.floatParams[i] = (RooRealVar*) _floatParamVec[i];
+    }
+    if (worker.func == _funct) continue;
+
+    if (worker.func->isOffsetting() != _funct->isOffsetting()) {
+      worker.func->enableOffsetting(_funct->isOffsetting());
+    }
+
+    // Copy the values and constant flags of all parameters to the clone
+    Bool_t constStatChange(kFALSE), constValChange(kFALSE);
+    for (Int_t i = 0; i < _nDim; i++) {
+      RooRealVar* par = (RooRealVar*) _floatParamVec[i];
+      RooRealVar* wpar = dynamic_cast<RooRealVar*>(worker.params->find(par->GetName()));
+      if (!wpar) {
+	oocoutE(_context,Minimization) << "RooMinimizerFcn::SynchronizeGradient: parameter " << par->GetName()
+				       << " not found in the clone of the function" << endl;
+	continue;
+      }
+      if (wpar->isConstant() != par->isConstant()) {
+	wpar->setConstant(par->isConstant());
+	constStatChange = kTRUE;
+      }
+      wpar->setVal(par->getVal());
+      worker.floatParams[i] = wpar;
+    }
+    RooFIter iter = _constParamList->fwdIterator();
+    RooAbsArg* arg;
+    while ((arg = iter.next())) {
+      RooRealVar* par = dynamic_cast<RooRealVar*>(arg);
+      RooRealVar* wpar = dynamic_cast<RooRealVar*>(worker.params->find(arg->GetName()));
+      if (!par || !wpar) continue;
+      if (!wpar->isConstant()) {
+	wpar->setConstant(kTRUE);
+	constStatChange = kTRUE;
+      }
+      if (wpar->getVal() != par->getVal()) {
+	wpar->setVal(par->getVal());
+	constValChange = kTRUE;
+      }
+    }
+
+    // Follow the constant term optimization of the minimized function
+    if (worker.optConst != optConst) {
+      worker.func->constOptimizeTestStatistic(optConst ? RooAbsArg::Activate : RooAbsArg::DeActivate, optConst>1);
+      worker.optConst = optConst;
+    } else if (optConst && constStatChange) {
+      worker.func->constOptimizeTestStatistic(RooAbsArg::ConfigChange);
+    } else if (optConst && constValChange) {
+      worker.func->constOptimizeTestStatistic(RooAbsArg::ValueChange);
+    }
+  }
+
+  _gradient->initialize(parameters, strategy, errorDef);
+}
+
+
+void RooMinimizerFcn::Gradient(const double *x, double *grad) const
+{
+  // Calculate the gradient numerically, see SetGradientWorkers()
+
+  if (!_gradient) {
+    oocoutE(_context,Minimization) << "RooMinimizerFcn::Gradient: numerical gradient calculation not enabled" << endl;
+    for (Int_t i = 0; i < _nDim; i++) grad[i] = 0;
+    return;
+  }
+  _gradient->calculate(x);
+  std::copy(_gradient->_grdExt.begin(), _gradient->_grdExt.end(), grad);
+}
+
+
+double RooMinimizerFcn::DoDerivative(const double *x, unsigned int icoord) const
+{
+  if (!_gradient) return 0;
+  _gradient->calculate(x);
+  return _gradient->_grdExt[icoord];
+}
+
+
+bool RooMinimizerFcn::HasG2ndDerivative() const
+{
+  return _gradient != nullptr;
+}
+
+
+void RooMinimizerFcn::G2ndDerivative(const double *x, double *g2) const
+{
+  // Second derivatives estimated in the numerical calculation of the gradient
+  if (!_gradient) return;
+  _gradient->calculate(x);
+  std::copy(_gradient->_g2Ext.begin(), _gradient->_g2Ext.end(), g2);
+}
+
+
+void RooMinimizerFcn::GStepSize(const double *x, double *gstep) const
+{
+  // Step sizes of the numerical calculation of the gradient
+  if (!_gradient) return;
+  _gradient->calculate(x);
+  std::copy(_gradient->_gstepExt.begin(), _gradient->_gstepExt.end(), gstep);
+}
+
 Double_t RooMinimizerFcn::GetPdfParamVal(Int_t index)
 {
   // Access PDF parameter value by ordinal index (needed by MINUIT)
@@ -42,7 +42,10 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealMPFE.h"
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
+#include "RooDirtyGraph.h"
 #include "RooProdPdf.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
 
 ClassImp(RooNLLVar);
 ;
@@ -63,6 +66,7 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() | Define conditional observables
 ///  Verbose()                | Verbose output of GOF framework classes
 ///  CloneData()              | Clone input dataset for internal use (default is kTRUE)
+///  BatchMode()              | Evaluate the p.d.f in batches of events (see setBatchEvaluation())
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -82,6 +86,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
@@ -89,6 +94,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
   _extended = pc.getInt("extended") ;
   _weightSq = kFALSE ;
+  _batchEvaluation = pc.getInt("batchMode") ;
+  _numBatchPartitions = 0 ;
   _first = kTRUE ;
   _offset = 0.;
   _offsetCarry = 0.;
@@ -110,6 +117,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchEvaluation(kFALSE),
+  _numBatchPartitions(0),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -155,6 +164,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchEvaluation(kFALSE),
+  _numBatchPartitions(0),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
@@ -194,6 +205,8 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchEvaluation(other._batchEvaluation),
+  _numBatchPartitions(0),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
   _binw(other._binw) {
@@ -223,6 +236,8 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
       std::swap(_offset, _offsetSaveW2);
       std::swap(_offsetCarry, _offsetCarrySaveW2);
     }
+    for (auto gof : _mtArray)
+      static_cast<RooNLLVar*>(gof)->applyWeightSquared(flag);
     setValueDirty();
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
@@ -235,6 +250,122 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the evaluation of the p.d.f in batches of events.
+///
+/// In batch mode the unbinned likelihood asks the p.d.f for its values in a
+/// whole range of events at once (see RooAbsReal::getValBatch()), which the
+/// p.d.f.s supporting it compute in tight loops over the columns of the
+/// dataset, instead of loading the events one by one. The result is exactly
+/// the same as in the event by event evaluation, to which the likelihood
+/// falls back whenever the batch cannot be computed (p.d.f not supporting it,
+/// evaluation errors, weights squared, data not stored in a RooVectorDataStore).
+///
+/// The flag must be set before the first evaluation of a likelihood using
+/// several processes (NumCPU).
+
+void RooNLLVar::setBatchEvaluation(Bool_t flag)
+{
+  _batchEvaluation = flag ;
+  if ( _gofOpMode==SimMaster) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      ((RooNLLVar*)_gofArray[i])->setBatchEvaluation(flag);
+  }
+  for (auto gof : _mtArray)
+    static_cast<RooNLLVar*>(gof)->setBatchEvaluation(flag);
+  setValueDirty();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of partitions of events of this likelihood, and of its
+/// components, whose terms were computed in batches since its creation. The
+/// partitions evaluated in other processes (NumCPU) are not counted.
+
+Int_t RooNLLVar::numBatchPartitions() const
+{
+  Int_t num = _numBatchPartitions ;
+  if (_gofOpMode==SimMaster) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      num += ((RooNLLVar*)_gofArray[i])->numBatchPartitions() ;
+  }
+  for (auto gof : _mtArray)
+    num += static_cast<RooNLLVar*>(gof)->numBatchPartitions() ;
+  return num ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sum the unbinned likelihood terms of the events in [firstEvent, lastEvent)
+/// with the values of the p.d.f computed in batches of events. The sums are
+/// accumulated in the same order as in evaluatePartition(), so that the result
+/// is identical to the one of the event by event evaluation.
+///
+/// Nothing is added to the sums, and kFALSE is returned, if the p.d.f or the
+/// dataset do not support the batch evaluation, or if an event would raise
+/// an evaluation error or warning. The caller should then evaluate the events
+/// one by one, which reports the errors as usual.
+
+Bool_t RooNLLVar::evaluateBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+                                         Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  const Int_t batchSize = 1024 ;
+
+  if (!dynamic_cast<RooDataSet*>(_dataClone)) return kFALSE ;
+  const RooVectorDataStore* store = dynamic_cast<const RooVectorDataStore*>(_dataClone->store()) ;
+  if (!store || firstEvent>=lastEvent) return kFALSE ;
+  const Double_t* weights = store->weightArray() ;
+  if (!weights && store->isWeighted()) return kFALSE ;
+
+  RooAbsReal::BatchInputs inputs(*_funcObsSet) ;
+  store->fillBatchInputs(inputs) ;
+
+  // Load a valid event in the observables for the parts of the p.d.f that
+  // are evaluated only once per batch
+  _dataClone->get(firstEvent) ;
+
+  const RooAbsPdf* pdfClone = static_cast<const RooAbsPdf*>(_funcClone) ;
+  std::vector<Double_t> probs(batchSize) ;
+  Double_t batchResult(result), batchCarry(carry), batchSumWeight(sumWeight), batchSumWeightCarry(sumWeightCarry) ;
+
+  for (Int_t begin=firstEvent ; begin<lastEvent ; begin+=batchSize) {
+    const Int_t nEvents = std::min(batchSize, lastEvent-begin) ;
+    inputs.setFirstEvent(begin) ;
+    if (!pdfClone->getValBatch(probs.data(), nEvents, inputs, _normSet)) return kFALSE ;
+
+    for (Int_t j=0 ; j<nEvents ; j++) {
+      const Double_t eventWeight = weights ? weights[begin+j] : 1. ;
+      if (0. == eventWeight * eventWeight) continue ;
+
+      // Conditions under which getLogVal() warns or logs an evaluation error
+      const Double_t prob = probs[j] ;
+      if (!(prob>0) || fabs(prob)>1e6) return kFALSE ;
+
+      Double_t term = -eventWeight * log(prob) ;
+
+      Double_t y = eventWeight - batchSumWeightCarry;
+      Double_t t = batchSumWeight + y;
+      batchSumWeightCarry = (t - batchSumWeight) - y;
+      batchSumWeight = t;
+
+      y = term - batchCarry;
+      t = batchResult + y;
+      batchCarry = (t - batchResult) - y;
+      batchResult = t;
+    }
+  }
+
+  result = batchResult ;
+  carry = batchCarry ;
+  sumWeight = batchSumWeight ;
+  sumWeightCarry = batchSumWeightCarry ;
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return likelihood on subset of data.
 /// \param[in] firstEvent First event to be processed.
@@ -258,6 +389,8 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   // cout << "RooNLLVar::evaluatePartition(" << GetName() << ") projDeps = " << (_projDeps?*_projDeps:RooArgSet()) << endl ;
 
+  updateFuncGraph() ;
+
   _dataClone->store()->recalculateCache( _projDeps, firstEvent, lastEvent, stepSize,(_binnedPdf?kFALSE:kTRUE) ) ;
 
   Double_t sumWeight(0), sumWeightCarry(0);
@@ -308,6 +441,18 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
     }
 
 
+  } else if (_batchEvaluation && stepSize==1 && !_weightSq &&
+             evaluateBatchPartition(firstEvent, lastEvent, result, carry, sumWeight, sumWeightCarry)) {
+
+    // The events were processed in batches, only the extended term is missing
+    ++_numBatchPartitions ;
+    if(_extended && _setNum==_extSet) {
+      Double_t y = pdfClone->extendedTerm(_dataClone->sumEntries(), _dataClone->get()) - carry;
+      Double_t t = result + y;
+      carry = (t - result) - y;
+      result = t;
+    }
+
   } else {
 
     for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
@@ -320,6 +465,7 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
       if (0. == eventWeight * eventWeight) continue ;
       if (_weightSq) eventWeight = _dataClone->weightSquared() ;
 
+      if (_funcGraph) _funcGraph->evaluateFunctions() ;
       Double_t term = -eventWeight * pdfClone->getLogVal(_normSet);
 
 
@@ -129,3 +129,23 @@ const TNamed* RooNameReg::known(const char* inStr)
   const auto elm = reg._map.find(inStr);
   return elm != reg._map.end() ? elm->second.get() : nullptr;
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of times a RooAbsArg has been renamed. Caches indexed
+/// by name pointer compare it to the value at the time they were filled to
+/// detect stale entries.
+
+std::size_t RooNameReg::renameCounter()
+{
+  return instance()._renameCounter;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record that a RooAbsArg changed its name.
+
+void RooNameReg::incrementRenameCounter()
+{
+  ++instance()._renameCounter;
+}
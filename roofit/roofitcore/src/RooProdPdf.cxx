@@ -473,6 +473,40 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): multiply the batch values of the terms of the
+/// product, each with its own normalization set. As in calculate(), the
+/// running product of an event is not updated any more once it is below the
+/// cut-off.
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t nEvents, const BatchInputs& inputs, const RooArgSet* normSet) const
+{
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(normSet,0,&code) ;
+  if (!cache) {
+    code = getPartIntList(normSet, nullptr) ;
+    cache = (CacheElem*) _cacheMgr.getObj(normSet,0,&code) ;
+  }
+  if (!cache || cache->_isRearranged) return kFALSE ;
+
+  std::fill(output, output + nEvents, 1.0) ;
+  std::vector<Double_t> buffer ;
+  const Double_t* piVal ;
+  for (std::size_t i = 0; i < cache->_partList.size(); ++i) {
+    const auto& partInt = static_cast<const RooAbsReal&>(cache->_partList[i]);
+    const auto partNormSet = cache->_normList[i].get();
+    if (!getServerBatch(partInt, buffer, piVal, nEvents, inputs, partNormSet->getSize() > 0 ? partNormSet : nullptr)) {
+      return kFALSE ;
+    }
+    for (Int_t j = 0; j < nEvents; ++j) {
+      output[j] = output[j] <= _cutOff ? output[j] : output[j] * piVal[j] ;
+    }
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
 /// normalization set in 'normSetList' for each component
@@ -74,7 +74,8 @@ RooVectorDataStore::RooVectorDataStore() :
   _curWgtErr(0),
   _cache(0),
   _cacheOwner(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(kFALSE)
 {
   TRACE_CREATE
 }
@@ -106,7 +107,8 @@ RooVectorDataStore::RooVectorDataStore(const char* name, const char* title, cons
   _curWgtErr(0),
   _cache(0),
   _cacheOwner(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(kFALSE)
 {
   TIterator* iter = _varsww.createIterator() ;
   RooAbsArg* arg ;
@@ -201,7 +203,8 @@ RooVectorDataStore::RooVectorDataStore(const RooVectorDataStore& other, const ch
   _curWgtErr(other._curWgtErr),
   _cache(0),
   _cacheOwner(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(other._compact)
 {
   vector<RealVector*>::const_iterator oiter = other._realStoreList.begin() ;
   for (; oiter!=other._realStoreList.end() ; ++oiter) {
@@ -255,7 +258,8 @@ RooVectorDataStore::RooVectorDataStore(const RooTreeDataStore& other, const RooA
   _curWgtErr(0),
   _cache(0),
   _cacheOwner(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(kFALSE)
 {
   TIterator* iter = _varsww.createIterator() ;
   RooAbsArg* arg ;
@@ -300,7 +304,8 @@ RooVectorDataStore::RooVectorDataStore(const RooVectorDataStore& other, const Ro
   _curWgtErrHi(other._curWgtErrHi),
   _curWgtErr(other._curWgtErr),
   _cache(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(other._compact)
 {
   vector<RealVector*>::const_iterator oiter = other._realStoreList.begin() ;
   for (; oiter!=other._realStoreList.end() ; ++oiter) {
@@ -378,7 +383,8 @@ RooVectorDataStore::RooVectorDataStore(const char *name, const char *title, RooA
   _curWgtErrHi(0),
   _curWgtErr(0),
   _cache(0),
-  _forcedUpdate(kFALSE)
+  _forcedUpdate(kFALSE),
+  _compact(dynamic_cast<RooVectorDataStore*>(&tds) ? static_cast<RooVectorDataStore&>(tds)._compact : kFALSE)
 {
   TIterator* iter = _varsww.createIterator() ;
   RooAbsArg* arg ;
@@ -1288,6 +1294,119 @@ void RooVectorDataStore::forceCacheUpdate()
 
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Switch the storage of the columns to the compact (flag=kTRUE) or to the
+/// regular form. In the compact form the values of the real-valued columns
+/// are stored in single precision, and only the state indices of the
+/// categories are stored. This reduces the memory used by an event with
+/// n real observables from 8n to 4n bytes, plus about 300 bytes less for
+/// each category.
+///
+/// The values are converted to double precision when an event is loaded,
+/// and the likelihoods are accumulated in double precision as for the
+/// regular form. The event weights, the errors of the real-valued columns,
+/// which are only stored if the dataset was requested to store them, and the
+/// values cached by the constant term optimisation are kept in double
+/// precision. The columns added later follow the form of the store. Note
+/// that the batch evaluation of the likelihood (see RooFit::BatchMode()) is
+/// not available for columns in compact form.
+///
+/// The columns in compact form are written with the class version
+/// kCompactStreamerVersion. ROOT versions without the compact form do not
+/// know this version: they skip these columns with an error.
+
+void RooVectorDataStore::setCompact(Bool_t flag)
+{
+  for (auto realVec : _realStoreList) {
+    realVec->setCompact(flag && !isWeightColumn(realVec->bufArg())) ;
+  }
+  for (auto realfVec : _realfStoreList) {
+    realfVec->setCompact(flag && !isWeightColumn(realfVec->bufArg())) ;
+  }
+  for (auto catVec : _catStoreList) {
+    catVec->setCompact(flag) ;
+  }
+  _compact = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if arg is the weight variable of this store
+
+Bool_t RooVectorDataStore::isWeightColumn(const RooAbsArg* arg) const
+{
+  return _wgtVar && arg->namePtr()==_wgtVar->namePtr() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the approximate number of bytes used by the stored values, including
+/// the errors but not the optimisation cache.
+
+std::size_t RooVectorDataStore::memoryUsage() const
+{
+  std::size_t ret(0) ;
+  for (auto realVec : _realStoreList) {
+    ret += realVec->_vec.capacity()*sizeof(Double_t) + realVec->_vecF.capacity()*sizeof(Float_t) ;
+  }
+  for (auto realfVec : _realfStoreList) {
+    ret += realfVec->_vec.capacity()*sizeof(Double_t) + realfVec->_vecF.capacity()*sizeof(Float_t) ;
+    if (realfVec->_vecE) ret += realfVec->_vecE->capacity()*sizeof(Double_t) ;
+    if (realfVec->_vecEL) ret += realfVec->_vecEL->capacity()*sizeof(Double_t) ;
+    if (realfVec->_vecEH) ret += realfVec->_vecEH->capacity()*sizeof(Double_t) ;
+  }
+  for (auto catVec : _catStoreList) {
+    ret += catVec->_vec.capacity()*sizeof(RooCatType) + catVec->_vecI.capacity()*sizeof(Int_t) ;
+  }
+  return ret ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the arrays of values of the real observables and of the cached
+/// nodes stored here in inputs, for the evaluation of a function in batches of
+/// events (see RooAbsReal::getValBatch()).
+
+void RooVectorDataStore::fillBatchInputs(RooAbsReal::BatchInputs& inputs) const
+{
+  // Columns stored in single precision are not registered, the functions
+  // depending on them are evaluated event by event
+  for (auto realVec : _realStoreList) {
+    if (realVec->size()>0 && !realVec->isCompact()) inputs.addColumn(*realVec->bufArg(), realVec->data().data()) ;
+  }
+  for (auto realfVec : _realfStoreList) {
+    if (realfVec->size()>0 && !realfVec->isCompact()) inputs.addColumn(*realfVec->bufArg(), realfVec->data().data()) ;
+  }
+  if (_cache) {
+    _cache->fillBatchInputs(inputs) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the array of the weights of all the events, or a null pointer if
+/// the store is not weighted.
+
+const Double_t* RooVectorDataStore::weightArray() const
+{
+  if (_extWgtArray) return _extWgtArray ;
+  if (_wgtVar) {
+    for (auto realVec : _realStoreList) {
+      if (realVec->bufArg()->namePtr()==_wgtVar->namePtr()) return realVec->data().data() ;
+    }
+    for (auto realfVec : _realfStoreList) {
+      if (realfVec->bufArg()->namePtr()==_wgtVar->namePtr()) return realfVec->data().data() ;
+    }
+  }
+  return nullptr ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::recalculateCache( const RooArgSet *projectedArgs, Int_t firstEvent, Int_t lastEvent, Int_t stepSize, Bool_t skipZeroWeights) 
@@ -1476,9 +1595,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << ((*iter)->isCompact() ? (*iter)->_vecF[i] : (*iter)->_vec[i]) << " " ;
     }
     cout << endl ;
   }    
@@ -1488,9 +1607,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << ((*iter2)->isCompact() ? (*iter2)->_vecF[i] : (*iter2)->_vec[i]) << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -1542,12 +1661,30 @@ void RooVectorDataStore::Streamer(TBuffer &R__b)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class RooVectorDataStore::RealVector.
+/// A column in compact form is written as a record of version
+/// kCompactStreamerVersion holding the regular class buffer, so that the
+/// ROOT versions that cannot read its values skip it with an error instead
+/// of reading it as empty.
 
 void RooVectorDataStore::RealVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
-      R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
+      UInt_t R__s, R__c;
+      Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v==kCompactStreamerVersion) {
+         R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
+         R__b.CheckByteCount(R__s, R__c, RooVectorDataStore::RealVector::Class());
+      } else {
+         R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this,R__v,R__s,R__c);
+      }
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
+   } else if (_compact) {
+      const UInt_t R__cntpos = R__b.Length();
+      R__b << UInt_t(0); // space for the byte count
+      R__b << Version_t(kCompactStreamerVersion);
+      R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
+      R__b.SetByteCount(R__cntpos, kTRUE);
    } else {
       R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
    }
@@ -1574,12 +1711,27 @@ void RooVectorDataStore::RealFullVector::Streamer(TBuffer &R__b)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class RooVectorDataStore::CatVector.
+/// A column in compact form is written as for RealVector::Streamer().
 
 void RooVectorDataStore::CatVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
-      R__b.ReadClassBuffer(RooVectorDataStore::CatVector::Class(),this);
+      UInt_t R__s, R__c;
+      Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+      if (R__v==kCompactStreamerVersion) {
+         R__b.ReadClassBuffer(RooVectorDataStore::CatVector::Class(),this);
+         R__b.CheckByteCount(R__s, R__c, RooVectorDataStore::CatVector::Class());
+      } else {
+         R__b.ReadClassBuffer(RooVectorDataStore::CatVector::Class(),this,R__v,R__s,R__c);
+      }
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecI0 = _vecI.size()>0 ? &_vecI.front() : 0 ;
+   } else if (_compact) {
+      const UInt_t R__cntpos = R__b.Length();
+      R__b << UInt_t(0); // space for the byte count
+      R__b << Version_t(kCompactStreamerVersion);
+      R__b.WriteClassBuffer(RooVectorDataStore::CatVector::Class(),this);
+      R__b.SetByteCount(R__cntpos, kTRUE);
    } else {
       R__b.WriteClassBuffer(RooVectorDataStore::CatVector::Class(),this);
    }
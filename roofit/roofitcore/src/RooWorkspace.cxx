@@ -146,6 +146,7 @@ void RooWorkspace::autoImportClassCode(Bool_t flag)
 
 RooWorkspace::RooWorkspace() : _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
 {
+  _allOwnedNodes.useHashMapForFind(kTRUE) ;
 }
 
 
@@ -156,6 +157,7 @@ RooWorkspace::RooWorkspace() : _classes(this), _dir(nullptr), _factory(nullptr),
 RooWorkspace::RooWorkspace(const char* name, const char* title) : 
   TNamed(name,title?title:name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
 {
+  _allOwnedNodes.useHashMapForFind(kTRUE) ;
 }
 
 
@@ -163,6 +165,7 @@ RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  :
   TNamed(name,name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
 {
   // Construct empty workspace with given name and option to export reference to all workspace contents to a CINT namespace with the same name
+  _allOwnedNodes.useHashMapForFind(kTRUE) ;
   if (doCINTExport) {
     exportToCint(name) ;
   }
@@ -176,6 +179,7 @@ RooWorkspace::RooWorkspace(const RooWorkspace& other) :
   TNamed(other), _uuid(other._uuid), _classes(other._classes,this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
 {
   // Copy owned nodes
+  _allOwnedNodes.useHashMapForFind(kTRUE) ;
   other._allOwnedNodes.snapshot(_allOwnedNodes,kTRUE) ;
 
   // Copy datasets
@@ -2616,30 +2620,25 @@ void RooWorkspace::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
 
       R__b.ReadClassBuffer(RooWorkspace::Class(),this);
-            
-      // Perform any pass-2 schema evolution here
-      RooFIter fiter = _allOwnedNodes.fwdIterator() ;
-      RooAbsArg* node ;
-      while((node=fiter.next())) {
-	node->ioStreamerPass2() ;
-      }
-      RooAbsArg::ioStreamerPass2Finalize() ;
-      
-      // Make expensive object cache of all objects point to intermal copy.
+
+      // The contents were read without going through add(): the name index
+      // is rebuilt at the first lookup
+      _allOwnedNodes.useHashMapForFind(kTRUE) ;
+
+      // Perform any pass-2 schema evolution here, and make expensive object
+      // cache of all objects point to intermal copy in the same pass.
       // Somehow this doesn't work OK automatically
-      TIterator* iter = _allOwnedNodes.createIterator() ;
-      while((node=(RooAbsArg*)iter->Next())) {
+      for (auto node : _allOwnedNodes) {
+	node->ioStreamerPass2() ;
 	node->setExpensiveObjectCache(_eocache) ;
-   node->setWorkspace(*this);
-   if (node->IsA()->InheritsFrom(RooAbsOptTestStatistic::Class())) {
-      RooAbsOptTestStatistic *tmp = (RooAbsOptTestStatistic *)node;
-      if (tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
-         cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
-              << " : " << tmp->sealNotice() << endl;
-      }
-   }
+	node->setWorkspace(*this);
+	RooAbsOptTestStatistic *tmp = dynamic_cast<RooAbsOptTestStatistic*>(node) ;
+	if (tmp && tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
+	  cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
+	       << " : " << tmp->sealNotice() << endl;
+	}
       }
-      delete iter ;
+      RooAbsArg::ioStreamerPass2Finalize() ;
 
 
    } else {
@@ -0,0 +1,102 @@
+// Tests for the RooFFTConvPdf
+
+#include "RooFFTConvPdf.h"
+#include "RooGaussian.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/// Values of the convolution at a few points of x, normalised over nset
+std::vector<double> sampleConv(RooRealVar& x, const RooFFTConvPdf& conv, const RooArgSet& nset)
+{
+  std::vector<double> values;
+  for (double xVal : {-4., -1.5, 0., 0.7, 2.5, 6.}) {
+    x.setVal(xVal);
+    values.push_back(conv.getVal(nset));
+  }
+  return values;
+}
+
+void expectSameValues(const std::vector<double>& values, const std::vector<double>& reference)
+{
+  ASSERT_EQ(values.size(), reference.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_NEAR(values[i], reference[i], 1.E-12 * std::abs(reference[i])) << "point " << i;
+  }
+}
+
+}
+
+/// Changing the parameters of only one input must give the same convolution
+/// as transforming both inputs again, whichever input changes.
+TEST(RooFFTConvPdf, ReuseTransforms)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  x.setBins(1000, "cache");
+  RooRealVar mean1("mean1", "mean1", 0.5, -5., 5.);
+  RooRealVar sigma1("sigma1", "sigma1", 1.5, 0.1, 5.);
+  RooGaussian pdf1("pdf1", "pdf1", x, mean1, sigma1);
+  RooRealVar mean2("mean2", "mean2", 0., -5., 5.);
+  RooRealVar sigma2("sigma2", "sigma2", 0.8, 0.1, 5.);
+  RooGaussian pdf2("pdf2", "pdf2", x, mean2, sigma2);
+
+  // The reference has another name, so its cache is not taken from the one of conv
+  RooFFTConvPdf conv("conv", "conv", x, pdf1, pdf2);
+  RooFFTConvPdf convRef("convRef", "convRef", x, pdf1, pdf2);
+  convRef.setReuseTransforms(kFALSE);
+  EXPECT_TRUE(conv.reuseTransforms());
+  EXPECT_FALSE(convRef.reuseTransforms());
+
+  const RooArgSet nset(x);
+  const std::vector<double> initial = sampleConv(x, conv, nset);
+  expectSameValues(initial, sampleConv(x, convRef, nset));
+
+  // Change pdf1 only: the transform of pdf2 is kept
+  mean1.setVal(-0.7);
+  sigma1.setVal(2.1);
+  const std::vector<double> changed1 = sampleConv(x, conv, nset);
+  expectSameValues(changed1, sampleConv(x, convRef, nset));
+  EXPECT_NE(changed1[2], initial[2]);
+
+  // Change pdf2 only: the transform of pdf1 is kept
+  sigma2.setVal(1.4);
+  const std::vector<double> changed2 = sampleConv(x, conv, nset);
+  expectSameValues(changed2, sampleConv(x, convRef, nset));
+  EXPECT_NE(changed2[2], changed1[2]);
+}
+
+/// Convolutions with the same number of sampling points share one plan.
+TEST(RooFFTConvPdf, SharedPlans)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  x.setBins(1000, "cache");
+  RooRealVar mean("mean", "mean", 0.5, -5., 5.);
+  RooRealVar sigma1("sigma1", "sigma1", 1.5, 0.1, 5.);
+  RooRealVar sigma2("sigma2", "sigma2", 0.8, 0.1, 5.);
+  RooGaussian pdf1("pdf1", "pdf1", x, mean, sigma1);
+  RooGaussian pdf2("pdf2", "pdf2", x, mean, sigma2);
+
+  RooRealVar y("y", "y", -10., 10.);
+  y.setBins(500, "cache");
+  RooGaussian pdf3("pdf3", "pdf3", y, mean, sigma1);
+  RooGaussian pdf4("pdf4", "pdf4", y, mean, sigma2);
+
+  RooFFTConvPdf convA("convA", "convA", x, pdf1, pdf2);
+  RooFFTConvPdf convB("convB", "convB", x, pdf2, pdf1);
+  RooFFTConvPdf convY("convY", "convY", y, pdf3, pdf4);
+
+  const RooArgSet nsetX(x);
+  const RooArgSet nsetY(y);
+  const RooFFTConvPdf::FFTPlans* plansA = convA.fftPlans(&nsetX);
+  const RooFFTConvPdf::FFTPlans* plansB = convB.fftPlans(&nsetX);
+  const RooFFTConvPdf::FFTPlans* plansY = convY.fftPlans(&nsetY);
+  ASSERT_NE(plansA, nullptr);
+  ASSERT_NE(plansY, nullptr);
+  EXPECT_EQ(plansA, plansB);
+  EXPECT_NE(plansA, plansY);
+}
@@ -0,0 +1,97 @@
+// Tests for the RooMCStudy
+
+#include "RooDataSet.h"
+#include "RooExponential.h"
+#include "RooGaussian.h"
+#include "RooGlobalFunc.h"
+#include "RooMCStudy.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+/// Samples generated and fitted in two worker processes must be the same as
+/// the ones of a run in this process that seeds every sample in the same way.
+TEST(RooMCStudy, ParallelMatchesSequential)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar mean("mean", "mean", 1., -5., 5.);
+  RooRealVar sigma("sigma", "sigma", 2., 0.1, 10.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  const Int_t nSamples = 7;
+
+  RooMCStudy parallel(gauss, x, RooFit::Silence(), RooFit::FitOptions(RooFit::PrintLevel(-1)));
+  parallel.setNumWorkers(2);
+  parallel.setSamplesPerTask(3);
+  RooRandom::randomGenerator()->SetSeed(4321);
+  parallel.generateAndFit(nSamples, 200);
+
+  RooMCStudy sequential(gauss, x, RooFit::Silence(), RooFit::FitOptions(RooFit::PrintLevel(-1)));
+  sequential.setSeedPerSample(kTRUE);
+  RooRandom::randomGenerator()->SetSeed(4321);
+  sequential.generateAndFit(nSamples, 200);
+
+  const RooDataSet& parallelPars = parallel.fitParDataSet();
+  const RooDataSet& sequentialPars = sequential.fitParDataSet();
+  ASSERT_EQ(parallelPars.numEntries(), nSamples);
+  ASSERT_EQ(sequentialPars.numEntries(), nSamples);
+
+  for (Int_t i = 0; i < nSamples; ++i) {
+    const RooArgSet* parallelRow = parallelPars.get(i);
+    const Double_t parallelMean = parallelRow->getRealValue("mean");
+    const Double_t parallelSigma = parallelRow->getRealValue("sigma");
+    const RooArgSet* sequentialRow = sequentialPars.get(i);
+    EXPECT_DOUBLE_EQ(parallelMean, sequentialRow->getRealValue("mean")) << "sample " << i;
+    EXPECT_DOUBLE_EQ(parallelSigma, sequentialRow->getRealValue("sigma")) << "sample " << i;
+  }
+
+  // The samples differ from each other
+  const Double_t firstMean = parallelPars.get(0)->getRealValue("mean");
+  EXPECT_NE(firstMean, parallelPars.get(1)->getRealValue("mean"));
+}
+
+/// With a p.d.f. generated by accept/reject sampling, whose sampler keeps the
+/// trial events it has not used, a sample must not depend on the samples
+/// generated before it in the same process, whatever the number of samples
+/// per task.
+TEST(RooMCStudy, AcceptRejectIndependentOfTasks)
+{
+  const Int_t nSamples = 6;
+
+  // Fitted slopes of a study run from scratch, so that no fit of a previous
+  // study changes the starting point.
+  auto runStudy = [nSamples](Int_t nWorkers, Int_t samplesPerTask) {
+    RooRealVar x("x", "x", 0., 10.);
+    RooRealVar c("c", "c", -0.4, -2., 0.);
+    RooExponential expo("expo", "expo", x, c);
+
+    RooMCStudy study(expo, x, RooFit::Silence(), RooFit::FitOptions(RooFit::PrintLevel(-1)));
+    study.setNumWorkers(nWorkers);
+    study.setSamplesPerTask(samplesPerTask);
+    study.setSeedPerSample(kTRUE);
+    RooRandom::randomGenerator()->SetSeed(2468);
+    study.generateAndFit(nSamples, 300);
+
+    std::vector<Double_t> slopes;
+    for (Int_t i = 0; i < study.fitParDataSet().numEntries(); ++i) {
+      slopes.push_back(study.fitParDataSet().get(i)->getRealValue("c"));
+    }
+    return slopes;
+  };
+
+  const std::vector<Double_t> sequential = runStudy(1, 100);
+  const std::vector<Double_t> parallel1 = runStudy(2, 1);
+  const std::vector<Double_t> parallel4 = runStudy(2, 4);
+  ASSERT_EQ(sequential.size(), std::size_t(nSamples));
+  ASSERT_EQ(parallel1.size(), sequential.size());
+  ASSERT_EQ(parallel4.size(), sequential.size());
+
+  for (Int_t i = 0; i < nSamples; ++i) {
+    EXPECT_DOUBLE_EQ(sequential[i], parallel1[i]) << "sample " << i;
+    EXPECT_DOUBLE_EQ(sequential[i], parallel4[i]) << "sample " << i;
+  }
+  EXPECT_NE(sequential[0], sequential[1]);
+}
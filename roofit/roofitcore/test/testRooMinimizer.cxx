@@ -0,0 +1,66 @@
+// Tests for the RooMinimizer
+
+#include "RooAddPdf.h"
+#include "RooDataSet.h"
+#include "RooExponential.h"
+#include "RooGaussian.h"
+#include "RooMinimizer.h"
+#include "RooMsgService.h"
+#include "RooNLLVar.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+/// A fit using the gradient calculated in parallel by RooFit must find the same
+/// minimum as a fit using the gradient calculated by MINUIT.
+TEST(RooMinimizer, ParallelGradient)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+  RooRandom::randomGenerator()->SetSeed(2468);
+
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar c("c", "c", -0.3, -2., 0.);
+  RooRealVar frac("frac", "frac", 0.4, 0., 1.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooExponential expo("expo", "expo", x, c);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(frac));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 5000));
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data));
+  RooArgSet params(mean, sigma, c, frac);
+  std::unique_ptr<RooArgSet> initial(static_cast<RooArgSet *>(params.snapshot()));
+
+  RooMinimizer m1(*nll);
+  m1.setMinimizerType("Minuit2");
+  m1.setPrintLevel(-1);
+  EXPECT_EQ(m1.migrad(), 0);
+  EXPECT_EQ(0, m1.parallelGradientWorkers());
+  EXPECT_EQ(0, m1.parallelGradientCount());
+  std::unique_ptr<RooArgSet> serial(static_cast<RooArgSet *>(params.snapshot()));
+
+  params = *initial;
+  RooMinimizer m2(*nll);
+  m2.setMinimizerType("Minuit2");
+  m2.setPrintLevel(-1);
+  m2.setParallelGradient(2);
+  EXPECT_EQ(m2.migrad(), 0);
+  // The minimizer works on a copy of the function, sharing its gradient workers.
+  EXPECT_EQ(2, m2.parallelGradientWorkers());
+  EXPECT_LT(0, m2.parallelGradientCount());
+
+  // Changing the workers does not invalidate the copy of the function held by
+  // the fitter, which keeps its workers until the next minimization.
+  m2.setParallelGradient(0);
+  EXPECT_EQ(2, m2.parallelGradientWorkers());
+
+  for (auto arg : params) {
+    auto par = static_cast<RooRealVar *>(arg);
+    auto ref = static_cast<RooRealVar *>(serial->find(par->GetName()));
+    EXPECT_NEAR(par->getVal(), ref->getVal(), 0.1 * ref->getError()) << par->GetName();
+  }
+}
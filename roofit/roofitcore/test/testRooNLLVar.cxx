@@ -0,0 +1,355 @@
+// Tests for the RooNLLVar
+
+#include "RooAbsOptTestStatistic.h"
+#include "RooAddPdf.h"
+#include "RooCategory.h"
+#include "RooChebychev.h"
+#include "RooDataSet.h"
+#include "RooDirtyGraph.h"
+#include "RooExponential.h"
+#include "RooFormulaVar.h"
+#include "RooGaussian.h"
+#include "RooGlobalFunc.h"
+#include "RooNLLVar.h"
+#include "RooPolynomial.h"
+#include "RooProdPdf.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+#include "RooVectorDataStore.h"
+
+#include "TBufferFile.h"
+#include "TMemFile.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+/// The likelihood evaluated in batches of events must be identical to the one
+/// evaluated event by event, also after changing the parameters.
+TEST(RooNLLVar, BatchModeAddPdf)
+{
+  RooRandom::randomGenerator()->SetSeed(1234);
+
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar c("c", "c", -0.3, -2., 0.);
+  RooRealVar frac("frac", "frac", 0.4, 0., 1.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooExponential expo("expo", "expo", x, c);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(frac));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 5000));
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data));
+  std::unique_ptr<RooAbsReal> nllBatch(model.createNLL(*data, RooFit::BatchMode()));
+  auto nllVar = dynamic_cast<RooNLLVar*>(nll.get());
+  auto nllBatchVar = dynamic_cast<RooNLLVar*>(nllBatch.get());
+  ASSERT_NE(nullptr, nllVar);
+  ASSERT_NE(nullptr, nllBatchVar);
+  EXPECT_EQ(nll->getVal(), nllBatch->getVal());
+  EXPECT_EQ(0, nllVar->numBatchPartitions());
+  const Int_t numBatchPartitions = nllBatchVar->numBatchPartitions();
+  EXPECT_LT(0, numBatchPartitions);
+
+  mean.setVal(4.5);
+  sigma.setVal(1.3);
+  c.setVal(-0.5);
+  frac.setVal(0.7);
+  EXPECT_EQ(nll->getVal(), nllBatch->getVal());
+  EXPECT_LT(numBatchPartitions, nllBatchVar->numBatchPartitions());
+}
+
+/// Same for a product of p.d.f.s, a weighted dataset and an extended likelihood.
+TEST(RooNLLVar, BatchModeProdPdfWeighted)
+{
+  RooRandom::randomGenerator()->SetSeed(4321);
+
+  RooRealVar x("x", "x", -1., 1.);
+  RooRealVar y("y", "y", 0., 2.);
+  RooRealVar a0("a0", "a0", 0.2, -1., 1.);
+  RooRealVar a1("a1", "a1", -0.1, -1., 1.);
+  RooRealVar p1("p1", "p1", 0.5, -1., 1.);
+  RooRealVar n("n", "n", 1000., 0., 5000.);
+  RooChebychev cheby("cheby", "cheby", x, RooArgList(a0, a1));
+  RooPolynomial poly("poly", "poly", y, RooArgList(p1));
+  RooProdPdf prod("prod", "prod", RooArgList(cheby, poly));
+  RooAddPdf model("model", "model", RooArgList(prod), RooArgList(n));
+
+  std::unique_ptr<RooDataSet> gen(prod.generate(RooArgSet(x, y), 2000));
+  RooFormulaVar wFunc("w", "w", "1.5+0.5*x", RooArgList(x));
+  RooRealVar* w = static_cast<RooRealVar*>(gen->addColumn(wFunc));
+  RooDataSet data("data", "data", gen.get(), *gen->get(), 0, w->GetName());
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(data, RooFit::Extended()));
+  std::unique_ptr<RooAbsReal> nllBatch(model.createNLL(data, RooFit::Extended(), RooFit::BatchMode()));
+  auto nllBatchVar = dynamic_cast<RooNLLVar*>(nllBatch.get());
+  ASSERT_NE(nullptr, nllBatchVar);
+  EXPECT_EQ(nll->getVal(), nllBatch->getVal());
+  const Int_t numBatchPartitions = nllBatchVar->numBatchPartitions();
+  EXPECT_LT(0, numBatchPartitions);
+
+  a1.setVal(0.3);
+  p1.setVal(-0.2);
+  n.setVal(2500.);
+  EXPECT_EQ(nll->getVal(), nllBatch->getVal());
+  EXPECT_LT(numBatchPartitions, nllBatchVar->numBatchPartitions());
+}
+
+/// The likelihood evaluated in several threads only differs from the one
+/// evaluated in a single thread by the order of the summation.
+TEST(RooNLLVar, NumThreads)
+{
+  RooRandom::randomGenerator()->SetSeed(5678);
+
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar c("c", "c", -0.3, -2., 0.);
+  RooRealVar nsig("nsig", "nsig", 2000., 0., 10000.);
+  RooRealVar nbkg("nbkg", "nbkg", 3000., 0., 10000.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooExponential expo("expo", "expo", x, c);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(nsig, nbkg));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 5000));
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data, RooFit::Extended()));
+  std::unique_ptr<RooAbsReal> nllThreads(model.createNLL(*data, RooFit::Extended(), RooFit::NumThreads(4)));
+  EXPECT_NEAR(nll->getVal(), nllThreads->getVal(), 1.E-10 * std::abs(nll->getVal()));
+
+  mean.setVal(4.5);
+  sigma.setVal(1.3);
+  c.setVal(-0.5);
+  nsig.setVal(2500.);
+  EXPECT_NEAR(nll->getVal(), nllThreads->getVal(), 1.E-10 * std::abs(nll->getVal()));
+}
+
+/// The likelihood with the dirty state propagated over compiled graphs must
+/// be identical to the one with the recursive propagation, also when the
+/// parameters are changed one at a time and several times in a row.
+TEST(RooNLLVar, DirtyGraph)
+{
+  RooRandom::randomGenerator()->SetSeed(8765);
+
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar shift("shift", "shift", 0.2, -1., 1.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar c("c", "c", -0.3, -2., 0.);
+  RooRealVar frac1("frac1", "frac1", 0.4, 0., 1.);
+  RooRealVar frac2("frac2", "frac2", 0.3, 0., 1.);
+  RooFormulaVar mean2("mean2", "mean2", "mean+shift", RooArgList(mean, shift));
+  RooFormulaVar sigma2("sigma2", "sigma2", "2*sigma", RooArgList(sigma));
+  RooGaussian gauss1("gauss1", "gauss1", x, mean, sigma);
+  RooGaussian gauss2("gauss2", "gauss2", x, mean2, sigma2);
+  RooExponential expo("expo", "expo", x, c);
+  RooAddPdf model("model", "model", RooArgList(gauss1, gauss2, expo), RooArgList(frac1, frac2));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 2000));
+
+  // The reference likelihood uses the recursive propagation
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data));
+  std::unique_ptr<RooAbsReal> nllGraph(model.createNLL(*data));
+  auto nllVar = dynamic_cast<RooAbsOptTestStatistic*>(nll.get());
+  auto nllGraphVar = dynamic_cast<RooAbsOptTestStatistic*>(nllGraph.get());
+  ASSERT_NE(nullptr, nllVar);
+  ASSERT_NE(nullptr, nllGraphVar);
+  nllGraphVar->setDirtyGraphCompilation(true);
+  EXPECT_FALSE(nllVar->dirtyGraphCompilation());
+
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+  EXPECT_EQ(nullptr, nllVar->dirtyGraph());
+  const RooDirtyGraph* graph = nllGraphVar->dirtyGraph();
+  ASSERT_NE(nullptr, graph);
+  ASSERT_TRUE(graph->isValid());
+
+  // The change of a parameter is propagated over the graph, which evaluates
+  // the dirty nodes. The nodes depending on x are recalculated for every
+  // event (ADirty) and are never marked, only the parameter-only mean2 is.
+  auto isDirty = [graph](const char* name) {
+    auto dirty = graph->dirtyNodes();
+    return dirty.end() != std::find_if(dirty.begin(), dirty.end(),
+                                       [name](RooAbsArg* arg) { return std::string(arg->GetName()) == name; });
+  };
+  shift.setVal(-0.3);
+  EXPECT_TRUE(isDirty("mean2"));
+  EXPECT_FALSE(isDirty("gauss2"));
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+  EXPECT_TRUE(graph->dirtyNodes().empty());
+
+  mean.setVal(4.8);
+  EXPECT_TRUE(isDirty("mean2"));
+  EXPECT_FALSE(isDirty("gauss1"));
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+
+  mean.setVal(4.5);
+  sigma.setVal(1.3);
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+
+  c.setVal(-0.5);
+  frac1.setVal(0.3);
+  mean.setVal(5.2);
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+
+  nllGraphVar->setDirtyGraphCompilation(false);
+  EXPECT_EQ(nll->getVal(), nllGraph->getVal());
+  EXPECT_EQ(nullptr, nllGraphVar->dirtyGraph());
+}
+
+/// The dirty state is propagated through the nodes that are recalculated at
+/// every access (ADirty) to the nodes downstream of them.
+TEST(RooDirtyGraph, ThroughADirty)
+{
+  RooRealVar a("a", "a", 1.);
+  RooRealVar b("b", "b", 2.);
+  RooFormulaVar sum("sum", "sum", "a+b", RooArgList(a, b));
+  RooFormulaVar square("square", "square", "sum*sum", RooArgList(sum));
+  RooFormulaVar top("top", "top", "square+1", RooArgList(square));
+  sum.setOperMode(RooAbsArg::ADirty, kFALSE);
+
+  RooDirtyGraph graph(top);
+  ASSERT_TRUE(graph.isValid());
+  EXPECT_DOUBLE_EQ(10., graph.evaluate());
+  EXPECT_TRUE(graph.dirtyNodes().empty());
+
+  a.setVal(3.);
+  auto dirty = graph.dirtyNodes();
+  ASSERT_EQ(2u, dirty.size());
+  EXPECT_EQ(&square, dirty[0]);
+  EXPECT_EQ(&top, dirty[1]);
+  EXPECT_DOUBLE_EQ(26., graph.evaluate());
+  EXPECT_TRUE(graph.dirtyNodes().empty());
+
+  b.setVal(-1.);
+  EXPECT_DOUBLE_EQ(5., top.getVal());
+}
+
+/// A dataset in compact storage returns the values rounded to single precision
+/// and the same category states, and its likelihood only differs by the rounding.
+TEST(RooNLLVar, CompactStore)
+{
+  RooRandom::randomGenerator()->SetSeed(2468);
+
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar c("c", "c", -0.3, -2., 0.);
+  RooRealVar frac("frac", "frac", 0.4, 0., 1.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooExponential expo("expo", "expo", x, c);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(frac));
+
+  RooCategory tag("tag", "tag");
+  tag.defineType("A", 1);
+  tag.defineType("B", -1);
+
+  std::unique_ptr<RooDataSet> gen(model.generate(x, 5000));
+  RooDataSet data("data", "data", RooArgSet(x, tag));
+  for (int i = 0; i < gen->numEntries(); ++i) {
+    x.setVal(gen->get(i)->getRealValue("x"));
+    tag.setIndex(i % 3 ? 1 : -1);
+    data.add(RooArgSet(x, tag));
+  }
+
+  RooDataSet compact(data, "compact");
+  compact.convertToCompactStore();
+  auto store = dynamic_cast<const RooVectorDataStore*>(compact.store());
+  ASSERT_NE(store, nullptr);
+  EXPECT_TRUE(store->isCompact());
+  EXPECT_LT(store->memoryUsage(), dynamic_cast<const RooVectorDataStore*>(data.store())->memoryUsage() / 4);
+
+  ASSERT_EQ(compact.numEntries(), data.numEntries());
+  for (int i = 0; i < data.numEntries(); ++i) {
+    const RooArgSet* row = data.get(i);
+    const double xVal = row->getRealValue("x");
+    const int tagVal = row->getCatIndex("tag");
+    const RooArgSet* compactRow = compact.get(i);
+    EXPECT_EQ(compactRow->getRealValue("x"), static_cast<double>(static_cast<float>(xVal)));
+    EXPECT_EQ(compactRow->getCatIndex("tag"), tagVal);
+  }
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(data));
+  std::unique_ptr<RooAbsReal> nllCompact(model.createNLL(compact));
+  EXPECT_NEAR(nll->getVal(), nllCompact->getVal(), 1.E-5 * std::abs(nll->getVal()));
+
+  mean.setVal(4.5);
+  sigma.setVal(1.3);
+  EXPECT_NEAR(nll->getVal(), nllCompact->getVal(), 1.E-5 * std::abs(nll->getVal()));
+}
+
+/// The weights of a compact store stay in double precision.
+TEST(RooNLLVar, CompactStoreWeights)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar w("w", "w", 0., 10.);
+  RooDataSet data("data", "data", RooArgSet(x, w), RooFit::WeightVar(w));
+  for (int i = 0; i < 100; ++i) {
+    x.setVal(0.1 * i);
+    data.add(RooArgSet(x), 1. / (i + 3));
+  }
+
+  RooDataSet compact(data, "compact");
+  compact.convertToCompactStore();
+  auto store = dynamic_cast<const RooVectorDataStore*>(compact.store());
+  ASSERT_NE(store, nullptr);
+  ASSERT_NE(store->weightArray(), nullptr);
+
+  for (int i = 0; i < data.numEntries(); ++i) {
+    data.get(i);
+    compact.get(i);
+    EXPECT_EQ(compact.weight(), data.weight());
+    EXPECT_EQ(store->weightArray()[i], 1. / (i + 3));
+  }
+  EXPECT_EQ(compact.sumEntries(), data.sumEntries());
+}
+
+/// A compact store is read back in compact form with the same values. Its
+/// columns are written with a class version that older readers do not know.
+TEST(RooNLLVar, CompactStoreIO)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooCategory tag("tag", "tag");
+  tag.defineType("A", 1);
+  tag.defineType("B", -1);
+  RooDataSet data("data", "data", RooArgSet(x, tag));
+  for (int i = 0; i < 100; ++i) {
+    x.setVal(0.1 * i);
+    tag.setIndex(i % 3 ? 1 : -1);
+    data.add(RooArgSet(x, tag));
+  }
+  data.convertToCompactStore();
+
+  TMemFile file("testCompactStore.root", "RECREATE");
+  file.WriteObject(&data, "data");
+  RooDataSet* readPtr = nullptr;
+  file.GetObject("data", readPtr);
+  std::unique_ptr<RooDataSet> read(readPtr);
+  ASSERT_NE(read, nullptr);
+
+  auto store = dynamic_cast<const RooVectorDataStore*>(read->store());
+  ASSERT_NE(store, nullptr);
+  EXPECT_TRUE(store->isCompact());
+  ASSERT_EQ(read->numEntries(), data.numEntries());
+  for (int i = 0; i < data.numEntries(); ++i) {
+    const RooArgSet* row = data.get(i);
+    const double xVal = row->getRealValue("x");
+    const int tagVal = row->getCatIndex("tag");
+    const RooArgSet* readRow = read->get(i);
+    EXPECT_EQ(readRow->getRealValue("x"), xVal);
+    EXPECT_EQ(readRow->getCatIndex("tag"), tagVal);
+  }
+
+  RooVectorDataStore::RealVector column(&x);
+  column.setCompact(kTRUE);
+  TBufferFile buf(TBuffer::kWrite);
+  column.Streamer(buf);
+  buf.SetReadMode();
+  buf.SetBufferOffset(0);
+  UInt_t start, count;
+  EXPECT_EQ(buf.ReadVersion(&start, &count), RooVectorDataStore::kCompactStreamerVersion);
+}
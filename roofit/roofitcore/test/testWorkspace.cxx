@@ -159,3 +159,61 @@ TEST_F(TestRooWorkspaceWithGaussian, ImportFromFile)
 
 
 
+
+/// Lookups in a large workspace go through the name index of its contents.
+/// They must find the same objects before and after a round trip through a
+/// file, and follow renames and removals.
+TEST(RooWorkspace, LookupInLargeWorkspace)
+{
+  const char* filename = "testWorkspaceLookup.root";
+  const int n = 500;
+  {
+    RooWorkspace w("ws");
+    RooRealVar x("x", "x", -10., 10.);
+    for (int i = 0; i < n; ++i) {
+      RooRealVar mean(Form("mean%d", i), "mean", 0.01 * i, -10., 10.);
+      RooRealVar sigma(Form("sigma%d", i), "sigma", 1., 0.1, 5.);
+      RooGaussian gauss(Form("gauss%d", i), "gauss", x, mean, sigma);
+      w.import(gauss, RooFit::Silence());
+    }
+    ASSERT_NE(w.var("mean123"), nullptr);
+    EXPECT_DOUBLE_EQ(w.var("mean123")->getVal(), 1.23);
+    EXPECT_EQ(w.var("mean123"), w.pdf("gauss123")->findServer("mean123"));
+
+    TFile file(filename, "RECREATE");
+    w.Write();
+  }
+
+  TFile file(filename);
+  auto w = static_cast<RooWorkspace*>(file.Get("ws"));
+  ASSERT_NE(w, nullptr);
+  EXPECT_EQ(w->components().getSize(), 3 * n + 1);
+  ASSERT_NE(w->var("mean321"), nullptr);
+  EXPECT_DOUBLE_EQ(w->var("mean321")->getVal(), 3.21);
+  EXPECT_EQ(w->var("mean321"), w->pdf("gauss321")->findServer("mean321"));
+  EXPECT_EQ(w->var("bogus"), nullptr);
+
+  RooAbsArg* sigma = w->var("sigma42");
+  sigma->SetName("width42");
+  EXPECT_EQ(w->arg("sigma42"), nullptr);
+  EXPECT_EQ(w->arg("width42"), sigma);
+
+  // A removed component is not found any more, the others still are.
+  RooAbsArg* gauss = w->pdf("gauss7");
+  ASSERT_NE(gauss, nullptr);
+  w->RecursiveRemove(gauss);
+  delete gauss;
+  EXPECT_EQ(w->pdf("gauss7"), nullptr);
+  EXPECT_EQ(w->components().getSize(), 3 * n);
+  ASSERT_NE(w->pdf("gauss8"), nullptr);
+  EXPECT_NE(w->var("mean7"), nullptr);
+  EXPECT_EQ(w->var("mean8"), w->pdf("gauss8")->findServer("mean8"));
+
+  // A component imported afterwards with the same name is found.
+  RooGaussian newGauss("gauss7", "gauss", *w->var("x"), *w->var("mean7"), *w->var("sigma7"));
+  w->import(newGauss, RooFit::Silence());
+  ASSERT_NE(w->pdf("gauss7"), nullptr);
+  EXPECT_EQ(w->var("mean7"), w->pdf("gauss7")->findServer("mean7"));
+  delete w;
+  gSystem->Unlink(filename);
+}
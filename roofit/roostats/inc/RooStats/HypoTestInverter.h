@@ -21,6 +21,7 @@ class RooRealVar;
 class TGraphErrors;
 
 #include <memory>
+#include <vector>
 
 
 namespace RooStats {
@@ -137,6 +138,12 @@ public:
    // set numerical error in test statistic evaluation (default is zero)
    void SetNumErr(double err) { fNumErr = err; }
 
+   // set the number of local worker processes running the points of a fixed scan
+   void SetNumWorkers(int nWorkers) { fNWorkers = nWorkers; }
+
+   // set the number of neighbouring points run in a row by a worker
+   void SetPointsPerTask(int nPoints) { fPointsPerTask = nPoints; }
+
    // set flag to close proof for every new run
    static void SetCloseProof(Bool_t flag);
 
@@ -154,6 +161,15 @@ protected:
    // run the hybrid at a single point
    HypoTestResult * Eval( HypoTestCalculatorGeneric &hc, bool adaptive , double clsTarget) const;
 
+   // move a POI value outside the range of the scanned variable to the closest bound
+   double GetValueInRange( double rVal) const;
+
+   // add the result of a point to the HypoTestInverterResult
+   void AddPointResult( double rVal, HypoTestResult * result) const;
+
+   // run the given points in the local worker processes
+   bool RunPointsParallel( const std::vector<double> & points) const;
+
    // helper functions
    static RooRealVar * GetVariableToScan(const HypoTestCalculatorGeneric &hc);
    static void CheckInputModels(const HypoTestCalculatorGeneric &hc, const RooRealVar & scanVar);
@@ -190,6 +206,8 @@ private:
    double fXmin;
    double fXmax;
    double fNumErr;
+   int fNWorkers;        //! number of local worker processes of a fixed scan
+   int fPointsPerTask;   //! number of neighbouring points run in a row by a worker
 
 protected:
 
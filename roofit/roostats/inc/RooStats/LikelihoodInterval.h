@@ -14,6 +14,7 @@
 #include "RooStats/ConfInterval.h"
 
 #include "RooArgSet.h"
+#include "RooArgList.h"
 
 #include "RooAbsReal.h"
 
@@ -72,6 +73,12 @@ namespace RooStats {
       /// return false if the bounds have not been found
       Bool_t FindLimits(const RooRealVar & param, double & lower, double &upper);
 
+      /// find the interval boundaries of several parameters, running MINOS for the
+      /// different parameters in nWorkers local worker processes.
+      /// The boundaries are then returned by LowerLimit and UpperLimit.
+      /// return false if some of the bounds have not been found
+      Bool_t FindLimits(const RooArgList & params, unsigned int nWorkers = 1);
+
       /// return the 2D-contour points for the given subset of parameters
       /// by default make the contour using 30 points. The User has to preallocate the x and y array which will return
       /// the set of x and y points defining the contour.
@@ -84,6 +84,7 @@ class ToyMCSampler: public TestStatSampler {
       virtual SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters,
@@ -232,12 +233,26 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // generate and evaluate the toys in n local processes (1: in this process)
+      void SetNumWorkers(Int_t n) { fNWorkers = n; }
+      Int_t GetNumWorkers() const { return fNWorkers; }
+      // number of toys handed out to a worker process at a time
+      void SetToysPerTask(Int_t n) { fToysPerTask = n; }
+      Int_t GetToysPerTask() const { return fToysPerTask; }
+      // seed every toy with its own seed also when running in this process,
+      // as is always done by the local worker processes
+      void SetSeedPerToy(Bool_t flag) { fSeedPerToy = flag; }
+      Bool_t GetSeedPerToy() const { return fSeedPerToy; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
 
       const RooArgList* EvaluateAllTestStatistics(RooAbsData& data, const RooArgSet& poi, DetailedOutputAggregator& detOutAgg);
 
+      // seed the generator for the next toy if seeds were given
+      void SeedNextToy();
+
       // helper for GenerateToyData
       RooAbsData* Generate(RooAbsPdf &pdf, RooArgSet &observables, const RooDataSet *protoData=NULL, int forceEvents=0) const;
 
@@ -277,6 +292,11 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      Int_t fNWorkers;             //! number of local worker processes
+      Int_t fToysPerTask;          //! number of toys per task of the local worker processes
+      Bool_t fSeedPerToy;          //! seed every toy also when running in this process
+      std::vector<UInt_t> fToySeeds; //! seeds of the toys of the current run (empty: no seeding)
+      UInt_t fNextToySeed;         //! index of the seed of the next toy in fToySeeds
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -27,6 +27,14 @@ The confidence level value at a given point can be done via  HypoTestInverter::R
 The class can scan the CLs+b values or alternatively CLs
 (if the method HypoTestInverter::UseCLs has been called).
 
+The points of a fixed scan do not depend on each other. After calling
+HypoTestInverter::SetNumWorkers with more than one worker, they are evaluated
+in local worker processes, each of them working on a copy of the models and
+of the data. Blocks of neighbouring points (see HypoTestInverter::SetPointsPerTask)
+are run in the same process one after the other, such that the fits of a point
+start from the parameter values of the previous one as in the sequential scan.
+The results are collected in the order of the scanned values.
+
 Contributions to this class have been written by Giovanni Petrucciani and Annapaola Decosa
 */
 
@@ -67,6 +75,15 @@ Contributions to this class have been written by Giovanni Petrucciani and Annapa
 
 #include "RooStats/ProofConfig.h"
 
+#include "RooHelpers.h"
+
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+
 ClassImp(RooStats::HypoTestInverter);
 
 using namespace RooStats;
@@ -175,7 +192,9 @@ HypoTestInverter::HypoTestInverter( ) :
    fVerbose(0),
    fCalcType(kUndefined),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
 }
 
@@ -201,7 +220,9 @@ HypoTestInverter::HypoTestInverter( HypoTestCalculatorGeneric& hc,
    fVerbose(0),
    fCalcType(kUndefined),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
 
    if (!fScannedVariable) {
@@ -254,7 +275,9 @@ HypoTestInverter::HypoTestInverter( HybridCalculator& hc,
    fVerbose(0),
    fCalcType(kHybrid),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
 
    if (!fScannedVariable) {
@@ -287,7 +310,9 @@ HypoTestInverter::HypoTestInverter( FrequentistCalculator& hc,
    fVerbose(0),
    fCalcType(kFrequentist),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
 
    if (!fScannedVariable) {
@@ -319,7 +344,9 @@ HypoTestInverter::HypoTestInverter( AsymptoticCalculator& hc,
    fVerbose(0),
    fCalcType(kAsymptotic),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
 
    if (!fScannedVariable) {
@@ -352,7 +379,9 @@ HypoTestInverter::HypoTestInverter( RooAbsData& data, ModelConfig &sbModel, Mode
    fVerbose(0),
    fCalcType(type),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1),
+   fPointsPerTask(4)
 {
    if(fCalcType==kFrequentist) fHC.reset(new FrequentistCalculator(data, bModel, sbModel));
    if(fCalcType==kHybrid) fHC.reset( new HybridCalculator(data, bModel, sbModel)) ;
@@ -405,6 +434,8 @@ HypoTestInverter & HypoTestInverter::operator= (const HypoTestInverter & rhs) {
    fXmin = rhs.fXmin;
    fXmax = rhs.fXmax;
    fNumErr = rhs.fNumErr;
+   fNWorkers = rhs.fNWorkers;
+   fPointsPerTask = rhs.fPointsPerTask;
 
    return *this;
 }
@@ -637,17 +668,20 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
                                           << xMax << std::endl;
    }
 
-   double thisX = xMin;
-   for (int i=0; i<nBins; i++) {
+   std::vector<double> points(nBins, xMin);
+   for (int i=1; i<nBins; i++) { // avoids case of nBins = 1
+      if (scanLog)
+         points[i] = exp(  log(xMin) +  i*(log(xMax)-log(xMin))/(nBins-1)  );  // scan in log x
+      else
+         points[i] = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x
+   }
 
-      if (i > 0) { // avoids case of nBins = 1
-         if (scanLog)
-            thisX = exp(  log(xMin) +  i*(log(xMax)-log(xMin))/(nBins-1)  );  // scan in log x
-         else
-            thisX = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x
-      }
+   if (fNWorkers > 1 && nBins > 1)
+      return RunPointsParallel(points);
+
+   for (int i=0; i<nBins; i++) {
 
-      bool status = RunOnePoint(thisX);
+      bool status = RunOnePoint(points[i]);
 
       // check if failed status
       if ( status==false ) {
@@ -668,20 +702,7 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
    CreateResults();
 
    // check if rVal is in the range specified for fScannedVariable
-   if ( rVal < fScannedVariable->getMin() ) {
-      oocoutE((TObject*)0,InputArguments) << "HypoTestInverter::RunOnePoint - Out of range: using the lower bound "
-                                          << fScannedVariable->getMin()
-                                          << " on the scanned variable rather than " << rVal<< "\n";
-     rVal = fScannedVariable->getMin();
-   }
-   if ( rVal > fScannedVariable->getMax() ) {
-      // print a message when you have a significative difference since rval is computed
-      if ( rVal > fScannedVariable->getMax()*(1.+1.E-12) )
-         oocoutE((TObject*)0,InputArguments) << "HypoTestInverter::RunOnePoint - Out of range: using the upper bound "
-                                             << fScannedVariable->getMax()
-                                             << " on the scanned variable rather than " << rVal<< "\n";
-     rVal = fScannedVariable->getMax();
-   }
+   rVal = GetValueInRange(rVal);
 
    // save old value
    double oldValue = fScannedVariable->getVal();
@@ -706,11 +727,52 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
    fScannedVariable->getVal() << endl;
       return false;
    }
+   AddPointResult(rVal, result);
+
+      // std::cout << "computed value for poi  " << rVal  << " : " << fResults->GetYValue(fResults->ArraySize()-1)
+      //        << " +/- " << fResults->GetYError(fResults->ArraySize()-1) << endl;
+
+   fScannedVariable->setVal(oldValue);
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the given POI value, or the closest bound of the scanned variable
+/// if the value is out of its range
+
+double HypoTestInverter::GetValueInRange( double rVal) const
+{
+   if ( rVal < fScannedVariable->getMin() ) {
+      oocoutE((TObject*)0,InputArguments) << "HypoTestInverter::RunOnePoint - Out of range: using the lower bound "
+                                          << fScannedVariable->getMin()
+                                          << " on the scanned variable rather than " << rVal<< "\n";
+     rVal = fScannedVariable->getMin();
+   }
+   if ( rVal > fScannedVariable->getMax() ) {
+      // print a message when you have a significative difference since rval is computed
+      if ( rVal > fScannedVariable->getMax()*(1.+1.E-12) )
+         oocoutE((TObject*)0,InputArguments) << "HypoTestInverter::RunOnePoint - Out of range: using the upper bound "
+                                             << fScannedVariable->getMax()
+                                             << " on the scanned variable rather than " << rVal<< "\n";
+     rVal = fScannedVariable->getMax();
+   }
+   return rVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the result of the hypothesis test at the POI value rVal to the
+/// HypoTestInverterResult, merging it with the last point if it has the same
+/// POI value. The ownership of the result is taken.
+
+void HypoTestInverter::AddPointResult( double rVal, HypoTestResult * result) const
+{
    // in case of a dummy result
    if (TMath::IsNaN(result->NullPValue() ) && TMath::IsNaN(result->AlternatePValue() ) ) {
       oocoutW((TObject*)0,Eval) << "HypoTestInverter - Skip invalid result for  point " << fScannedVariable->GetName() << " = " <<
-         fScannedVariable->getVal() << endl;
-      return true;  // need to return true to avoid breaking the scan loop
+         rVal << endl;
+      delete result;
+      return;
    }
 
    double lastXtested;
@@ -741,13 +803,139 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
      fResults->fYObjects.Add(result);
 
    }
+}
 
-      // std::cout << "computed value for poi  " << rVal  << " : " << fResults->GetYValue(fResults->ArraySize()-1)
-      //        << " +/- " << fResults->GetYError(fResults->ArraySize()-1) << endl;
+////////////////////////////////////////////////////////////////////////////////
+/// Run the hypothesis tests at the given POI values in fNWorkers local worker
+/// processes and add the results in the order of the given values.
+///
+/// The points are split in tasks of fPointsPerTask neighbouring points, which
+/// are run one after the other in the worker. The random generator is seeded
+/// for each point from a sequence initialised from the generator of this
+/// process, such that the results of toy-based calculators do not depend on
+/// the number of workers.
+///
+/// As in the sequential scan, the values out of the range of the scanned
+/// variable are moved to the closest bound, invalid results are skipped and
+/// the scan stops at the first point that fails: the results of the points
+/// before it are kept and false is returned.
+
+bool HypoTestInverter::RunPointsParallel( const std::vector<double> & pointsIn) const
+{
+#ifdef R__WIN32
+   oocoutW((TObject*)0,InputArguments) << "HypoTestInverter::RunPointsParallel - multi-process running is not supported "
+                                       << "on this platform, run the points sequentially" << std::endl;
+   for (auto x : pointsIn) {
+      if (!RunOnePoint(x)) {
+         std::cout << "\t\tLoop interrupted because of failed status\n";
+         return false;
+      }
+   }
+   return true;
+#else
+   CreateResults();
 
-   fScannedVariable->setVal(oldValue);
+   std::vector<double> points(pointsIn.size());
+   for (unsigned int i = 0; i < points.size(); ++i)
+      points[i] = GetValueInRange(pointsIn[i]);
 
-   return true;
+   const unsigned int nPoints = points.size();
+   const unsigned int pointsPerTask = fPointsPerTask > 0 ? fPointsPerTask : 1;
+   const unsigned int nTasks = (nPoints + pointsPerTask - 1) / pointsPerTask;
+
+   // the asimov data of the asymptotic calculator are made once for all workers
+   AsymptoticCalculator * ac = dynamic_cast<AsymptoticCalculator*>(fCalculator0);
+   if (ac && !ac->Initialize()) {
+      oocoutE((TObject*)0,Eval) << "HypoTestInverter::RunPointsParallel - Error initializing the asymptotic calculator" << std::endl;
+      return false;
+   }
+
+   const std::vector<UInt_t> seeds = RooHelpers::seedSequence(nPoints);
+
+   oocoutP((TObject*)0,Eval) << "HypoTestInverter::RunPointsParallel - running " << nPoints << " points in "
+                             << nTasks << " tasks on " << fNWorkers << " worker processes" << std::endl;
+
+   const ModelConfig * sbModel = fCalculator0->GetNullModel();
+
+   // run in the forked worker processes: the results of the points are returned
+   // in a list named after the task index. A failed point ends the task and is
+   // returned as an empty object.
+   auto task = [&](unsigned int iTask) -> TList * {
+      TList * output = new TList();
+      output->SetName(TString::Format("%u", iTask));
+      output->SetOwner();
+      const unsigned int first = iTask * pointsPerTask;
+      const unsigned int last = std::min(first + pointsPerTask, nPoints);
+      const double oldValue = fScannedVariable->getVal();
+      for (unsigned int i = first; i < last; ++i) {
+         RooRandom::randomGenerator()->SetSeed(seeds[i]);
+         fScannedVariable->setVal(points[i]);
+         RooArgSet poi(*fScannedVariable);
+         const_cast<ModelConfig*>(sbModel)->SetSnapshot(poi);
+
+         if (fVerbose > 0)
+            oocoutP((TObject*)0,Eval) << "Running for " << fScannedVariable->GetName() << " = " << points[i] << endl;
+
+         HypoTestResult * result = Eval(*fCalculator0, false, -1);
+         if (!result) {
+            output->Add(new TNamed("failed", "failed"));
+            break;
+         }
+         output->Add(result);
+         fScannedVariable->setVal(oldValue);
+      }
+      return output;
+   };
+
+   ROOT::TProcessExecutor workers(fNWorkers);
+   std::vector<TList*> results = workers.Map(task, ROOT::TSeqU(nTasks));
+
+   // the results arrive in the order in which the tasks have finished
+   const std::vector<TList*> ordered = RooHelpers::orderTaskResults(results, nTasks);
+
+   // add the results in the order of the points, up to the first failed point
+   bool ok = true;
+   for (unsigned int iTask = 0; iTask < nTasks; ++iTask) {
+      TList * output = ordered[iTask];
+      if (!ok) {
+         delete output;
+         continue;
+      }
+      const unsigned int first = iTask * pointsPerTask;
+      const unsigned int nTaskPoints = std::min(first + pointsPerTask, nPoints) - first;
+      if (!output) {
+         oocoutE((TObject*)0,Eval) << "HypoTestInverter::RunPointsParallel - no result from task " << iTask << std::endl;
+         ok = false;
+         continue;
+      }
+      // the results are handed over to fResults, the others are deleted
+      output->SetOwner(false);
+      for (unsigned int i = 0; i < (unsigned int) output->GetSize(); ++i) {
+         HypoTestResult * result = dynamic_cast<HypoTestResult*>(output->At(i));
+         if (!ok || !result) {
+            if (ok)
+               oocoutE((TObject*)0,Eval) << "HypoTestInverter - Error running point " << fScannedVariable->GetName() << " = "
+                                         << points[first+i] << endl;
+            delete output->At(i);
+            ok = false;
+            continue;
+         }
+         if (fCalcType == kFrequentist || fCalcType == kHybrid)
+            fTotalToysRun += (result->GetAltDistribution()->GetSize() + result->GetNullDistribution()->GetSize());
+         AddPointResult(points[first+i], result);
+      }
+      if (ok && (unsigned int) output->GetSize() != nTaskPoints) {
+         oocoutE((TObject*)0,Eval) << "HypoTestInverter::RunPointsParallel - no result from task " << iTask << std::endl;
+         ok = false;
+      }
+      delete output;
+   }
+
+   if (!ok)
+      std::cout << "\t\tLoop interrupted because of failed status\n";
+
+   return ok;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
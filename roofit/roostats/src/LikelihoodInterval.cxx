@@ -59,6 +59,11 @@
 #include "RooProfileLL.h"
 
 #include "TMinuitMinimizer.h"
+#include "TVectorD.h"
+
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
 
 #include <string>
 #include <algorithm>
@@ -373,6 +378,90 @@ bool LikelihoodInterval::FindLimits(const RooRealVar & param, double &lower, dou
 }
 
 
+bool LikelihoodInterval::FindLimits(const RooArgList & params, unsigned int nWorkers)
+{
+   // Method to find the lower and upper limits of several parameters using MINOS.
+   // The global minimum is found once, then MINOS is run for each parameter
+   // starting from it. With nWorkers > 1 the parameters are shared among local
+   // worker processes, each working on a copy of the likelihood function.
+   // Limits already computed are not recomputed.
+
+   std::vector<const RooRealVar*> todo;
+   for (int i = 0; i < params.getSize(); ++i) {
+      const RooRealVar * param = dynamic_cast<const RooRealVar*>(params.at(i));
+      if (!param) {
+         ccoutE(InputArguments) << "Error - parameter " << params.at(i)->GetName() << " is not a RooRealVar " << std::endl;
+         return false;
+      }
+      if (fLowerLimits.find(param->GetName()) == fLowerLimits.end() ||
+          fUpperLimits.find(param->GetName()) == fUpperLimits.end())
+         todo.push_back(param);
+   }
+   if (todo.empty()) return true;
+
+   bool ret = true;
+   if (!fMinimizer.get()) ret = CreateMinimizer();
+   if (!ret) {
+      ccoutE(Eval) << "Error returned from minimization of likelihood function - cannot find interval limits " << std::endl;
+      return false;
+   }
+
+#ifdef R__WIN32
+   if (nWorkers > 1) {
+      ccoutW(InputArguments) << "LikelihoodInterval::FindLimits - multi-process running is not supported on this platform" << std::endl;
+      nWorkers = 1;
+   }
+#endif
+
+   double lower = 0;
+   double upper = 0;
+   if (nWorkers <= 1 || todo.size() == 1) {
+      for (auto param : todo) {
+         if (!FindLimits(*param, lower, upper)) ret = false;
+      }
+      return ret;
+   }
+
+#ifndef R__WIN32
+   // run in the forked worker processes, the result is (index, status, lower, upper)
+   auto task = [&](unsigned int i) -> TVectorD * {
+      TVectorD * result = new TVectorD(4);
+      (*result)[0] = i;
+      (*result)[1] = FindLimits(*todo[i], lower, upper);
+      (*result)[2] = lower;
+      (*result)[3] = upper;
+      return result;
+   };
+
+   std::vector<unsigned int> indices(todo.size());
+   for (unsigned int i = 0; i < indices.size(); ++i) indices[i] = i;
+
+   ROOT::TProcessExecutor workers(std::min<unsigned int>(nWorkers, todo.size()));
+   std::vector<TVectorD*> results = workers.Map(task, indices);
+
+   std::vector<bool> found(todo.size(), false);
+   for (auto result : results) {
+      if (!result) continue;
+      unsigned int i = (*result)[0];
+      if (i < todo.size() && (*result)[1] != 0) {
+         fLowerLimits[todo[i]->GetName()] = (*result)[2];
+         fUpperLimits[todo[i]->GetName()] = (*result)[3];
+         found[i] = true;
+      }
+      delete result;
+   }
+   for (unsigned int i = 0; i < todo.size(); ++i) {
+      if (!found[i]) {
+         ccoutE(Minimization) << "Error  running Minos for parameter " << todo[i]->GetName() << std::endl;
+         ret = false;
+      }
+   }
+#endif
+
+   return ret;
+}
+
+
 Int_t LikelihoodInterval::GetContourPoints(const RooRealVar & paramX, const RooRealVar & paramY, Double_t * x, Double_t *y, Int_t npoints ) {
    // use Minuit to find the contour of the likelihood function at the desired CL
 
@@ -28,6 +28,14 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Without PROOF, the toys can be distributed over local worker processes
+with SetNumWorkers(). Each toy is generated with its own seed, drawn from a
+sequence that is initialised from RooRandom::randomGenerator(). The toys
+are sent to the workers in blocks of GetToysPerTask() toys, and the results
+are merged in the order of the blocks. The outcome therefore depends neither
+on the number of workers nor on the block size, and it is the same as that
+of a run in this process with SetSeedPerToy(kTRUE).
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -41,6 +49,7 @@ ToyMCStudy with the RooStudyManager.
 #include "TCanvas.h"
 #include "RooPlot.h"
 #include "RooRandom.h"
+#include "RooHelpers.h"
 
 #include "RooStudyManager.h"
 #include "RooStats/ToyMCStudy.h"
@@ -51,6 +60,13 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+
 
 using namespace RooFit;
 using namespace std;
@@ -176,6 +192,10 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
+   fToysPerTask = 100;
+   fSeedPerToy = kFALSE;
+   fNextToySeed = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -216,6 +236,10 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
+   fToysPerTask = 100;
+   fSeedPerToy = kFALSE;
+   fNextToySeed = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -328,8 +352,18 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
-      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   if(!fProofConfig) {
+      if (fNWorkers > 1)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
+      if (!fSeedPerToy)
+         return GetSamplingDistributionsSingleWorker(paramPointIn);
+
+      fToySeeds = RooHelpers::seedSequence(fNToys);
+      fNextToySeed = 0;
+      RooDataSet* r = GetSamplingDistributionsSingleWorker(paramPointIn);
+      fToySeeds.clear();
+      return r;
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -371,6 +405,119 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the toys in GetNumWorkers() local processes. This is called from
+/// GetSamplingDistributions() when more than one worker is requested and no
+/// ProofConfig is given.
+///
+/// Each toy is generated with its own seed, taken from RooHelpers::seedSequence(). The
+/// toys are split into tasks of GetToysPerTask() toys, which run
+/// GetSamplingDistributionsSingleWorker() in one of the workers, and the
+/// results of the tasks are merged in task order.
+///
+/// Expected (Asimov) nuisance parameters are cycled over all the toys, so
+/// they cannot be split into tasks; these toys run in this process.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef R__WIN32
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: multi-process toys are not supported on this platform, running in a single process."
+      << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   if (fExpectedNuisancePar && fPriorNuisance && fNuisancePars) {
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Expected nuisance parameters are not supported by the local worker processes, running in a single process."
+         << endl;
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
+
+   const Int_t totToys = fNToys;
+   const Int_t toysPerTask = fToysPerTask > 0 ? fToysPerTask : totToys;
+   const UInt_t nTasks = totToys > 0 ? (totToys + toysPerTask - 1) / toysPerTask : 0;
+   if (nTasks == 0)
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+
+   const std::vector<UInt_t> seeds = RooHelpers::seedSequence(totToys);
+
+   oocoutP((TObject*)NULL, Generation) << "ToyMCSampler: running " << totToys << " toys in " << nTasks
+                                       << " tasks on " << fNWorkers << " worker processes" << endl;
+
+   // runs in the forked worker processes
+   auto task = [&](UInt_t iTask) -> RooDataSet* {
+      const Int_t first = Int_t(iTask) * toysPerTask;
+      fNToys = std::min(toysPerTask, totToys - first);
+      fToySeeds.assign(seeds.begin() + first, seeds.begin() + first + fNToys);
+      fNextToySeed = 0;
+      RooDataSet* r = GetSamplingDistributionsSingleWorker(paramPointIn);
+      if (!r) r = new RooDataSet(fSamplingDistName.c_str(), fSamplingDistName.c_str(), RooArgSet());
+      r->SetName(TString::Format("%u", iTask));
+      return r;
+   };
+
+   ROOT::TProcessExecutor workers(fNWorkers);
+   std::vector<RooDataSet*> results = workers.Map(task, ROOT::TSeqU(nTasks));
+
+   // the results arrive in the order in which the tasks finished
+   const std::vector<RooDataSet*> ordered = RooHelpers::orderTaskResults(results, nTasks);
+
+   RooDataSet* output = nullptr;
+   for (UInt_t iTask = 0; iTask < nTasks; ++iTask) {
+      if (!ordered[iTask]) {
+         oocoutW((TObject*)NULL, Generation) << "ToyMCSampler: no result from toy task " << iTask << endl;
+         continue;
+      }
+      if (!output && ordered[iTask]->numEntries() > 0) {
+         output = ordered[iTask];
+         continue;
+      }
+      if (output && ordered[iTask]->numEntries() > 0) output->append(*ordered[iTask]);
+      delete ordered[iTask];
+   }
+   if (output) {
+      output->SetName(fSamplingDistName.c_str());
+      output->SetTitle(fSamplingDistName.c_str());
+   }
+
+   return output;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Seed RooRandom::randomGenerator() with the seed of the next toy, if the
+/// toys of this run are seeded. The generator caches and the randomised
+/// nuisance parameter points are dropped as well, as they hold numbers
+/// drawn for the previous toys.
+
+void ToyMCSampler::SeedNextToy()
+{
+   if (fNextToySeed >= fToySeeds.size()) return;
+
+   RooRandom::randomGenerator()->SetSeed(fToySeeds[fNextToySeed++]);
+
+   ToyMCSampler::ClearCache();
+   if (fNuisanceParametersSampler && !fExpectedNuisancePar) {
+      delete fNuisanceParametersSampler;
+      fNuisanceParametersSampler = NULL;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -426,6 +573,7 @@ RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramP
       // set variables to requested parameter point
       *allVars = *saveAll; // important for example for SimpleLikelihoodRatioTestStat
 
+      SeedNextToy();
       RooAbsData* toydata = GenerateToyData(*paramPoint, weight);
 
       *allVars = *fParametersForTestStat;
@@ -550,7 +698,9 @@ RooAbsData* ToyMCSampler::GenerateToyData(RooArgSet& paramPoint, double& weight,
 
    // create nuisance parameter points
    if(!fNuisanceParametersSampler && fPriorNuisance && fNuisancePars) {
-      fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, fNToys, fExpectedNuisancePar);
+      // a seeded toy draws its own nuisance parameter point
+      const Int_t nPoints = (fToySeeds.empty() || fExpectedNuisancePar) ? fNToys : 1;
+      fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, nPoints, fExpectedNuisancePar);
       if ((fUseMultiGen || fgAlwaysUseMultiGen) &&  fNuisanceParametersSampler )
          oocoutI((TObject*)NULL,InputArguments) << "Cannot use multigen when nuisance parameters vary for every toy" << endl;
    }
@@ -0,0 +1,119 @@
+// Tests for the HypoTestInverter and the LikelihoodInterval run in worker processes
+
+#include "RooDataSet.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+#include "RooWorkspace.h"
+#include "RooStats/AsymptoticCalculator.h"
+#include "RooStats/HypoTestInverter.h"
+#include "RooStats/HypoTestInverterResult.h"
+#include "RooStats/LikelihoodInterval.h"
+#include "RooStats/ModelConfig.h"
+#include "RooStats/ProfileLikelihoodCalculator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace RooStats;
+
+namespace {
+
+/// A gaussian measurement of mu with an unknown width, and a dataset of 50 events
+std::unique_ptr<RooWorkspace> MakeGaussModel()
+{
+  std::unique_ptr<RooWorkspace> w(new RooWorkspace("w"));
+  w->factory("Gaussian::pdf(x[-10,10], mu[1,0,5], sigma[1.5,0.1,5])");
+
+  RooRandom::randomGenerator()->SetSeed(1234);
+  RooDataSet* data = w->pdf("pdf")->generate(*w->var("x"), 50);
+  data->SetName("data");
+  w->import(*data);
+  delete data;
+
+  ModelConfig sbModel("sbModel", w.get());
+  sbModel.SetPdf("pdf");
+  sbModel.SetObservables("x");
+  sbModel.SetParametersOfInterest("mu");
+  sbModel.SetNuisanceParameters("sigma");
+  w->var("mu")->setVal(1.);
+  sbModel.SetSnapshot(*w->var("mu"));
+  w->import(sbModel);
+
+  ModelConfig bModel("bModel", w.get());
+  bModel.SetPdf("pdf");
+  bModel.SetObservables("x");
+  bModel.SetParametersOfInterest("mu");
+  bModel.SetNuisanceParameters("sigma");
+  w->var("mu")->setVal(0.);
+  bModel.SetSnapshot(*w->var("mu"));
+  w->import(bModel);
+
+  w->var("mu")->setVal(1.);
+  return w;
+}
+
+std::unique_ptr<HypoTestInverterResult> RunScan(RooWorkspace& w, int nWorkers)
+{
+  ModelConfig* sbModel = static_cast<ModelConfig*>(w.obj("sbModel"));
+  ModelConfig* bModel = static_cast<ModelConfig*>(w.obj("bModel"));
+  AsymptoticCalculator ac(*w.data("data"), *bModel, *sbModel);
+  ac.SetOneSided(true);
+
+  HypoTestInverter inverter(ac, w.var("mu"));
+  inverter.SetConfidenceLevel(0.95);
+  inverter.UseCLs(true);
+  inverter.SetFixedScan(7, 0., 3.);
+  inverter.SetNumWorkers(nWorkers);
+  inverter.SetPointsPerTask(2);
+  return std::unique_ptr<HypoTestInverterResult>(inverter.GetInterval());
+}
+
+}
+
+/// A fixed scan run in two worker processes must give the same points and
+/// limits as the sequential scan.
+TEST(HypoTestInverter, ParallelScanMatchesSequential)
+{
+  std::unique_ptr<RooWorkspace> w = MakeGaussModel();
+
+  std::unique_ptr<HypoTestInverterResult> sequential = RunScan(*w, 1);
+  std::unique_ptr<HypoTestInverterResult> parallel = RunScan(*w, 2);
+  ASSERT_NE(sequential, nullptr);
+  ASSERT_NE(parallel, nullptr);
+
+  ASSERT_EQ(sequential->ArraySize(), 7);
+  ASSERT_EQ(parallel->ArraySize(), sequential->ArraySize());
+  for (int i = 0; i < sequential->ArraySize(); ++i) {
+    EXPECT_DOUBLE_EQ(parallel->GetXValue(i), sequential->GetXValue(i)) << "point " << i;
+    EXPECT_NEAR(parallel->CLs(i), sequential->CLs(i), 1.E-6) << "point " << i;
+  }
+  EXPECT_NEAR(parallel->UpperLimit(), sequential->UpperLimit(), 1.E-6);
+}
+
+/// The MINOS limits of several parameters found in two worker processes must
+/// be the same as those found one after the other.
+TEST(LikelihoodInterval, ParallelLimitsMatchSequential)
+{
+  std::unique_ptr<RooWorkspace> w = MakeGaussModel();
+  RooRealVar& mu = *w->var("mu");
+  RooRealVar& sigma = *w->var("sigma");
+  const RooArgSet params(mu, sigma);
+
+  ProfileLikelihoodCalculator sequentialCalc(*w->data("data"), *w->pdf("pdf"), params, 0.32);
+  std::unique_ptr<LikelihoodInterval> sequential(sequentialCalc.GetInterval());
+  double muLow, muUp, sigmaLow, sigmaUp;
+  ASSERT_TRUE(sequential->FindLimits(mu, muLow, muUp));
+  ASSERT_TRUE(sequential->FindLimits(sigma, sigmaLow, sigmaUp));
+
+  ProfileLikelihoodCalculator parallelCalc(*w->data("data"), *w->pdf("pdf"), params, 0.32);
+  std::unique_ptr<LikelihoodInterval> parallel(parallelCalc.GetInterval());
+  ASSERT_TRUE(parallel->FindLimits(RooArgList(mu, sigma), 2));
+
+  EXPECT_LT(muLow, muUp);
+  EXPECT_LT(sigmaLow, sigmaUp);
+  EXPECT_NEAR(parallel->LowerLimit(mu), muLow, 1.E-6);
+  EXPECT_NEAR(parallel->UpperLimit(mu), muUp, 1.E-6);
+  EXPECT_NEAR(parallel->LowerLimit(sigma), sigmaLow, 1.E-6);
+  EXPECT_NEAR(parallel->UpperLimit(sigma), sigmaUp, 1.E-6);
+}
@@ -0,0 +1,74 @@
+// Tests for the ToyMCSampler
+
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+#include "RooStats/ProfileLikelihoodTestStat.h"
+#include "RooStats/ToyMCSampler.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+/// Toys generated and evaluated in two worker processes must be the same as
+/// the ones of a run in this process that seeds every toy in the same way,
+/// also when the nuisance parameters are randomised.
+TEST(ToyMCSampler, ParallelMatchesSequential)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar mean("mean", "mean", 1., -5., 5.);
+  RooRealVar sigma("sigma", "sigma", 2., 0.5, 5.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  RooRealVar sigma0("sigma0", "sigma0", 2.);
+  RooRealVar sigmaErr("sigmaErr", "sigmaErr", 0.2);
+  RooGaussian prior("prior", "prior", sigma, sigma0, sigmaErr);
+
+  const RooArgSet observables(x);
+  const RooArgSet poi(mean);
+  const RooArgSet nuisance(sigma);
+
+  RooStats::ProfileLikelihoodTestStat testStat(gauss);
+
+  const Int_t nToys = 7;
+
+  auto makeSampler = [&]() {
+    std::unique_ptr<RooStats::ToyMCSampler> sampler(new RooStats::ToyMCSampler(testStat, nToys));
+    sampler->SetPdf(gauss);
+    sampler->SetObservables(observables);
+    sampler->SetParametersForTestStat(poi);
+    sampler->SetNuisanceParameters(nuisance);
+    sampler->SetPriorNuisance(&prior);
+    sampler->SetNEventsPerToy(50);
+    return sampler;
+  };
+
+  RooArgSet point(mean, sigma);
+
+  auto parallel = makeSampler();
+  parallel->SetNumWorkers(2);
+  parallel->SetToysPerTask(3);
+  RooRandom::randomGenerator()->SetSeed(4321);
+  std::unique_ptr<RooDataSet> parallelData(parallel->GetSamplingDistributions(point));
+
+  auto sequential = makeSampler();
+  sequential->SetSeedPerToy(kTRUE);
+  RooRandom::randomGenerator()->SetSeed(4321);
+  std::unique_ptr<RooDataSet> sequentialData(sequential->GetSamplingDistributions(point));
+
+  ASSERT_NE(parallelData, nullptr);
+  ASSERT_NE(sequentialData, nullptr);
+  ASSERT_EQ(parallelData->numEntries(), nToys);
+  ASSERT_EQ(sequentialData->numEntries(), nToys);
+
+  const TString name = testStat.GetVarName();
+  for (Int_t i = 0; i < nToys; ++i) {
+    const Double_t parallelValue = parallelData->get(i)->getRealValue(name.Data());
+    EXPECT_DOUBLE_EQ(parallelValue, sequentialData->get(i)->getRealValue(name.Data())) << "toy " << i;
+  }
+
+  // The toys differ from each other
+  const Double_t firstValue = parallelData->get(0)->getRealValue(name.Data());
+  EXPECT_NE(firstValue, parallelData->get(1)->getRealValue(name.Data()));
+}
@@ -0,0 +1,70 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketBufferPool
+#define ROOT_TBasketBufferPool
+
+#include "TBuffer.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// A pool recycling the TBuffer objects (and their memory) used by the TBasket
+/// of a TTree, so that rotating baskets do not go back to the memory allocator
+/// for every basket read or written.
+///
+/// The free buffers are sorted in size classes (powers of two, starting at
+/// 512 bytes) and the total amount of memory kept in the pool is bounded.
+/// All the operations are thread-safe.
+class TBasketBufferPool {
+public:
+   /// Usage statistics of the pool.
+   struct Stats {
+      ULong64_t fAcquired = 0;    ///< Number of buffers requested from the pool.
+      ULong64_t fReused = 0;      ///< Number of requests served by a recycled buffer.
+      ULong64_t fReleased = 0;    ///< Number of buffers given back to the pool.
+      ULong64_t fDiscarded = 0;   ///< Number of buffers deleted because the pool was full or they could not be reused.
+      Long64_t  fPooledBytes = 0; ///< Memory currently held by the free buffers.
+      Long64_t  fPeakBytes = 0;   ///< Largest value of fPooledBytes so far.
+   };
+
+private:
+   static constexpr Int_t kMinClassSize = 512;
+   static constexpr Int_t kNClasses = 22; // The largest class holds buffers of 1 GB and more.
+
+   mutable std::mutex    fMutex;                 ///< Protects all the members below.
+   std::vector<TBuffer*> fFreeBuffers[kNClasses]; ///< Free buffers, by size class.
+   Long64_t              fMaxBytes;              ///< Maximum memory held by the free buffers.
+   Stats                 fStats;                 ///< Usage statistics.
+
+   static Int_t GetClass(Int_t size);
+
+public:
+   explicit TBasketBufferPool(Long64_t maxBytes);
+   ~TBasketBufferPool();
+   TBasketBufferPool(const TBasketBufferPool &) = delete;
+   TBasketBufferPool &operator=(const TBasketBufferPool &) = delete;
+
+   TBuffer *Acquire(TBuffer::EMode mode, Int_t size);
+   void     Release(TBuffer *buffer);
+   void     Clear();
+
+   Long64_t GetMaxBytes() const { return fMaxBytes; }
+   Stats    GetStats() const;
+   void     SetMaxBytes(Long64_t maxBytes);
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -27,10 +27,18 @@
 
 #include "TKey.h"
 
+#include <memory>
+
 class TFile;
 class TTree;
 class TBranch;
 
+namespace ROOT {
+namespace Internal {
+class TBasketBufferPool;
+}
+}
+
 class TBasket : public TKey {
 
 private:
@@ -44,6 +52,10 @@ private:
    // Helper for managing the compressed buffer.
    void InitializeCompressedBuffer(Int_t len, TFile* file);
 
+   // Helpers getting and giving back buffers, through the TTree's pool if any.
+   TBuffer *AcquireBuffer(TBuffer::EMode mode, Int_t size);
+   void     ReleaseBuffer(TBuffer *buffer);
+
    // Handles special logic around deleting / reseting the entry offset pointer.
    void ResetEntryOffset();
 
@@ -73,6 +85,7 @@ protected:
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
+   std::shared_ptr<ROOT::Internal::TBasketBufferPool> fBufferPool; ///<! Pool recycling the buffers (see TTree::SetBasketBufferPoolSize)
 
 public:
    // The IO bits flag is to provide improved forward-compatibility detection.
@@ -153,6 +153,7 @@ public:
    }
 #endif
 
+   virtual void      SetBasketBufferPoolSize(Long64_t maxBytes = 64000000) { TTree::SetBasketBufferPoolSize(maxBytes); if (fTree) fTree->SetBasketBufferPool(fBasketBufferPool); }
    virtual void      SetBranchStatus(const char *bname, Bool_t status=1, UInt_t *found=0);
    virtual Int_t     SetCacheSize(Long64_t cacheSize = -1);
    virtual void      SetDirectory(TDirectory *dir);
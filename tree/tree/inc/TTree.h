@@ -27,6 +27,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "Compression.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TArrayD.h"
 #include "TArrayI.h"
@@ -42,6 +43,7 @@
 #include "TVirtualTreePlayer.h"
 
 #include <atomic>
+#include <memory>
 
 
 class TBranch;
@@ -138,6 +140,9 @@ protected:
    mutable std::atomic<ULong64_t> fAllocationTime{0}; ///<! Time spent reallocating basket memory buffers, in microseconds.
 #endif
    mutable std::atomic<UInt_t> fAllocationCount{0};   ///<! Number of reallocations basket memory buffers.
+   std::shared_ptr<ROOT::Internal::TBasketBufferPool> fBasketBufferPool; ///<! Pool recycling the basket buffers (see SetBasketBufferPoolSize)
+   Long64_t fTuneClusterBytes{0};         ///<! Target compressed size of a cluster for the online tuning of the baskets (0: disabled)
+   Long64_t fTuneMaxMemory{0};            ///<! Maximum memory for the baskets being filled when tuning online (0: no limit)
 
    static Int_t     fgBranchStyle;        ///<  Old/New branch style
    static Long64_t  fgMaxTreeSize;        ///<  Maximum size of a file containing a Tree
@@ -152,6 +157,13 @@ private:
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
    void             MarkEventCluster();
+   void             TuneBaskets(Long64_t clusterZipBytes);
+
+   // The basket buffer pool is handed to the baskets and to the trees of a TChain
+   std::shared_ptr<ROOT::Internal::TBasketBufferPool> GetBasketBufferPool() const { return fBasketBufferPool; }
+   void             SetBasketBufferPool(std::shared_ptr<ROOT::Internal::TBasketBufferPool> pool) { fBasketBufferPool = pool; }
+   friend class TBasket;
+   friend class TChain;
 
 protected:
    virtual void     KeepCircular();
@@ -243,6 +255,9 @@ public:
       kSplitCollectionOfPointers = 100
    };
 
+   // Usage statistics of the basket buffer pool (see SetBasketBufferPoolSize)
+   using TBasketBufferPoolStats = ROOT::Internal::TBasketBufferPool::Stats;
+
    class TClusterIterator
    {
    private:
@@ -385,6 +400,8 @@ public:
 #endif
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
+           Long64_t        GetBasketBufferPoolSize() const;
+           TBasketBufferPoolStats GetBasketBufferPoolStats() const;
    virtual TBranch        *GetBranch(const char* name);
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
@@ -517,6 +534,8 @@ public:
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
+   virtual void            SetAutoTuning(Long64_t clusterBytes = 32000000, Long64_t maxMemory = 0);
+   virtual void            SetBasketBufferPoolSize(Long64_t maxBytes = 64000000);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TClass *realClass, EDataType datatype, Bool_t isptr);
@@ -24,6 +24,7 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "RZip.h"
 
@@ -67,7 +68,9 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    SetTitle(title);
    fClassName   = "TBasket";
    fBuffer = nullptr;
-   fBufferRef   = new TBufferFile(TBuffer::kWrite, fBufferSize);
+   if (branch->GetTree())
+      fBufferPool = branch->GetTree()->GetBasketBufferPool();
+   fBufferRef   = AcquireBuffer(TBuffer::kWrite, fBufferSize);
    fVersion    += 1000;
    if (branch->GetDirectory()) {
       TFile *file = branch->GetFile();
@@ -81,7 +84,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
 #endif
       fOwnsCompressedBuffer = kFALSE;
       if (!fCompressedBufferRef) {
-         fCompressedBufferRef = new TBufferFile(TBuffer::kRead, fBufferSize);
+         fCompressedBufferRef = AcquireBuffer(TBuffer::kRead, fBufferSize);
          fOwnsCompressedBuffer = kTRUE;
       }
    }
@@ -106,17 +109,41 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef) delete fBufferRef;
+   ReleaseBuffer(fBufferRef);
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
    // Note we only delete the compressed buffer if we own it
    if (fCompressedBufferRef && fOwnsCompressedBuffer) {
-      delete fCompressedBufferRef;
+      ReleaseBuffer(fCompressedBufferRef);
       fCompressedBufferRef = 0;
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new buffer able to hold size bytes, recycled from the TTree's pool
+/// of basket buffers if there is one.
+
+TBuffer *TBasket::AcquireBuffer(TBuffer::EMode mode, Int_t size)
+{
+   if (fBufferPool)
+      return fBufferPool->Acquire(mode, size);
+   return new TBufferFile(mode, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back (or delete) a buffer that this basket owns.
+
+void TBasket::ReleaseBuffer(TBuffer *buffer)
+{
+   if (!buffer)
+      return;
+   if (fBufferPool)
+      fBufferPool->Release(buffer);
+   else
+      delete buffer;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increase the size of the current fBuffer up to newsize.
 
@@ -172,8 +199,8 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef)    delete fBufferRef;
-   if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
+   ReleaseBuffer(fBufferRef);
+   if (fCompressedBufferRef && fOwnsCompressedBuffer) ReleaseBuffer(fCompressedBufferRef);
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
@@ -403,7 +430,8 @@ Int_t TBasket::ReadBasketBuffersUnzip(char* buffer, Int_t size, Bool_t mustFree,
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize a buffer for reading if it is not already initialized
 
-static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t len, TFile* file)
+static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t len, TFile* file,
+                                                     ROOT::Internal::TBasketBufferPool *pool)
 {
    TBuffer* result;
    if (R__likely(bufferRef)) {
@@ -415,6 +443,8 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       }
       bufferRef->Reset();
       result = bufferRef;
+   } else if (pool) {
+      result = pool->Acquire(TBuffer::kRead, len);
    } else {
       result = new TBufferFile(TBuffer::kRead, len);
    }
@@ -428,7 +458,7 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
 void inline TBasket::InitializeCompressedBuffer(Int_t len, TFile* file)
 {
    Bool_t compressedBufferExists = fCompressedBufferRef != NULL;
-   fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file);
+   fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file, fBufferPool.get());
    if (R__unlikely(!compressedBufferExists)) {
       fOwnsCompressedBuffer = kTRUE;
    }
@@ -462,6 +492,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    if(!fBranch->GetDirectory()) {
       return -1;
    }
+   if (!fBufferPool) {
+      fBufferPool = fBranch->GetTree()->GetBasketBufferPool();
+   }
 
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
@@ -501,7 +534,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
 
    // Initialize the buffer to hold the compressed data.
-   readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file);
+   readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file, fBufferPool.get());
    if (!readBufferRef) {
       Error("ReadBasketBuffers", "Unable to allocate buffer.");
       return 1;
@@ -576,7 +609,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
    // to the TBranch.
    uncompressedBufferLen = len > fObjlen+fKeylen ? len : fObjlen+fKeylen;
-   fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, uncompressedBufferLen, file);
+   fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, uncompressedBufferLen, file, fBufferPool.get());
    rawUncompressedBuffer = fBufferRef->Buffer();
    fBuffer = rawUncompressedBuffer;
 
@@ -0,0 +1,172 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketBufferPool.hxx"
+#include "TBufferFile.h"
+
+#include <iterator>
+#include <typeinfo>
+
+/**
+ * \class ROOT::Internal::TBasketBufferPool
+ * \ingroup tree
+ *
+ * Recycle the buffers of the baskets of a TTree (see TTree::SetBasketBufferPoolSize).
+ *
+ * Baskets are routinely created and deleted while reading (for example when
+ * the TTreeCache prefetches whole clusters or when TTree::SetMaxVirtualSize
+ * forces the baskets to be dropped) and each of them allocates and frees
+ * buffers of similar sizes.  Under implicit multi-threading this hammers the
+ * memory allocator from many threads at once and fragments the heap.  The pool
+ * keeps the released buffers, sorted by size class, and hands them back out to
+ * the next basket needing a buffer of (at most) that size.
+ */
+
+using namespace ROOT::Internal;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a pool keeping at most maxBytes of free buffers.
+
+TBasketBufferPool::TBasketBufferPool(Long64_t maxBytes) : fMaxBytes(maxBytes > 0 ? maxBytes : 0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete all the free buffers.
+
+TBasketBufferPool::~TBasketBufferPool()
+{
+   Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size class of a buffer of the given size, i.e. the largest `c`
+/// such that `512 << c` is not larger than size.
+
+Int_t TBasketBufferPool::GetClass(Int_t size)
+{
+   Int_t cls = 0;
+   Long64_t classSize = kMinClassSize;
+   while (2 * classSize <= size && cls < kNClasses - 1) {
+      classSize <<= 1;
+      ++cls;
+   }
+   return cls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer, in the requested mode, able to hold at least size bytes.
+///
+/// The buffer is taken from the pool if one of the right size class is
+/// available, otherwise a new TBufferFile is created.  The caller owns the
+/// buffer and should give it back with Release (or delete it).
+
+TBuffer *TBasketBufferPool::Acquire(TBuffer::EMode mode, Int_t size)
+{
+   TBuffer *buffer = nullptr;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ++fStats.fAcquired;
+      // The buffers of the class of the request may be too small, the ones of
+      // the next class are always large enough (and at most 4 times too large).
+      const Int_t cls = GetClass(size);
+      for (Int_t c = cls; c < kNClasses && c <= cls + 1 && !buffer; ++c) {
+         auto &freeBuffers = fFreeBuffers[c];
+         for (auto iter = freeBuffers.rbegin(); iter != freeBuffers.rend(); ++iter) {
+            if ((*iter)->BufferSize() >= size || c == kNClasses - 1) {
+               buffer = *iter;
+               freeBuffers.erase(std::next(iter).base());
+               fStats.fPooledBytes -= buffer->BufferSize();
+               ++fStats.fReused;
+               break;
+            }
+         }
+      }
+   }
+   if (!buffer)
+      return new TBufferFile(mode, size);
+
+   if (buffer->BufferSize() < size)
+      buffer->Expand(size, kFALSE);
+   if (mode == TBuffer::kRead)
+      buffer->SetReadMode();
+   else
+      buffer->SetWriteMode();
+   buffer->Reset();
+   buffer->SetPidOffset(0);
+   buffer->SetParent(nullptr);
+   return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take back the ownership of a buffer.
+///
+/// The buffer is kept for later reuse, unless it does not own its memory (for
+/// example when it points to a buffer of the TTreeCacheUnzip), it is not a
+/// plain TBufferFile or the pool is full, in which case it is deleted.
+
+void TBasketBufferPool::Release(TBuffer *buffer)
+{
+   if (!buffer)
+      return;
+   const Int_t bufferSize = buffer->BufferSize();
+   Bool_t keep = buffer->TestBit(TBuffer::kIsOwner) && buffer->Buffer() && bufferSize >= kMinClassSize &&
+                 typeid(*buffer) == typeid(TBufferFile);
+   if (keep) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ++fStats.fReleased;
+      if (fStats.fPooledBytes + bufferSize <= fMaxBytes) {
+         fFreeBuffers[GetClass(bufferSize)].push_back(buffer);
+         fStats.fPooledBytes += bufferSize;
+         if (fStats.fPooledBytes > fStats.fPeakBytes)
+            fStats.fPeakBytes = fStats.fPooledBytes;
+         return;
+      }
+      ++fStats.fDiscarded;
+   } else {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ++fStats.fReleased;
+      ++fStats.fDiscarded;
+   }
+   delete buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete all the free buffers.
+
+void TBasketBufferPool::Clear()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (auto &freeBuffers : fFreeBuffers) {
+      for (auto buffer : freeBuffers)
+         delete buffer;
+      freeBuffers.clear();
+   }
+   fStats.fPooledBytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a snapshot of the usage statistics.
+
+TBasketBufferPool::Stats TBasketBufferPool::GetStats() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fStats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change the maximum amount of memory kept in the free buffers.  Lowering it
+/// does not free the buffers already in the pool (see Clear).
+
+void TBasketBufferPool::SetMaxBytes(Long64_t maxBytes)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fMaxBytes = maxBytes > 0 ? maxBytes : 0;
+}
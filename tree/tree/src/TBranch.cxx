@@ -1327,18 +1327,46 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    // Remember which entry we are reading.
    fReadEntry = entry;
 
-   Bool_t enabled = !TestBit(kDoNotProcess) || getall;
+   if (R__unlikely(TestBit(kDoNotProcess) && !getall)) {
+      return 0;
+   }
+   TBuffer *buf = nullptr;
+   Int_t status = GetEntryBuffer(entry, buf);
+   if (R__unlikely(status <= 0)) {
+      return status;
+   }
+
+   Int_t bufbegin = buf->Length();
+   (this->*fReadLeaves)(*buf);
+   return buf->Length() - bufbegin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the basket holding the given entry and position its buffer at the
+/// beginning of the data of this entry, without reading it.
+///
+/// This gives direct access to the serialized content of the entry, for
+/// example to read the values of a data member of the objects of a split
+/// collection in one go (see TTreeReaderArray).  The buffer belongs to the
+/// current basket of the branch and stays valid until the next call to
+/// GetEntry or GetEntryBuffer.
+///
+/// Returns 1 on success, 0 if the entry does not exist and -1 in case of an
+/// I/O error.
+
+Int_t TBranch::GetEntryBuffer(Long64_t entry, TBuffer *&buf)
+{
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+   buf = nullptr;
    TBasket *basket; // will be initialized in the if/then clauses.
    Long64_t first;
-   if (R__likely(enabled && fFirstBasketEntry <= entry && entry < fNextBasketEntry)) {
+   if (R__likely(fFirstBasketEntry <= entry && entry < fNextBasketEntry)) {
       // We have found the basket containing this entry.
       // make sure basket buffers are in memory.
       basket = fCurrentBasket;
       first = fFirstBasketEntry;
    } else {
-      if (!enabled) {
-         return 0;
-      }
       if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
          return 0;
       }
@@ -1382,7 +1410,7 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
       fCurrentBasket = basket;
    }
    basket->PrepareBasket(entry);
-   TBuffer* buf = basket->GetBufferRef();
+   buf = basket->GetBufferRef();
 
    // This test necessary to read very old Root files (NvE).
    if (R__unlikely(!buf)) {
@@ -1411,10 +1439,7 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
       bufbegin = basket->GetKeylen() + ((entry-first) * basket->GetNevBufSize());
       buf->SetBufferOffset(bufbegin);
    }
-
-   // Int_t bufbegin = buf->Length();
-   (this->*fReadLeaves)(*buf);
-   return buf->Length() - bufbegin;
+   return 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
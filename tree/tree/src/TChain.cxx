@@ -1630,6 +1630,8 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   if (fBasketBufferPool)
+      fTree->SetBasketBufferPool(fBasketBufferPool);
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
@@ -341,6 +341,7 @@ End_Macro
 #include <ROOT/RConfig.hxx>
 #include "TTree.h"
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TArrayC.h"
 #include "TBufferFile.h"
@@ -4295,6 +4296,18 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// You can use the option "goff" to turn off the graphics output
 /// of TTree::Draw in the above example.
 ///
+/// ### Parallel processing
+///
+/// When implicit multithreading is enabled (see ROOT::EnableImplicitMT),
+/// TTree::Draw and TTree::Project fill TH1, TH2, TProfile and TProfile2D
+/// histograms in parallel: the entries are split by cluster and each thread
+/// evaluates its own copy of the expressions into its own copy of the
+/// histogram, the copies being merged at the end. This is done only when all
+/// the entries of the tree are processed, when there are more entries than
+/// the estimate described above, when no TEntryList or TEventList is used
+/// and when the expressions do not use `Entry$` or `Entries$` or return
+/// strings. In this case the arrays returned by GetV1() etc. must not be used.
+///
 /// ### Automatic interface to TTree::Draw via the TTreeViewer
 ///
 /// A complete graphical interface to this function is implemented
@@ -4395,6 +4408,10 @@ void TTree::DropBuffers(Int_t)
 /// Note that calling FlushBaskets too often increases the IO time.
 ///
 /// Note that calling AutoSave too often increases the IO time and also the file size.
+///
+/// When the online tuning is enabled (see SetAutoTuning), the cluster size and
+/// the basket buffer sizes are re-adjusted after each flush, based on the
+/// compressed size of the cluster that was just written.
 
 Int_t TTree::Fill()
 {
@@ -4505,7 +4522,10 @@ Int_t TTree::Fill()
             // they will automatically grow to the size needed for an event cluster (with the basket
             // shrinking preventing them from growing too much larger than the actually-used space).
             if (!TestBit(TTree::kOnlyFlushAtCluster)) {
-               OptimizeBaskets(GetTotBytes(), 1, "");
+               Long64_t maxMemory = GetTotBytes();
+               if (fTuneMaxMemory > 0 && maxMemory > fTuneMaxMemory)
+                  maxMemory = fTuneMaxMemory;
+               OptimizeBaskets(maxMemory, 1, "");
                if (gDebug > 0)
                   Info("TTree::Fill", "OptimizeBaskets called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n",
                        fEntries, GetZipBytes(), fFlushedBytes);
@@ -4558,6 +4578,8 @@ Int_t TTree::Fill()
       if (gDebug > 0)
          Info("TTree::Fill", "FlushBaskets() called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n", fEntries,
               GetZipBytes(), fFlushedBytes);
+      if (fTuneClusterBytes > 0)
+         TuneBaskets(GetZipBytes() - fFlushedBytes);
       fFlushedBytes = GetZipBytes();
    }
 
@@ -6918,6 +6940,52 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Re-adjust the cluster size and the basket buffer sizes after a cluster of
+/// fAutoFlush entries, compressed into clusterZipBytes, has been flushed.
+///
+/// The new cluster size aims at fTuneClusterBytes compressed bytes per cluster,
+/// while the uncompressed cluster (held in the baskets until it is flushed) has
+/// to fit in fTuneMaxMemory.  To smooth out the fluctuations of the compression
+/// ratio, the cluster size changes by at most a factor 2 at a time and is left
+/// alone if it is already within 10% of the target.  When it changes, the
+/// basket buffers are resized (see OptimizeBaskets) so that each branch can
+/// hold a full cluster in a single basket.
+
+void TTree::TuneBaskets(Long64_t clusterZipBytes)
+{
+   if (clusterZipBytes <= 0 || fAutoFlush <= 0)
+      return;
+
+   Double_t zipPerEntry = Double_t(clusterZipBytes) / fAutoFlush;
+   Double_t totPerEntry = zipPerEntry;
+   if (GetZipBytes() > 0)
+      totPerEntry = zipPerEntry * GetTotBytes() / GetZipBytes();
+
+   Long64_t target = Long64_t(fTuneClusterBytes / zipPerEntry);
+   if (fTuneMaxMemory > 0 && totPerEntry > 0)
+      target = TMath::Min(target, Long64_t(fTuneMaxMemory / totPerEntry));
+   target = TMath::Max(fAutoFlush / 2, TMath::Min(2 * fAutoFlush, target));
+   if (target < 1)
+      target = 1;
+
+   if (10 * TMath::Abs(target - fAutoFlush) < fAutoFlush)
+      return;
+
+   if (gDebug > 0)
+      Info("TuneBaskets", "Changing cluster size from %lld to %lld entries at entry %lld (%lld compressed bytes)",
+           fAutoFlush, target, fEntries, clusterZipBytes);
+
+   SetAutoFlush(target);
+
+   if (!TestBit(TTree::kOnlyFlushAtCluster)) {
+      ULong64_t maxMemory = ULong64_t(totPerEntry * target * fTargetMemoryRatio);
+      if (fTuneMaxMemory > 0 && maxMemory > ULong64_t(fTuneMaxMemory))
+         maxMemory = fTuneMaxMemory;
+      OptimizeBaskets(maxMemory, 1, "");
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to the Principal Components Analysis class.
 ///
@@ -7988,6 +8056,80 @@ void TTree::SetAutoSave(Long64_t autos)
    fAutoSave = autos;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the online tuning of the cluster and basket sizes while filling.
+///
+/// By default, the cluster size (see SetAutoFlush) and the basket buffer sizes
+/// (see OptimizeBaskets) are set once, when the first cluster is flushed.
+/// With the online tuning, TTree::Fill re-adjusts them after each flush, using
+/// the compression ratio and the size per entry of each branch observed so far:
+///
+///  - clusterBytes is the target size, after compression, of a cluster.
+///  - maxMemory, if positive, caps the memory used by the baskets being filled,
+///    i.e. the uncompressed size of a cluster.
+///
+/// For example, to aim at 32 MB compressed clusters while never keeping more
+/// than 1 GB of uncompressed data in memory:
+/// ~~~ {.cpp}
+///     tree->SetAutoTuning(32000000, 1000000000);
+/// ~~~
+/// If nothing was flushed yet, the first cluster is also set to be flushed
+/// after clusterBytes compressed bytes.  A clusterBytes of 0 disables the
+/// online tuning.
+
+void TTree::SetAutoTuning(Long64_t clusterBytes, Long64_t maxMemory)
+{
+   fTuneClusterBytes = clusterBytes > 0 ? clusterBytes : 0;
+   fTuneMaxMemory = maxMemory > 0 ? maxMemory : 0;
+   if (fTuneClusterBytes > 0 && fFlushedBytes == 0 && fAutoFlush < 0)
+      fAutoFlush = -fTuneClusterBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recycle the buffers of the baskets of this tree.
+///
+/// While reading, baskets are created and deleted as the tree moves from
+/// cluster to cluster (in particular when whole clusters are prefetched or
+/// when SetMaxVirtualSize forces the baskets to be dropped), and each of them
+/// allocates and frees buffers of similar sizes.  With a pool, the buffers of
+/// the deleted baskets are kept, up to maxBytes, and given to the next baskets
+/// instead of going back to the memory allocator; this reduces the contention
+/// on the allocator when many threads are reading and the fragmentation of
+/// the memory.  The pool is thread-safe and, for a TChain, shared by the trees
+/// of all the files.  Its usage is reported by TTreePerfStats.
+///
+/// A maxBytes of 0 disables the pool (the baskets currently holding a buffer
+/// from the pool will still give it back when deleted).
+
+void TTree::SetBasketBufferPoolSize(Long64_t maxBytes)
+{
+   if (maxBytes <= 0) {
+      fBasketBufferPool.reset();
+   } else if (fBasketBufferPool) {
+      fBasketBufferPool->SetMaxBytes(maxBytes);
+   } else {
+      fBasketBufferPool = std::make_shared<ROOT::Internal::TBasketBufferPool>(maxBytes);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum memory kept by the basket buffer pool, 0 if the tree
+/// does not use a pool (see SetBasketBufferPoolSize).
+
+Long64_t TTree::GetBasketBufferPoolSize() const
+{
+   return fBasketBufferPool ? fBasketBufferPool->GetMaxBytes() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the usage statistics of the basket buffer pool, all zero if the
+/// tree does not use a pool (see SetBasketBufferPoolSize).
+
+TTree::TBasketBufferPoolStats TTree::GetBasketBufferPoolStats() const
+{
+   return fBasketBufferPool ? fBasketBufferPool->GetStats() : TBasketBufferPoolStats();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set a branch's basket size.
 ///
@@ -1,7 +1,9 @@
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TBasket.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include "TMemFile.h"
@@ -403,3 +405,79 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, BufferPoolRecycle)
+{
+   ROOT::Internal::TBasketBufferPool pool(100000);
+
+   TBuffer *first = pool.Acquire(TBuffer::kWrite, 3000);
+   ASSERT_NE(first, nullptr);
+   EXPECT_GE(first->BufferSize(), 3000);
+   pool.Release(first);
+
+   // A request of a similar size is served by the released buffer ...
+   TBuffer *second = pool.Acquire(TBuffer::kRead, 2500);
+   EXPECT_EQ(first, second);
+   EXPECT_TRUE(second->IsReading());
+   EXPECT_EQ(second->Length(), 0);
+
+   // ... but not a much larger one.
+   TBuffer *large = pool.Acquire(TBuffer::kRead, 50000);
+   EXPECT_NE(second, large);
+   EXPECT_GE(large->BufferSize(), 50000);
+
+   // Buffers not owning their memory are never pooled.
+   static char external[4096];
+   pool.Release(new TBufferFile(TBuffer::kRead, sizeof(external), external, kFALSE));
+
+   pool.Release(second);
+   pool.Release(large);
+   auto stats = pool.GetStats();
+   EXPECT_EQ(stats.fAcquired, 3u);
+   EXPECT_EQ(stats.fReused, 1u);
+   EXPECT_EQ(stats.fReleased, 4u);
+   EXPECT_EQ(stats.fDiscarded, 1u);
+   EXPECT_LE(stats.fPooledBytes, 100000);
+
+   pool.Clear();
+   EXPECT_EQ(pool.GetStats().fPooledBytes, 0);
+}
+
+// Read a tree with several baskets per cluster while prefetching clusters, so
+// that baskets are created and deleted, with a pool of basket buffers.
+TEST(TBasket, BufferPoolRead)
+{
+   const Int_t nEvents = 10000;
+   TMemFile f("tbasket_pool.root", "RECREATE");
+   {
+      TTree t("t", "Tree with several baskets per cluster");
+      t.SetAutoFlush(1000);
+      Int_t idx;
+      auto branch = t.Branch("idx", &idx, "idx/I");
+      for (idx = 0; idx < nEvents; idx++) {
+         // The first flush optimizes the basket size, shrink it afterwards.
+         if (idx == 1000)
+            branch->SetBasketSize(512);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTree *tree = nullptr;
+   f.GetObject("t", tree);
+   ASSERT_NE(tree, nullptr);
+   tree->SetClusterPrefetch(true);
+   tree->SetBasketBufferPoolSize(1000000);
+   Int_t idx = -1;
+   tree->SetBranchAddress("idx", &idx);
+   for (Int_t entry = 0; entry < nEvents; ++entry) {
+      tree->GetEntry(entry);
+      ASSERT_EQ(entry, idx);
+   }
+
+   EXPECT_EQ(tree->GetBasketBufferPoolSize(), 1000000);
+   auto stats = tree->GetBasketBufferPoolStats();
+   EXPECT_GT(stats.fAcquired, 0u);
+   EXPECT_GT(stats.fReused, 0u);
+   delete tree;
+}
@@ -2,6 +2,7 @@
 #include "TTree.h"
 #include "TBranch.h"
 #include "TRandom.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
@@ -53,3 +54,48 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+TEST(TTreeClusterAutoTuning, clusterSize)
+{
+   const auto ofileName = "TTreeClusterAutoTuning.root";
+   TFile file(ofileName, "RECREATE");
+   TRandom random(836);
+   Double_t data = 0;
+
+   // Aim at 64kB compressed clusters, starting from 1000 entries (about 8kB).
+   TTree tree("tree", "A tree with online cluster tuning");
+   tree.SetAutoFlush(1000);
+   tree.SetAutoTuning(64000);
+   tree.Branch("branch", &data);
+
+   // Same, but the uncompressed cluster should not exceed 16kB.
+   TTree capped("capped", "A tree with online cluster tuning and a memory cap");
+   capped.SetAutoFlush(1000);
+   capped.SetAutoTuning(64000, 16000);
+   capped.Branch("branch", &data);
+
+   for (Int_t ev = 0; ev < 50000; ev++) {
+      data = random.Gaus(100, 7);
+      tree.Fill();
+      capped.Fill();
+   }
+
+   EXPECT_GT(tree.GetAutoFlush(), 4000);
+   EXPECT_LE(capped.GetAutoFlush(), 2000);
+
+   // The cluster ranges must still describe the whole tree.
+   for (TTree *t : {&tree, &capped}) {
+      auto clusters = t->GetClusterIterator(0);
+      Long64_t start = 0;
+      Long64_t nclusters = 0;
+      while ((start = clusters()) < t->GetEntries()) {
+         EXPECT_EQ(start, clusters.GetStartEntry());
+         EXPECT_GT(clusters.GetNextEntry(), start);
+         ++nclusters;
+      }
+      EXPECT_GT(nclusters, 1);
+   }
+
+   file.Close();
+   gSystem->Unlink(ofileName);
+}
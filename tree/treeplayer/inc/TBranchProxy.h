@@ -115,6 +115,9 @@ namespace Detail {
 
       TBranchProxy* GetProxy() { return this; }
       const char* GetBranchName() const { return fBranchName; }
+      TBranch *GetBranch() const { return fBranch; } // Assumes that Setup() has been called.
+      Long64_t GetReadEntry() const { return fDirector ? fDirector->GetReadEntry() : -1; }
+      TTree *GetDirectorTree() const { return fDirector ? fDirector->GetTree() : nullptr; }
 
       void Reset();
 
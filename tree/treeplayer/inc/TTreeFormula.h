@@ -83,6 +83,9 @@ protected:
       kMinIf           = 204,
       kMaxIf           = 205
    };
+   enum {
+      kMaxSharedOperands = 32  // Maximum number of tree variable values reused within one evaluation
+   };
 
    // Helper struct to hold a cache
    // that can accelerate calculation of the RealIndex.
@@ -131,6 +134,8 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   std::vector<Int_t> fSharedOperands; //! For each operation, slot+1 where the value of a repeated tree variable is saved (>0) or reused from (<0)
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -148,6 +153,7 @@ protected:
    virtual Double_t  GetValueFromMethod(Int_t i, TLeaf *leaf) const;
    virtual void*     GetValuePointerFromMethod(Int_t i, TLeaf *leaf) const;
    Int_t             GetRealInstance(Int_t instance, Int_t codeindex);
+   void              FindSharedOperands();
 
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
@@ -59,6 +59,9 @@ protected:
    Double_t      fDiskTime;      //Time spent in pure raw disk IO
    Double_t      fUnzipTime;     //Time spent uncompressing the data.
    Double_t      fCompress;      //Tree compression factor
+   Long64_t      fPoolAcquired;  //Number of basket buffers requested from the basket buffer pool
+   Long64_t      fPoolReused;    //Number of basket buffers recycled by the basket buffer pool
+   Long64_t      fPoolPeakBytes; //Largest amount of memory held by the basket buffer pool
    TString       fName;          //name of this TTreePerfStats
    TString       fHostInfo;      //name of the host system, ROOT version and date
    TFile        *fFile;          //!pointer to the file containing the Tree
@@ -94,6 +97,9 @@ public:
    const char      *GetHostInfo() const{return fHostInfo.Data();}
    const char      *GetName()    const{return fName.Data();}
    virtual Int_t    GetNleaves() const {return fNleaves;}
+   Long64_t         GetPoolAcquired() const {return fPoolAcquired;}
+   Long64_t         GetPoolPeakBytes() const {return fPoolPeakBytes;}
+   Long64_t         GetPoolReused() const {return fPoolReused;}
    virtual Long64_t GetNumEvents() const {return 0;}
    TPaveText       *GetPave()      {return fPave;}
    virtual Int_t    GetReadaheadSize() const {return fReadaheadSize;}
@@ -147,7 +153,7 @@ public:
 
    BasketList_t     GetDuplicateBasketCache() const;
 
-   ClassDef(TTreePerfStats, 7) // TTree I/O performance measurement
+   ClassDef(TTreePerfStats, 8) // TTree I/O performance measurement
 };
 
 #endif
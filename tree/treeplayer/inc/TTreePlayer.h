@@ -59,6 +59,7 @@ protected:
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Bool_t         ProcessDrawMT(Long64_t nentries, Long64_t firstentry);
 
 public:
    TTreePlayer();
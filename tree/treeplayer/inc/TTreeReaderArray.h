@@ -67,6 +67,11 @@ Base class of TTreeReaderArray.
  * In order to access values which are not collections, the TTreeReaderValue class can
  * be used.
  *
+ * The data members of basic type of the objects of a split std::vector (for
+ * example "hits.x" for a branch "hits" holding a `std::vector<Hit>`) are read
+ * directly from their sub-branch as contiguous arrays, without creating the
+ * `Hit` objects.
+ *
  * See the documentation of TTreeReader for more details and examples.
 */
 // clang-format on
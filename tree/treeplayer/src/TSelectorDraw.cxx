@@ -935,6 +935,37 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the entry loop prepared by Begin() can be split among
+/// several threads, each using its own selector (see InitSlot()) and its own
+/// copy of the histogram.
+///
+/// This is the case when the action only fills a TH1, TH2, TProfile or
+/// TProfile2D, when no entry or event list is used, and when the expressions
+/// neither return strings or objects nor depend on the entry number.
+
+Bool_t TSelectorDraw::CanProcessMT() const
+{
+   const Int_t action = fAction < 0 ? -fAction : fAction;
+   if (action != 1 && action != 2 && action != 4 && action != 23) return kFALSE;
+   if (fObjEval || fTreeElist || !fObject || !fTree || fTree->GetEventList()) return kFALSE;
+
+   auto usesEntryNumber = [](const TTreeFormula *form) {
+      const TString expr = form->GetTitle();
+      return expr.Contains("Entry$") || expr.Contains("Entries$");
+   };
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString() || usesEntryNumber(fVar[i])) return kFALSE;
+   }
+   if (fSelect && (fSelect->IsString() || usesEntryNumber(fSelect))) return kFALSE;
+
+   // Alphanumeric bins are created on the fly while filling.
+   TH1 *hist = (TH1*)fObject;
+   if (hist->GetXaxis()->GetLabels() || hist->GetYaxis()->GetLabels() || hist->GetZaxis()->GetLabels())
+      return kFALSE;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -1118,6 +1149,57 @@ void TSelectorDraw::InitArrays(Int_t newsize)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this selector to process entries of tree on behalf of master,
+/// which must have been initialized by Begin() and for which CanProcessMT()
+/// returns kTRUE. The variables and selection of master are compiled for
+/// tree, and the selected rows are filled into hist, which must be a copy of
+/// the histogram of master. Nothing is drawn by this selector.
+///
+/// Return kFALSE if the expressions cannot be compiled for tree.
+
+Bool_t TSelectorDraw::InitSlot(const TSelectorDraw &master, TTree *tree, TH1 *hist)
+{
+   SetStatus(0);
+   ResetAbort();
+   fTree           = tree;
+   fOption         = "goff";
+   fObject         = hist;
+   fOldHistogram   = 0;
+   fTreeElist      = 0;
+   fTreeElistArray = 0;
+   fCleanElist     = kFALSE;
+   fSelectedRows   = 0;
+   fDraw           = 0;
+   // The binning is already fixed by master, no estimate of the limits is needed.
+   fAction         = master.fAction < 0 ? -master.fAction : master.fAction;
+
+   TString varexp;
+   for (Int_t i = 0; i < master.fDimension; ++i) {
+      if (i) varexp += ":";
+      varexp += master.fVar[i]->GetTitle();
+   }
+   const char *selection = master.fSelect ? master.fSelect->GetTitle() : "";
+   if (!CompileVariables(varexp, selection) || fDimension != master.fDimension) return kFALSE;
+
+   for (Int_t i = 0; i < fValSize; ++i)
+      fVarMultiple[i] = kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fVar[i]->GetMultiplicity()) fVarMultiple[i] = kTRUE;
+   }
+   fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+
+   fForceRead = fTree->TestBit(TTree::kForceRead);
+   fWeight    = fTree->GetWeight();
+   fNfill     = 0;
+
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVal[i]) fVal[i] = new Double_t[(Int_t)fTree->GetEstimate()];
+   }
+   if (!fW) fW = new Double_t[(Int_t)fTree->GetEstimate()];
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Build Index array for names in varexp.
 /// This will allocated a C style array of TString and Ints
@@ -1351,6 +1433,19 @@ void TSelectorDraw::SetEstimate(Long64_t)
    delete [] fW;   fW  = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of selected rows after the entry loop was run outside of
+/// this selector, e.g. by per-thread selectors set up with InitSlot().
+/// Rows buffered but not yet passed to TakeAction() are discarded, and an
+/// action waiting for the estimate of the histogram limits is marked as done.
+
+void TSelectorDraw::SetSelectedRows(Long64_t nrows)
+{
+   fSelectedRows = nrows;
+   fNfill = 0;
+   if (fAction < 0) fAction = -fAction;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action for object obj fNfill times.
 
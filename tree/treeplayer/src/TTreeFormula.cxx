@@ -292,6 +292,8 @@ void TTreeFormula::Init(const char*name, const char* expression)
       fBranches.AddAtAndExpand(branch,k);
    }
 
+   FindSharedOperands();
+
    if (IsInteger(kFALSE)) SetBit(kIsInteger);
 
    if (TestBit(TTreeFormula::kNeedEntries)) {
@@ -319,6 +321,135 @@ void TTreeFormula::Init(const char*name, const char* expression)
    if(savedir) savedir->cd();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the tree variables that are used more than once in the expression,
+/// for example in "px*px+py*py" or "x>0 && x<5", and record which operation
+/// can reuse the value read by a previous one during the same evaluation
+/// instead of going again through GetRealInstance and the leaf (or data member)
+/// lookup.
+///
+/// Two operations are considered identical when they refer to the same leaf
+/// through the same expression, with the same fixed indices and without any
+/// variable index (the latter could depend on the instance in a different way).
+/// A value is reused only when the first operation is guaranteed to have been
+/// executed, i.e. the state is merged at the destination of each jump of the
+/// ternary operator and of the boolean optimizations.
+
+void TTreeFormula::FindSharedOperands()
+{
+   fSharedOperands.clear();
+
+   // Assign an equivalence class to each reusable tree variable operation.
+   std::vector<Int_t> classes(fNoper, -1);
+   Int_t nclasses = 0;
+   Bool_t hasDuplicate = kFALSE;
+   for (Int_t i = 0; i < fNoper; ++i) {
+      if (GetAction(i) != kDefinedVariable) continue;
+      const Int_t code = GetActionParam(i);
+      if (code < 0 || code >= fNcodes || fHasMultipleVarDim[code]) continue;
+      if (fLookupType[code] != kDirect && fLookupType[code] != kDataMember) continue;
+      TLeaf *leaf = code <= fLeaves.GetLast() ? (TLeaf*)fLeaves.UncheckedAt(code) : 0;
+      if (!leaf) continue;
+      Bool_t hasVarIndex = kFALSE;
+      for (Int_t k = 0; k < kMAXFORMDIM; ++k) {
+         if (fVarIndexes[code][k]) hasVarIndex = kTRUE;
+      }
+      if (hasVarIndex) continue;
+
+      for (Int_t j = 0; j < i && classes[i] < 0; ++j) {
+         if (classes[j] < 0) continue;
+         const Int_t other = GetActionParam(j);
+         if (fLeaves.UncheckedAt(other) != leaf || fLookupType[other] != fLookupType[code]) continue;
+         if (fNdimensions[other] != fNdimensions[code] || fExpr[j] != fExpr[i]) continue;
+         Bool_t same = kTRUE;
+         for (Int_t k = 0; k < kMAXFORMDIM && same; ++k) {
+            same = fIndexes[other][k] == fIndexes[code][k] && fCumulSizes[other][k] == fCumulSizes[code][k];
+         }
+         if (same) {
+            classes[i] = classes[j];
+            hasDuplicate = kTRUE;
+         }
+      }
+      if (classes[i] < 0) classes[i] = nclasses++;
+   }
+   if (!hasDuplicate) return;
+
+   // Forward data flow: 'avail' holds, for each class, the operation that
+   // already computed the value on every path leading to the current operation.
+   // All the jumps are forward, so a single pass is enough.
+   std::vector<Int_t> avail(nclasses, -1);
+   std::vector<std::vector<Int_t> > incoming(fNoper + 2);
+   auto merge = [&](Int_t target) {
+      if (target < 0 || target > fNoper + 1) return;
+      std::vector<Int_t> &in = incoming[target];
+      if (in.empty()) {
+         in = avail;
+      } else {
+         for (Int_t c = 0; c < nclasses; ++c) {
+            if (in[c] != avail[c]) in[c] = -1;
+         }
+      }
+   };
+
+   std::vector<Int_t> source(fNoper, -1);
+   Bool_t reachable = kTRUE;
+   for (Int_t i = 0; i < fNoper; ++i) {
+      if (!incoming[i].empty()) {
+         if (reachable) merge(i);
+         avail = incoming[i];
+         reachable = kTRUE;
+      } else if (!reachable) {
+         std::fill(avail.begin(), avail.end(), -1);
+         reachable = kTRUE;
+      }
+
+      const Int_t cls = classes[i];
+      if (cls >= 0) {
+         if (avail[cls] >= 0) source[i] = avail[cls];
+         else avail[cls] = i;
+      }
+
+      const Int_t action = GetAction(i);
+      const Int_t param = GetActionParam(i);
+      switch (action) {
+         case kJump:
+            merge(param + 1);
+            reachable = kFALSE;
+            break;
+         case kJumpIf:
+            merge(param + 1);
+            break;
+         case kBoolOptimize:
+            merge(i + param / 10 + 1);
+            break;
+         case kAlternate:
+         case kAlternateString:
+         case kMinIf:
+         case kMaxIf:
+            merge(i + 2);
+            break;
+         default:
+            break;
+      }
+   }
+
+   // Number the saving operations and record which slot each reuse reads.
+   std::vector<Int_t> slots(fNoper, 0);
+   Int_t nslots = 0;
+   fSharedOperands.assign(fNoper, 0);
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t first = source[i];
+      if (first < 0) continue;
+      if (slots[first] == 0) {
+         if (nslots == kMaxSharedOperands) continue;
+         slots[first] = ++nslots;
+         fSharedOperands[first] = nslots;
+      }
+      fSharedOperands[i] = -slots[first];
+   }
+   if (nslots == 0) fSharedOperands.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Tree Formula default destructor.
 
@@ -3993,6 +4124,7 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
    }
 
    T tab[kMAXFOUND];
+   T sharedValues[kMaxSharedOperands];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
    const char **stringStack = stringStackArg?stringStackArg:stringStackLocal;
@@ -4210,6 +4342,9 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
          if (newaction == kDefinedVariable) {
 
             const Int_t code = (oper & kTFOperMask);
+            // Reuse the value of the same tree variable read earlier in this evaluation.
+            const Int_t shared = fSharedOperands.empty() ? 0 : fSharedOperands[i];
+            if (shared < 0) { tab[pos++] = sharedValues[-shared-1]; continue; }
             const Int_t lookupType = fLookupType[code];
             switch (lookupType) {
                case kIndexOfEntry: tab[pos++] = (T)fTree->GetReadEntry(); continue;
@@ -4223,10 +4358,14 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
                case kMin:          tab[pos++] = FindMin<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
                case kMax:          tab[pos++] = FindMax<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
 
-               case kDirect:     { TT_EVAL_INIT_LOOP; tab[pos++] = leaf->GetTypedValue<T>(real_instance); continue; }
+               case kDirect:     { TT_EVAL_INIT_LOOP; tab[pos++] = leaf->GetTypedValue<T>(real_instance);
+                                   if (shared > 0) sharedValues[shared-1] = tab[pos-1];
+                                   continue; }
                case kMethod:     { TT_EVAL_INIT_LOOP; tab[pos++] = GetValueFromMethod(code,leaf); continue; }
                case kDataMember: { TT_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
-                                          GetTypedValue<T>(leaf,real_instance); continue; }
+                                          GetTypedValue<T>(leaf,real_instance);
+                                   if (shared > 0) sharedValues[shared-1] = tab[pos-1];
+                                   continue; }
                case kTreeMember: { TREE_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
                                           GetTypedValue<T>((TLeaf*)0x0,real_instance); continue; }
                case kEntryList: { TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
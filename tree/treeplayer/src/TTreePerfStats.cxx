@@ -61,6 +61,8 @@ The Draw or Print functions print the following information:
  -  Real Time = Real Time in seconds
  -  CPU  Time = CPU Time in seconds
  -  Disk Time = Real Time spent in pure raw disk IO
+ -  PoolReuse = Fraction of the basket buffers recycled by the pool (see TTree::SetBasketBufferPoolSize)
+ -  PoolPeak  = Largest amount of memory held by the basket buffer pool
  -  Disk IO   = Raw disk IO speed in MBytes/second
  -  ReadUZRT  = Unzipped MBytes per RT second
  -  ReadUZCP  = Unipped MBytes per CP second
@@ -124,6 +126,9 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fDiskTime      = 0;
    fUnzipTime     = 0;
    fCompress      = 0;
+   fPoolAcquired  = 0;
+   fPoolReused    = 0;
+   fPoolPeakBytes = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
 }
@@ -159,6 +164,9 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fCpuTime       = 0;
    fDiskTime      = 0;
    fUnzipTime     = 0;
+   fPoolAcquired  = 0;
+   fPoolReused    = 0;
+   fPoolPeakBytes = 0;
    fRealTimeAxis  = 0;
    fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
 
@@ -327,6 +335,12 @@ void TTreePerfStats::Finish()
    fBytesReadExtra= fFile->GetBytesReadExtra();
    fRealTime      = fWatch->RealTime();
    fCpuTime       = fWatch->CpuTime();
+   if (fTree->GetBasketBufferPoolSize() > 0) {
+      auto stats = fTree->GetBasketBufferPoolStats();
+      fPoolAcquired  = stats.fAcquired;
+      fPoolReused    = stats.fReused;
+      fPoolPeakBytes = stats.fPeakBytes;
+   }
    Int_t npoints  = fGraphIO->GetN();
    if (!npoints) return;
    Double_t iomax = TMath::MaxElement(npoints,fGraphIO->GetY());
@@ -548,6 +562,10 @@ void TTreePerfStats::Print(Option_t * option) const
       printf("Strm Time = %7.3f seconds\n",fCpuTime-fUnzipTime);
       printf("UnzipTime = %7.3f seconds\n",fUnzipTime);
    }
+   if (fPoolAcquired) {
+      printf("PoolReuse = %5.2f per cent of %lld basket buffers\n",100.*fPoolReused/fPoolAcquired,fPoolAcquired);
+      printf("PoolPeak  = %g MBytes\n",1e-6*fPoolPeakBytes);
+   }
    printf("Disk IO   = %7.3f MBytes/s\n",1e-6*fBytesRead/fDiskTime);
    printf("ReadUZRT  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fRealTime);
    printf("ReadUZCP  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fCpuTime);
@@ -84,6 +84,14 @@ extra libraries (Histogram, display, etc).
 #include "Fit/UnBinData.h"
 #include "Math/MinimizerOptions.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
 
 
 R__EXTERN Foption_t Foption;
@@ -2244,7 +2252,11 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
-   if (process) {
+
+   // The entry loop of TTree::Draw may be run in parallel, see ProcessDrawMT.
+   Bool_t processedMT = process && selector == fSelector && ProcessDrawMT(nentries, firstentry);
+
+   if (process && !processedMT) {
 
       Long64_t readbytesatstart = 0;
       readbytesatstart = TFile::GetFileBytesRead();
@@ -2334,6 +2346,132 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the entry loop of TTree::Draw in parallel on the implicit
+/// multithreading pool (see ROOT::EnableImplicitMT).
+///
+/// The entries are split by cluster with ROOT::TTreeProcessorMT. Each thread
+/// compiles the expressions of fSelector once for its tree (see
+/// TSelectorDraw::InitSlot) and reuses them for all its clusters, filling a
+/// copy of the histogram owned by that thread. The copies are merged into the histogram of fSelector at the end.
+/// When the histogram limits must be computed from the data, the first
+/// GetEstimate() selected rows are processed sequentially to fix them.
+///
+/// This is only done when the full tree is processed, when it has more
+/// entries than GetEstimate() (the content of the arrays returned by GetV1()
+/// etc. is then not meaningful anyway), and when the draw request allows it
+/// (see TSelectorDraw::CanProcessMT).
+///
+/// Return kFALSE, without having processed any entry, if the sequential
+/// entry loop must be used instead.
+
+Bool_t TTreePlayer::ProcessDrawMT(Long64_t nentries, Long64_t firstentry)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !fSelector->CanProcessMT()) return kFALSE;
+   if (firstentry != 0 || nentries < fTree->GetEntries() || nentries <= fTree->GetEstimate()) return kFALSE;
+   // Weights set in memory and periodic updates of the pad are only known to fTree.
+   if (fTree->GetWeight() != 1 || fTree->GetUpdate()) return kFALSE;
+
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &) {
+      // e.g. trees which are not attached to a file
+      return kFALSE;
+   }
+
+   TH1 *hist = (TH1*)fSelector->GetObject();
+   if (fSelector->GetAction() < 0 && hist->CanExtendAllAxes()) {
+      Long64_t entry = firstentry;
+      for (; entry < firstentry + nentries && fSelector->GetAction() < 0; ++entry) {
+         Long64_t localEntry = fTree->LoadTree(entry);
+         if (localEntry < 0) return kTRUE;
+         fSelector->ProcessFill(localEntry);
+      }
+      // All the entries were needed to compute the limits.
+      if (entry == firstentry + nentries) return kTRUE;
+      // The parallel loop below processes all the entries again.
+      hist->Reset("ICES");
+      fSelector->SetSelectedRows(0);
+   }
+
+   // What a thread keeps from one cluster to the next: the expressions are
+   // compiled again only when the tree of the thread changes.
+   struct DrawSlot {
+      std::unique_ptr<TH1> fHist;
+      std::unique_ptr<TSelectorDraw> fSelector;
+      TTree *fTree = nullptr;
+   };
+   std::mutex mutex; // Protects slots and the compilation of the expressions
+   std::map<std::thread::id, DrawSlot> slots;
+   std::atomic<Long64_t> nrows(0);
+   std::atomic<bool> failed(false);
+
+   auto processRange = [&](TTreeReader &reader) {
+      TTree *tree = reader.GetTree();
+      DrawSlot *slot = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         slot = &slots[std::this_thread::get_id()];
+         if (!slot->fHist) {
+            TDirectory::TContext ctxt(nullptr);
+            slot->fHist.reset((TH1*)hist->Clone());
+            slot->fHist->SetDirectory(nullptr);
+            slot->fHist->ResetBit(kMustCleanup);
+            slot->fHist->Reset("ICES");
+            slot->fSelector.reset(new TSelectorDraw);
+         }
+         if (slot->fTree != tree) {
+            if (slot->fTree) {
+               // Fill what is left from the previous tree before compiling again.
+               slot->fSelector->Terminate();
+               nrows += slot->fSelector->GetSelectedRows();
+            }
+            slot->fTree = tree;
+            if (!slot->fSelector->InitSlot(*fSelector, tree, slot->fHist.get())) {
+               slot->fTree = nullptr;
+               failed = true;
+               return;
+            }
+         }
+      }
+      TSelectorDraw &slotSelector = *slot->fSelector;
+      Int_t treeNumber = -1;
+      while (reader.Next()) {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            slotSelector.Notify();
+         }
+         slotSelector.ProcessFill(reader.GetCurrentEntry());
+      }
+   };
+   processor->Process(processRange);
+
+   for (auto &slot : slots) {
+      if (!slot.second.fTree) continue;
+      slot.second.fSelector->Terminate();
+      nrows += slot.second.fSelector->GetSelectedRows();
+   }
+
+   if (failed) {
+      Warning("ProcessDrawMT", "Could not compile the expressions for all threads, processing the entries sequentially");
+      return kFALSE;
+   }
+
+   TList slotHists;
+   for (auto &slot : slots)
+      slotHists.Add(slot.second.fHist.get());
+   if (slotHists.GetSize()) hist->Merge(&slotHists);
+   fSelector->SetSelectedRows(nrows);
+   return kTRUE;
+#else
+   (void)nentries;
+   (void)firstentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
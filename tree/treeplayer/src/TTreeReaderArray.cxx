@@ -15,6 +15,7 @@
 #include "TBranchElement.h"
 #include "TBranchRef.h"
 #include "TBranchSTL.h"
+#include "TBuffer.h"
 #include "TBranchProxyDirector.h"
 #include "TClassEdit.h"
 #include "TFriendElement.h"
@@ -288,6 +289,130 @@ namespace {
       }
    };
 
+   // Reader interface for a data member of basic type of the objects of a
+   // split STL collection, giving access to the values of the member as a
+   // contiguous array (structure-of-arrays) without materializing the objects.
+   // The number of objects is read from the basket of the collection branch and
+   // the values are read in one go from the basket of the member's sub-branch.
+   class TSTLMemberColumnReader final: public TVirtualCollectionReader {
+   private:
+      Int_t fStreamerType;               // Type of the values, in memory and on file.
+      Int_t fValueSize;                  // Size of one value.
+      // The values are identified by the branch, the tree (and, for a TChain,
+      // the tree number) and the entry: when a TChain moves to the next file,
+      // the new branch may be allocated where the previous one was.
+      TBranch *fLastBranch = nullptr;    // Branch the current values were read from.
+      TTree *fLastTree = nullptr;        // Tree (or chain) the current values were read from.
+      Int_t fLastTreeNumber = -1;        // Number of the tree in the chain the current values were read from.
+      Long64_t fLastEntry = -1;          // Entry the current values were read from.
+      size_t fSize = 0;                  // Number of values of the current entry.
+      std::vector<Long64_t> fValues;     // Storage of the values (suitably aligned for any basic type).
+
+      template <typename T>
+      static void ReadValues(TBuffer &b, void *values, Int_t n) { b.ReadFastArray((T*)values, n); }
+
+      Bool_t Load(ROOT::Detail::TBranchProxy* proxy) {
+         if (!proxy->IsInitialized() && !proxy->Setup()) {
+            fReadStatus = TTreeReaderValueBase::kReadError;
+            Error("TSTLMemberColumnReader::Load()", "Unable to initialize %s.", proxy->GetBranchName());
+            return kFALSE;
+         }
+         TBranchElement *branch = (TBranchElement*)proxy->GetBranch();
+         const Long64_t entry = proxy->GetReadEntry();
+         TTree *tree = proxy->GetDirectorTree();
+         const Int_t treeNumber = tree ? tree->GetTreeNumber() : -1;
+         if (branch == fLastBranch && tree == fLastTree && treeNumber == fLastTreeNumber && entry == fLastEntry)
+            return fReadStatus == TTreeReaderValueBase::kReadSuccess;
+
+         fLastBranch = branch;
+         fLastTree = tree;
+         fLastTreeNumber = treeNumber;
+         fLastEntry = entry;
+         fSize = 0;
+         fReadStatus = TTreeReaderValueBase::kReadError;
+
+         TBuffer *b = nullptr;
+         Int_t status = branch->GetBranchCount()->GetEntryBuffer(entry, b);
+         if (status < 0) {
+            Error("TSTLMemberColumnReader::Load()", "Read error in branch %s.", branch->GetBranchCount()->GetName());
+            return kFALSE;
+         }
+         Int_t n = 0;
+         if (status > 0)
+            *b >> n;
+         if (n < 0 || n > branch->GetMaximum()) {
+            Error("TSTLMemberColumnReader::Load()", "Incorrect size %d read for the collection of %s (entry %lld).",
+                  n, branch->GetName(), entry);
+            return kFALSE;
+         }
+         if (n > 0) {
+            if (branch->GetEntryBuffer(entry, b) <= 0) {
+               Error("TSTLMemberColumnReader::Load()", "Read error in branch %s.", branch->GetName());
+               return kFALSE;
+            }
+            const size_t nwords = (n * fValueSize + sizeof(Long64_t) - 1) / sizeof(Long64_t);
+            if (fValues.size() < nwords)
+               fValues.resize(nwords);
+            void *values = fValues.data();
+            switch (fStreamerType) {
+               case TVirtualStreamerInfo::kChar:     ReadValues<Char_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kShort:    ReadValues<Short_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kInt:      ReadValues<Int_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kLong:     ReadValues<Long_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kFloat:    ReadValues<Float_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kDouble:   ReadValues<Double_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kUChar:    ReadValues<UChar_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kUShort:   ReadValues<UShort_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kUInt:     ReadValues<UInt_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kULong:    ReadValues<ULong_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kLong64:   ReadValues<Long64_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kULong64:  ReadValues<ULong64_t>(*b, values, n); break;
+               case TVirtualStreamerInfo::kBool:     ReadValues<Bool_t>(*b, values, n); break;
+               default: return kFALSE; // Excluded by CanRead().
+            }
+         }
+         fSize = n;
+         fReadStatus = TTreeReaderValueBase::kReadSuccess;
+         return kTRUE;
+      }
+
+   public:
+      TSTLMemberColumnReader(Int_t streamerType, Int_t valueSize) : fStreamerType(streamerType), fValueSize(valueSize) {}
+
+      // Whether the member held in this sub-branch of a split STL collection
+      // can be read as a column of values of the given type.
+      static bool CanRead(TBranchElement *branch, TDataType *type) {
+         TBranchElement *countBranch = branch->GetBranchCount();
+         if (!type || !countBranch || countBranch->GetType() != TBranchElement::kSTLNode)
+            return false;
+         TVirtualCollectionProxy *collProxy = countBranch->GetCollectionProxy();
+         if (!collProxy || collProxy->GetCollectionType() != ROOT::kSTLvector || collProxy->HasPointers())
+            return false;
+         // The values are read as they are on file, so the type must match
+         // exactly (no schema evolution, no Double32_t nor Float16_t packing).
+         if (branch->GetStreamerType() != type->GetType())
+            return false;
+         switch (type->GetType()) {
+            case kChar_t: case kShort_t: case kInt_t: case kLong_t: case kFloat_t: case kDouble_t:
+            case kUChar_t: case kUShort_t: case kUInt_t: case kULong_t: case kLong64_t: case kULong64_t:
+            case kBool_t:
+               return true;
+            default:
+               return false;
+         }
+      }
+
+      virtual size_t GetSize(ROOT::Detail::TBranchProxy* proxy) {
+         return Load(proxy) ? fSize : 0;
+      }
+
+      virtual void* At(ROOT::Detail::TBranchProxy* proxy, size_t idx) {
+         if (!Load(proxy))
+            return 0;
+         return (Byte_t*)fValues.data() + idx * fValueSize;
+      }
+   };
+
    class TLeafReader : public TVirtualCollectionReader {
    private:
       TTreeReaderValueBase *fValueReader;
@@ -617,7 +742,12 @@ void ROOT::Internal::TTreeReaderArrayBase::SetImpl(TBranch* branch, TLeaf* myLea
          }
          else if (element->IsA() == TStreamerBasicType::Class()){
             if (branchElement->GetType() == TBranchElement::kSTLMemberNode){
-               fImpl = std::make_unique<TBasicTypeArrayReader>();
+               TDataType *dataType = dynamic_cast<TDataType*>(fDict);
+               if (TSTLMemberColumnReader::CanRead(branchElement, dataType)) {
+                  fImpl = std::make_unique<TSTLMemberColumnReader>(dataType->GetType(), dataType->Size());
+               } else {
+                  fImpl = std::make_unique<TBasicTypeArrayReader>();
+               }
             }
             else if (branchElement->GetType() == TBranchElement::kClonesMemberNode){
                fImpl = std::make_unique<TBasicTypeClonesReader>(element->GetOffset());
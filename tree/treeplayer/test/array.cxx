@@ -1,5 +1,7 @@
 #include <ROOT/TSeq.hxx>
+#include "TChain.h"
 #include "TFile.h"
+#include "TInterpreter.h"
 #include "TTree.h"
 #include "TTreeReader.h"
 #include "TTreeReaderArray.h"
@@ -7,6 +9,8 @@
 
 #include "gtest/gtest.h"
 
+#include "data.h"
+
 #include <fstream>
 
 TEST(TTreeReaderArray, Vector)
@@ -146,3 +150,101 @@ TEST(TTreeReaderArray, BoolCollections)
 
    gSystem->Unlink(fileName);
 }
+
+// The members of the objects of a split std::vector are read as contiguous
+// arrays, directly from the sub-branches.
+TEST(TTreeReaderArray, SplitVectorMembers)
+{
+   gInterpreter->ProcessLine(".L data.h+");
+
+   auto fileName = "TTreeReaderArray_SplitVectorMembers.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      std::vector<Hit> hits;
+      t.Branch("hits", &hits, 32000, 99);
+      for (auto entry : ROOT::TSeqI(10)) {
+         hits.resize(entry % 4);
+         for (auto i : ROOT::TSeqU(hits.size())) {
+            hits[i].x = entry + 0.25f * i;
+            hits[i].e = 10. * entry + i;
+            hits[i].id = 100 * entry + i;
+            hits[i].d32 = entry - 0.5 * i;
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fileName);
+   TTreeReader r("t", &f);
+   TTreeReaderArray<float> x(r, "hits.x");
+   TTreeReaderArray<double> e(r, "hits.e");
+   TTreeReaderArray<int> id(r, "hits.id");
+   TTreeReaderArray<double> d32(r, "hits.d32"); // Double32_t, read through the objects.
+   TTreeReaderValue<std::vector<Hit>> hits(r, "hits");
+
+   Long64_t entry = 0;
+   while (r.Next()) {
+      const std::size_t n = entry % 4;
+      ASSERT_EQ(n, x.GetSize());
+      ASSERT_EQ(n, e.GetSize());
+      ASSERT_EQ(n, id.GetSize());
+      ASSERT_EQ(n, d32.GetSize());
+      ASSERT_EQ(n, hits->size());
+      for (auto i : ROOT::TSeqU(n)) {
+         EXPECT_FLOAT_EQ(entry + 0.25f * i, x[i]);
+         EXPECT_DOUBLE_EQ(10. * entry + i, e[i]);
+         EXPECT_EQ(100 * entry + i, id[i]);
+         EXPECT_DOUBLE_EQ(entry - 0.5 * i, d32[i]);
+         EXPECT_FLOAT_EQ((*hits)[i].x, x[i]);
+      }
+      if (n > 1) {
+         EXPECT_EQ(1, &x[1] - &x[0]) << "The values of hits.x are not contiguous";
+         EXPECT_EQ(1, &e[1] - &e[0]) << "The values of hits.e are not contiguous";
+      }
+      ++entry;
+   }
+   EXPECT_EQ(10, entry);
+
+   gSystem->Unlink(fileName);
+}
+
+// In a TChain, the first entry of the next file has the same local entry
+// number as the one of the previous file, and its branches may be allocated
+// where the previous ones were: the values must still be read again.
+TEST(TTreeReaderArray, SplitVectorMembersChain)
+{
+   gInterpreter->ProcessLine(".L data.h+");
+
+   const char *fileNames[] = {"TTreeReaderArray_SplitVectorMembersChain1.root",
+                              "TTreeReaderArray_SplitVectorMembersChain2.root"};
+   for (auto file : ROOT::TSeqI(2)) {
+      TFile f(fileNames[file], "RECREATE");
+      TTree t("t", "t");
+      std::vector<Hit> hits(file + 1);
+      for (auto i : ROOT::TSeqU(hits.size()))
+         hits[i].x = 10.f * file + i;
+      t.Branch("hits", &hits, 32000, 99);
+      t.Fill();
+      t.Write();
+   }
+
+   TChain c("t");
+   for (auto fileName : fileNames)
+      c.Add(fileName);
+   TTreeReader r(&c);
+   TTreeReaderArray<float> x(r, "hits.x");
+
+   Int_t file = 0;
+   while (r.Next()) {
+      ASSERT_EQ(std::size_t(file + 1), x.GetSize());
+      for (auto i : ROOT::TSeqU(x.GetSize()))
+         EXPECT_FLOAT_EQ(10.f * file + i, x[i]);
+      ++file;
+   }
+   EXPECT_EQ(2, file);
+
+   for (auto fileName : fileNames)
+      gSystem->Unlink(fileName);
+}
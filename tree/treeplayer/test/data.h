@@ -21,4 +21,11 @@ struct W {
    V v;
 };
 
+struct Hit {
+   float x = 0.f;
+   double e = 0.;
+   int id = 0;
+   Double32_t d32 = 0.;
+};
+
 #endif
@@ -0,0 +1,99 @@
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TProfile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+static const char *kFileName = "drawmt.root";
+static const Long64_t kNEntries = 20000;
+
+static void WriteFile()
+{
+   TFile f(kFileName, "recreate");
+   TTree t("t", "t");
+   double x;
+   int n;
+   float v[4];
+   t.Branch("x", &x);
+   t.Branch("n", &n);
+   t.Branch("v", v, "v[n]/F");
+   t.SetAutoFlush(1000); // many clusters
+   for (Long64_t i = 0; i < kNEntries; ++i) {
+      x = (i % 1000) * 0.01 - 3;
+      n = i % 5;
+      for (int j = 0; j < n; ++j)
+         v[j] = j + 0.5 * (i % 7);
+      t.Fill();
+   }
+   t.Write();
+}
+
+// Draw the same expression with and without implicit multithreading and
+// return both histograms.
+static std::pair<std::unique_ptr<TH1>, std::unique_ptr<TH1>>
+DrawBoth(const char *varexp, const char *selection, const char *option = "goff")
+{
+   std::unique_ptr<TH1> hists[2];
+   for (int mt = 0; mt < 2; ++mt) {
+      if (mt)
+         ROOT::EnableImplicitMT(4);
+      TFile f(kFileName);
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      t->SetEstimate(1000); // smaller than the number of entries
+      t->Draw(varexp, selection, option);
+      hists[mt].reset(static_cast<TH1 *>(t->GetHistogram()->Clone()));
+      hists[mt]->SetDirectory(nullptr);
+      if (mt)
+         ROOT::DisableImplicitMT();
+   }
+   return std::make_pair(std::move(hists[0]), std::move(hists[1]));
+}
+
+static void ExpectEqual(const TH1 &seq, const TH1 &par)
+{
+   EXPECT_EQ(seq.GetNbinsX(), par.GetNbinsX());
+   EXPECT_EQ(seq.GetNbinsY(), par.GetNbinsY());
+   EXPECT_DOUBLE_EQ(seq.GetXaxis()->GetXmin(), par.GetXaxis()->GetXmin());
+   EXPECT_DOUBLE_EQ(seq.GetXaxis()->GetXmax(), par.GetXaxis()->GetXmax());
+   EXPECT_DOUBLE_EQ(seq.GetEntries(), par.GetEntries());
+   for (int i = 0; i < seq.GetNcells(); ++i)
+      EXPECT_DOUBLE_EQ(seq.GetBinContent(i), par.GetBinContent(i)) << "bin " << i;
+}
+
+class TTreeDrawMT : public ::testing::Test {
+protected:
+   static void SetUpTestCase() { WriteFile(); }
+   static void TearDownTestCase() { gSystem->Unlink(kFileName); }
+};
+
+TEST_F(TTreeDrawMT, Fixed1D)
+{
+   auto res = DrawBoth("x>>h1(60,-3,7)", "x>0");
+   ExpectEqual(*res.first, *res.second);
+   EXPECT_DOUBLE_EQ(res.second->GetEntries(), 14000);
+}
+
+TEST_F(TTreeDrawMT, Estimated1D)
+{
+   auto res = DrawBoth("x*2", "");
+   ExpectEqual(*res.first, *res.second);
+   EXPECT_DOUBLE_EQ(res.second->GetEntries(), kNEntries);
+}
+
+TEST_F(TTreeDrawMT, Arrays2D)
+{
+   auto res = DrawBoth("v:x>>h2(20,-3,7,10,0,8)", "v>1", "goff colz");
+   ExpectEqual(*res.first, *res.second);
+}
+
+TEST_F(TTreeDrawMT, Profile)
+{
+   auto res = DrawBoth("v:x>>hp(20,-3,7)", "", "goff prof");
+   ASSERT_TRUE(res.second->InheritsFrom(TProfile::Class()));
+   ExpectEqual(*res.first, *res.second);
+}
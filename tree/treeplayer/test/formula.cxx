@@ -0,0 +1,58 @@
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+std::unique_ptr<TTree> MakeFormulaTree()
+{
+   float z = 0.;
+   int n = 0;
+   float v[10]{};
+
+   auto tree = std::make_unique<TTree>("T", "formula test tree");
+   tree->Branch("z", &z, "z/F");
+   tree->Branch("n", &n, "n/I");
+   tree->Branch("v", v, "v[n]/F");
+
+   for (int entry = 0; entry < 20; ++entry) {
+      z = entry * (1 - 2 * (entry % 2)); // +entry for even, -entry for odd
+      n = entry % 5;
+      for (int i = 0; i < n; ++i)
+         v[i] = entry + 0.5 * i;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+
+   return tree;
+}
+
+// Tree variables repeated in an expression are read once and reused; check
+// that this gives the same result on all the code paths.
+TEST(TTreeFormula, RepeatedVariables)
+{
+   auto tree = MakeFormulaTree();
+
+   TTreeFormula square("square", "z*z+z", tree.get());
+   TTreeFormula range("range", "z>-5 && z<5", tree.get());
+   TTreeFormula ternary("ternary", "z>0 ? z*2 : z*3+z", tree.get());
+   TTreeFormula skipped("skipped", "(z>0 || z*z>4) + z*z", tree.get());
+   TTreeFormula array("array", "v*v - v[0]*v[0]", tree.get());
+
+   for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+      tree->GetEntry(entry);
+      const double z = entry * (1 - 2 * (entry % 2));
+      EXPECT_DOUBLE_EQ(z * z + z, square.EvalInstance());
+      EXPECT_DOUBLE_EQ(z > -5 && z < 5, range.EvalInstance());
+      EXPECT_DOUBLE_EQ(z > 0 ? z * 2 : z * 3 + z, ternary.EvalInstance());
+      EXPECT_DOUBLE_EQ((z > 0 || z * z > 4) + z * z, skipped.EvalInstance());
+
+      const int n = entry % 5;
+      ASSERT_EQ(n, array.GetNdata());
+      for (int i = 0; i < n; ++i) {
+         const double vi = entry + 0.5 * i;
+         EXPECT_DOUBLE_EQ(vi * vi - entry * entry, array.EvalInstance(i));
+      }
+   }
+}